@@ -32,12 +32,18 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 
 #include "Adafruit_GFX.h"
+#include "Adafruit_GFXShapes.h"
 #include "glcdfont.c"
 #ifdef __AVR__
 #include <avr/pgmspace.h>
 #elif defined(ESP8266) || defined(ESP32)
 #include <pgmspace.h>
 #endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 // Many (but maybe not all) non-AVR board installs define macros
 // for compatibility with existing PROGMEM-reading AVR code.
@@ -62,7 +68,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #define pgm_read_pointer(addr) ((void *)pgm_read_word(addr))
 #endif
 
-inline GFXglyph *pgm_read_glyph_ptr(const GFXfont *gfxFont, uint8_t c) {
+inline GFXglyph *pgm_read_glyph_ptr(const GFXfont *gfxFont, uint16_t c) {
 #ifdef __AVR__
   return &(((GFXglyph *)pgm_read_pointer(&gfxFont->glyph))[c]);
 #else
@@ -86,9 +92,20 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
 #endif //__AVR__
 }
 
+inline GFXrange *pgm_read_range_ptr(const GFXfontSparse *font) {
+#ifdef __AVR__
+  return (GFXrange *)pgm_read_pointer(&font->range);
+#else
+  return font->range;
+#endif //__AVR__
+}
+
 #ifndef min
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
 
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
@@ -99,6 +116,174 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
   }
 #endif
 
+// fillPolygon() keeps up to this many edges on the stack, and only
+// allocates for polygons with more vertices than that.
+#if !defined(GFX_POLYGON_EDGES)
+#if defined(__AVR__)
+#define GFX_POLYGON_EDGES 8
+#else
+#define GFX_POLYGON_EDGES 16
+#endif
+#endif
+
+// One polygon edge in fillPolygon()'s active edge table
+typedef struct {
+  int32_t x;     // Crossing at the current scanline's center, 16.16 fixed
+  int32_t slope; // Change in x per scanline, 16.16 fixed
+  int16_t xtop;  // Top vertex x
+  int16_t ytop;  // Top vertex y (first scanline covered)
+  int16_t ybot;  // Bottom vertex y (scanline after the last one covered)
+  int32_t dx;    // xbottom - xtop, which may not fit in 16 bits
+  int8_t dir;    // +1 if edge runs downward in vertex order, else -1
+} GFXpolyEdge;
+
+// Append a span to a batch being built on the stack by a filled primitive,
+// handing the batch to writeSpans() whenever it fills up.
+static inline void addSpan(Adafruit_GFX *gfx, GFXspan *spans, uint16_t &n,
+                           int16_t x, int16_t y, int16_t w, uint16_t color) {
+  spans[n].x = x;
+  spans[n].y = y;
+  spans[n].w = w;
+  if (++n == GFX_SPAN_BATCH) {
+    gfx->writeSpans(spans, n, color);
+    n = 0;
+  }
+}
+
+// Sink for the rasterizers in Adafruit_GFXShapes.h that draws through the
+// virtual write*() functions, so subclass overrides still apply. With wrap
+// set, startWrite() is only called ahead of the first pixel (a shape that
+// turns out to be clipped away never starts a transaction) and end() must
+// be called once the shape is done.
+class GFXwriteSink {
+public:
+  GFXwriteSink(Adafruit_GFX *gfx, uint16_t color, bool wrap = true)
+      : gfx(gfx), color(color), wrap(wrap), started(!wrap) {
+    int16_t w, h;
+    gfx->getClipRect(&cx0, &cy0, &w, &h);
+    cx1 = cx0 + w;
+    cy1 = cy0 + h;
+  }
+  bool isClipped(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const {
+    return (x1 < cx0) || (y1 < cy0) || (x0 >= cx1) || (y0 >= cy1);
+  }
+  int16_t clipY0(void) const { return cy0; }
+  int16_t clipY1(void) const { return cy1; }
+  void pixel(int16_t x, int16_t y) {
+    begin();
+    gfx->writePixel(x, y, color);
+  }
+  void hline(int16_t x, int16_t y, int16_t w) {
+    begin();
+    gfx->writeFastHLine(x, y, w, color);
+  }
+  void vline(int16_t x, int16_t y, int16_t h) {
+    begin();
+    gfx->writeFastVLine(x, y, h, color);
+  }
+  void rect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    begin();
+    gfx->writeFillRect(x, y, w, h, color);
+  }
+  void span(int16_t x, int16_t y, int16_t w) { hline(x, y, w); }
+  void end(void) {
+    if (wrap && started)
+      gfx->endWrite();
+  }
+
+protected:
+  void begin(void) {
+    if (!started) {
+      gfx->startWrite();
+      started = true;
+    }
+  }
+  Adafruit_GFX *gfx;
+  uint16_t color;
+
+private:
+  bool wrap, started;
+  int16_t cx0, cy0, cx1, cy1;
+};
+
+// As GFXwriteSink, but filled-shape rows are batched for writeSpans()
+class GFXspanSink : public GFXwriteSink {
+public:
+  GFXspanSink(Adafruit_GFX *gfx, uint16_t color, bool wrap = true)
+      : GFXwriteSink(gfx, color, wrap), n(0) {}
+  void span(int16_t x, int16_t y, int16_t w) {
+    begin();
+    uint16_t i = n; // Local copy: the span stores below may alias n
+    spans[i].x = x;
+    spans[i].y = y;
+    spans[i].w = w;
+    if (++i == GFX_SPAN_BATCH) {
+      gfx->writeSpans(spans, i, color);
+      i = 0;
+    }
+    n = i;
+  }
+  void end(void) {
+    if (n)
+      gfx->writeSpans(spans, n, color);
+    GFXwriteSink::end();
+  }
+
+private:
+  GFXspan spans[GFX_SPAN_BATCH];
+  uint16_t n;
+};
+
+// Number of leading zero bits in a byte (b != 0)
+static inline uint8_t clz8(uint8_t b) {
+#if defined(__GNUC__)
+  return __builtin_clz((unsigned int)b) - (sizeof(unsigned int) * 8 - 8);
+#else
+  uint8_t n = 0;
+  while (!(b & 0x80)) {
+    b <<= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+// Copy w bits of a glyph bitmap, starting at bit 'bit', into row[] MSB
+// first from bit 0, zeroing the unused bits of the last byte. Only the
+// bytes holding those bits are read.
+static void glyphRow(const uint8_t *bitmap, uint32_t bit, uint8_t w,
+                     uint8_t *row) {
+  const uint8_t *p = &bitmap[bit >> 3];
+  uint8_t s = bit & 7, n = (w + 7) / 8, b = pgm_read_byte(p++);
+  for (uint8_t k = 0; k < n; k++) {
+    uint8_t v = b << s;
+    if (8 * k + 8 - s < w) { // Row continues into the next byte
+      b = pgm_read_byte(p++);
+      v |= b >> (8 - s);
+    }
+    row[k] = v;
+  }
+  if (w & 7)
+    row[n - 1] &= 0xFF << (8 - (w & 7));
+}
+
+// First bit at or after i in a row of w bits that is set (or clear, if
+// set is false), w if there is none. Whole bytes are skipped at a time.
+static uint8_t glyphRowFind(const uint8_t *row, uint8_t i, uint8_t w,
+                            bool set) {
+  if (i >= w)
+    return w;
+  uint8_t k = i >> 3, n = (w + 7) / 8, flip = set ? 0 : 0xFF;
+  uint8_t b = (row[k] ^ flip) & (0xFF >> (i & 7));
+  while (!b) {
+    if (++k >= n)
+      return w;
+    b = row[k] ^ flip;
+  }
+  i = k * 8 + clz8(b);
+  return (i < w) ? i : w;
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX context for graphics! Can only be done by a
@@ -116,12 +301,20 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   textcolor = textbgcolor = 0xFFFF;
   wrap = true;
   _cp437 = false;
+  _utf8 = false;
+  utf8Left = 0;
+  utf8Code = 0;
   gfxFont = NULL;
+  fontChain = NULL;
+  fontChainLength = 0;
+  clipDepth = 0;
 }
 
 /**************************************************************************/
 /*!
-   @brief    Write a line.  Bresenham's algorithm - thx wikpedia
+   @brief    Write a line.  Bresenham's algorithm - thx wikpedia. Pixels
+   are collected into horizontal (or, for steep lines, vertical) runs and
+   each run is written with one writeFastHLine()/writeFastVLine() call.
     @param    x0  Start point x coordinate
     @param    y0  Start point y coordinate
     @param    x1  End point x coordinate
@@ -131,45 +324,8 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
 /**************************************************************************/
 void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                              uint16_t color) {
-#if defined(ESP8266)
-  yield();
-#endif
-  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
-  if (steep) {
-    _swap_int16_t(x0, y0);
-    _swap_int16_t(x1, y1);
-  }
-
-  if (x0 > x1) {
-    _swap_int16_t(x0, x1);
-    _swap_int16_t(y0, y1);
-  }
-
-  int16_t dx, dy;
-  dx = x1 - x0;
-  dy = abs(y1 - y0);
-
-  int16_t err = dx / 2;
-  int16_t ystep;
-
-  if (y0 < y1) {
-    ystep = 1;
-  } else {
-    ystep = -1;
-  }
-
-  for (; x0 <= x1; x0++) {
-    if (steep) {
-      writePixel(y0, x0, color);
-    } else {
-      writePixel(x0, y0, color);
-    }
-    err -= dy;
-    if (err < 0) {
-      y0 += ystep;
-      err += dx;
-    }
-  }
+  GFXwriteSink s(this, color, false);
+  gfxLine(s, x0, y0, x1, y1);
 }
 
 /**************************************************************************/
@@ -188,7 +344,8 @@ void Adafruit_GFX::startWrite() {}
 */
 /**************************************************************************/
 void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color) {
-  drawPixel(x, y, color);
+  if (!isClipped(x, y))
+    drawPixel(x, y, color);
 }
 
 /**************************************************************************/
@@ -206,7 +363,15 @@ void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h,
   // Overwrite in subclasses if startWrite is defined!
   // Can be just writeLine(x, y, x, y+h-1, color);
   // or writeFillRect(x, y, 1, h, color);
-  drawFastVLine(x, y, h, color);
+  // Trimmed to the clip rect first, so subclasses that only provide
+  // drawFastVLine() still honor it.
+  int16_t i0, j0, i1, j1;
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (clipImage(x, y, 1, h, &i0, &j0, &i1, &j1))
+    drawFastVLine(x, y + j0, j1 - j0, color);
 }
 
 /**************************************************************************/
@@ -224,7 +389,14 @@ void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w,
   // Overwrite in subclasses if startWrite is defined!
   // Example: writeLine(x, y, x+w-1, y, color);
   // or writeFillRect(x, y, w, 1, color);
-  drawFastHLine(x, y, w, color);
+  // Trimmed to the clip rect first, see writeFastVLine().
+  int16_t i0, j0, i1, j1;
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (clipImage(x, y, w, 1, &i0, &j0, &i1, &j1))
+    drawFastHLine(x + i0, y, i1 - i0, color);
 }
 
 /**************************************************************************/
@@ -241,7 +413,38 @@ void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w,
 void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  uint16_t color) {
   // Overwrite in subclasses if desired!
-  fillRect(x, y, w, h, color);
+  // Trimmed to the clip rect first, see writeFastVLine().
+  int16_t i0, j0, i1, j1;
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    fillRect(x + i0, y + j0, i1 - i0, j1 - j0, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Write a batch of horizontal spans in one color. Filled shapes
+   (circles, round-rects, triangles) are handed over a batch at a time, so
+   subclasses can override this to merge spans or skip per-span overhead.
+   The generic version just draws each span with writeFastHLine().
+    @param    spans  Array of spans, each with a positive width
+    @param    count  Number of spans in the array
+   @param    color 16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Adafruit_GFX::writeSpans(const GFXspan *spans, uint16_t count,
+                              uint16_t color) {
+  // Overwrite in subclasses if desired!
+  while (count--) {
+    writeFastHLine(spans->x, spans->y, spans->w, color);
+    spans++;
+  }
 }
 
 /**************************************************************************/
@@ -264,8 +467,14 @@ void Adafruit_GFX::endWrite() {}
 /**************************************************************************/
 void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                  uint16_t color) {
+  // Pixel by pixel rather than via writeLine(), which itself hands runs
+  // to writeFastVLine() and would otherwise end up back here.
+  int16_t y1 = y + h - 1;
+  if (y1 < y)
+    _swap_int16_t(y, y1);
   startWrite();
-  writeLine(x, y, x, y + h - 1, color);
+  for (; y <= y1; y++)
+    writePixel(x, y, color);
   endWrite();
 }
 
@@ -281,8 +490,13 @@ void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                  uint16_t color) {
+  // Pixel by pixel, see drawFastVLine()
+  int16_t x1 = x + w - 1;
+  if (x1 < x)
+    _swap_int16_t(x, x1);
   startWrite();
-  writeLine(x, y, x + w - 1, y, color);
+  for (; x <= x1; x++)
+    writePixel(x, y, color);
   endWrite();
 }
 
@@ -299,8 +513,14 @@ void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  // Only columns inside the clip rect; writeFastVLine() trims the rows
+  int32_t x1 = (int32_t)x + w;
+  if (x < clipX0())
+    x = clipX0();
+  if (x1 > clipX1())
+    x1 = clipX1();
   startWrite();
-  for (int16_t i = x; i < x + w; i++) {
+  for (int16_t i = x; i < x1; i++) {
     writeFastVLine(i, y, h, color);
   }
   endWrite();
@@ -356,41 +576,9 @@ void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 /**************************************************************************/
 void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
                               uint16_t color) {
-#if defined(ESP8266)
-  yield();
-#endif
-  int16_t f = 1 - r;
-  int16_t ddF_x = 1;
-  int16_t ddF_y = -2 * r;
-  int16_t x = 0;
-  int16_t y = r;
-
-  startWrite();
-  writePixel(x0, y0 + r, color);
-  writePixel(x0, y0 - r, color);
-  writePixel(x0 + r, y0, color);
-  writePixel(x0 - r, y0, color);
-
-  while (x < y) {
-    if (f >= 0) {
-      y--;
-      ddF_y += 2;
-      f += ddF_y;
-    }
-    x++;
-    ddF_x += 2;
-    f += ddF_x;
-
-    writePixel(x0 + x, y0 + y, color);
-    writePixel(x0 - x, y0 + y, color);
-    writePixel(x0 + x, y0 - y, color);
-    writePixel(x0 - x, y0 - y, color);
-    writePixel(x0 + y, y0 + x, color);
-    writePixel(x0 - y, y0 + x, color);
-    writePixel(x0 + y, y0 - x, color);
-    writePixel(x0 - y, y0 - x, color);
-  }
-  endWrite();
+  GFXwriteSink s(this, color);
+  gfxCircle(s, x0, y0, r);
+  s.end();
 }
 
 /**************************************************************************/
@@ -406,38 +594,8 @@ void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
                                     uint8_t cornername, uint16_t color) {
-  int16_t f = 1 - r;
-  int16_t ddF_x = 1;
-  int16_t ddF_y = -2 * r;
-  int16_t x = 0;
-  int16_t y = r;
-
-  while (x < y) {
-    if (f >= 0) {
-      y--;
-      ddF_y += 2;
-      f += ddF_y;
-    }
-    x++;
-    ddF_x += 2;
-    f += ddF_x;
-    if (cornername & 0x4) {
-      writePixel(x0 + x, y0 + y, color);
-      writePixel(x0 + y, y0 + x, color);
-    }
-    if (cornername & 0x2) {
-      writePixel(x0 + x, y0 - y, color);
-      writePixel(x0 + y, y0 - x, color);
-    }
-    if (cornername & 0x8) {
-      writePixel(x0 - y, y0 + x, color);
-      writePixel(x0 - x, y0 + y, color);
-    }
-    if (cornername & 0x1) {
-      writePixel(x0 - y, y0 - x, color);
-      writePixel(x0 - x, y0 - y, color);
-    }
-  }
+  GFXwriteSink s(this, color, false);
+  gfxCircleQuarters(s, x0, y0, r, cornername);
 }
 
 /**************************************************************************/
@@ -451,10 +609,9 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r,
                               uint16_t color) {
-  startWrite();
-  writeFastVLine(x0, y0 - r, 2 * r + 1, color);
-  fillCircleHelper(x0, y0, r, 3, 0, color);
-  endWrite();
+  GFXspanSink s(this, color);
+  gfxFillCircle(s, x0, y0, r);
+  s.end();
 }
 
 /**************************************************************************/
@@ -471,43 +628,9 @@ void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r,
 void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
                                     uint8_t corners, int16_t delta,
                                     uint16_t color) {
-
-  int16_t f = 1 - r;
-  int16_t ddF_x = 1;
-  int16_t ddF_y = -2 * r;
-  int16_t x = 0;
-  int16_t y = r;
-  int16_t px = x;
-  int16_t py = y;
-
-  delta++; // Avoid some +1's in the loop
-
-  while (x < y) {
-    if (f >= 0) {
-      y--;
-      ddF_y += 2;
-      f += ddF_y;
-    }
-    x++;
-    ddF_x += 2;
-    f += ddF_x;
-    // These checks avoid double-drawing certain lines, important
-    // for the SSD1306 library which has an INVERT drawing mode.
-    if (x < (y + 1)) {
-      if (corners & 1)
-        writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
-      if (corners & 2)
-        writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
-    }
-    if (y != py) {
-      if (corners & 1)
-        writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
-      if (corners & 2)
-        writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
-      py = y;
-    }
-    px = x;
-  }
+  GFXspanSink s(this, color, false);
+  gfxFillCircleQuarters(s, x0, y0, r, corners, delta);
+  s.end();
 }
 
 /**************************************************************************/
@@ -530,6 +653,157 @@ void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
   endWrite();
 }
 
+/**************************************************************************/
+/*!
+   @brief   Draw the outline of a closed polygon
+    @param    xy  Array of n vertices as x,y pairs: {x0, y0, x1, y1, ...}
+    @param    n   Number of vertices (the last one joins back to the first)
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawPolygon(const int16_t *xy, uint16_t n, uint16_t color) {
+  if (n == 0)
+    return;
+  startWrite();
+  for (uint16_t i = 0; i < n; i++) {
+    const int16_t *b = &xy[((i + 1 < n) ? i + 1 : 0) * 2];
+    writeLine(xy[i * 2], xy[i * 2 + 1], b[0], b[1], color);
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief   Fill a closed polygon, which may be concave or self-intersecting.
+   Vertices are taken to lie on pixel corners and a pixel is filled if its
+   center is inside, so polygons sharing an edge neither overlap nor leave
+   a gap. A square from (0,0) to (10,10) fills the same pixels as
+   fillRect(0, 0, 10, 10). Scanlines are filled with an active edge table
+   stepped in 16.16 fixed point, so there is no division per scanline.
+    @param    xy    Array of n vertices as x,y pairs: {x0, y0, x1, y1, ...}
+    @param    n     Number of vertices (the last one joins back to the first)
+    @param    color 16-bit 5-6-5 Color to fill with
+    @param    rule  GFX_FILL_EVEN_ODD (default) or GFX_FILL_NONZERO, decides
+                    whether self-overlapping areas are filled
+*/
+/**************************************************************************/
+void Adafruit_GFX::fillPolygon(const int16_t *xy, uint16_t n, uint16_t color,
+                               uint8_t rule) {
+  if (n < 3)
+    return;
+
+  GFXpolyEdge stackEdges[GFX_POLYGON_EDGES], *edges = stackEdges;
+  if (n > GFX_POLYGON_EDGES) {
+    edges = (GFXpolyEdge *)malloc(n * sizeof(GFXpolyEdge));
+    if (!edges)
+      return;
+  }
+
+  // Build the edge table, leaving out horizontal edges, sorted by top y
+  uint16_t ne = 0;
+  int16_t ymin = 0x7FFF, ymax = -0x7FFF - 1;
+  for (uint16_t i = 0; i < n; i++) {
+    const int16_t *a = &xy[i * 2], *b = &xy[((i + 1 < n) ? i + 1 : 0) * 2];
+    if (a[1] == b[1])
+      continue;
+    GFXpolyEdge e;
+    e.dir = 1;
+    if (a[1] > b[1]) {
+      const int16_t *t = a;
+      a = b;
+      b = t;
+      e.dir = -1;
+    }
+    e.xtop = a[0];
+    e.ytop = a[1];
+    e.ybot = b[1];
+    e.dx = b[0] - a[0];
+    if (e.ytop < ymin)
+      ymin = e.ytop;
+    if (e.ybot > ymax)
+      ymax = e.ybot;
+    uint16_t j = ne++;
+    for (; (j > 0) && (edges[j - 1].ytop > e.ytop); j--)
+      edges[j] = edges[j - 1];
+    edges[j] = e;
+  }
+
+  if (ymin < clipY0())
+    ymin = clipY0();
+  if (ymax > clipY1())
+    ymax = clipY1();
+
+  GFXspan spans[GFX_SPAN_BATCH];
+  uint16_t nspans = 0;
+  uint16_t active = 0; // edges[0..active) are the active edges...
+  uint16_t next = 0;   // ...and edges[next..ne) are yet to start
+
+  startWrite();
+  for (int16_t y = ymin; y < ymax; y++) {
+    uint16_t i, j;
+    // Drop edges that ended above this scanline and step the rest down
+    // to it. An edge that has ended is not stepped: past its end x could
+    // overflow.
+    for (i = j = 0; i < active; i++) {
+      if (edges[i].ybot > y) {
+        edges[i].x += edges[i].slope;
+        edges[j++] = edges[i];
+      }
+    }
+    active = j;
+    // Pick up edges that start here (or above, on the first scanline).
+    // The only divisions happen here, once per edge.
+    for (; (next < ne) && (edges[next].ytop <= y); next++) {
+      GFXpolyEdge e = edges[next];
+      if (e.ybot <= y)
+        continue;
+      int32_t dy = e.ybot - e.ytop;
+      // 16.16 fixed point; multiplied, as dx and xtop may be negative.
+      // Only edges with dy > 1 are ever stepped, and their slope fits in
+      // 32 bits. x does, being on the edge, but not always its two terms.
+      e.slope = (int32_t)((int64_t)e.dx * 65536 / dy);
+      e.x = (int32_t)((int64_t)e.xtop * 65536 +
+                      (int64_t)(2 * (y - e.ytop) + 1) * e.dx * 65536 /
+                          (2 * dy));
+      edges[active++] = e;
+    }
+    // Keep the active edges sorted by x. They are nearly in order from
+    // the previous scanline, so insertion sort is cheap here.
+    for (i = 1; i < active; i++) {
+      GFXpolyEdge e = edges[i];
+      for (j = i; (j > 0) && (edges[j - 1].x > e.x); j--)
+        edges[j] = edges[j - 1];
+      edges[j] = e;
+    }
+    // Fill between crossings. Pixel x is covered if its center x+0.5 is
+    // at or right of the left crossing and left of the right one.
+    int16_t wind = 0;
+    int32_t xl = 0;
+    for (i = 0; i < active; i++) {
+      int16_t was = wind;
+      wind = (rule == GFX_FILL_NONZERO) ? (wind + edges[i].dir) : !wind;
+      if (!was) {
+        xl = edges[i].x;
+      } else if (!wind) {
+        int32_t x0 = (xl + 0x7FFF) >> 16;
+        int32_t x1 = ((edges[i].x + 0x7FFF) >> 16) - 1;
+        if (x0 < clipX0())
+          x0 = clipX0();
+        if (x1 >= clipX1())
+          x1 = clipX1() - 1;
+        if (x1 >= x0)
+          addSpan(this, spans, nspans, x0, y, x1 - x0 + 1, color);
+      }
+    }
+  }
+  if (nspans)
+    writeSpans(spans, nspans, color);
+  endWrite();
+
+  if (edges != stackEdges)
+    free(edges);
+}
+
 /**************************************************************************/
 /*!
    @brief   Draw a rounded rectangle with no fill color
@@ -543,21 +817,9 @@ void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  int16_t r, uint16_t color) {
-  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
-  if (r > max_radius)
-    r = max_radius;
-  // smarter version
-  startWrite();
-  writeFastHLine(x + r, y, w - 2 * r, color);         // Top
-  writeFastHLine(x + r, y + h - 1, w - 2 * r, color); // Bottom
-  writeFastVLine(x, y + r, h - 2 * r, color);         // Left
-  writeFastVLine(x + w - 1, y + r, h - 2 * r, color); // Right
-  // draw four corners
-  drawCircleHelper(x + r, y + r, r, 1, color);
-  drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
-  drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
-  drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
-  endWrite();
+  GFXwriteSink s(this, color);
+  gfxRoundRect(s, x, y, w, h, r);
+  s.end();
 }
 
 /**************************************************************************/
@@ -573,16 +835,9 @@ void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                  int16_t r, uint16_t color) {
-  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
-  if (r > max_radius)
-    r = max_radius;
-  // smarter version
-  startWrite();
-  writeFillRect(x + r, y, w - 2 * r, h, color);
-  // draw four corners
-  fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
-  fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
-  endWrite();
+  GFXspanSink s(this, color);
+  gfxFillRoundRect(s, x, y, w, h, r);
+  s.end();
 }
 
 /**************************************************************************/
@@ -618,90 +873,47 @@ void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 /**************************************************************************/
 void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                                 int16_t x2, int16_t y2, uint16_t color) {
-
-  int16_t a, b, y, last;
-
-  // Sort coordinates by Y order (y2 >= y1 >= y0)
-  if (y0 > y1) {
-    _swap_int16_t(y0, y1);
-    _swap_int16_t(x0, x1);
-  }
-  if (y1 > y2) {
-    _swap_int16_t(y2, y1);
-    _swap_int16_t(x2, x1);
-  }
-  if (y0 > y1) {
-    _swap_int16_t(y0, y1);
-    _swap_int16_t(x0, x1);
-  }
-
-  startWrite();
-  if (y0 == y2) { // Handle awkward all-on-same-line case as its own thing
-    a = b = x0;
-    if (x1 < a)
-      a = x1;
-    else if (x1 > b)
-      b = x1;
-    if (x2 < a)
-      a = x2;
-    else if (x2 > b)
-      b = x2;
-    writeFastHLine(a, y0, b - a + 1, color);
-    endWrite();
-    return;
-  }
-
-  int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
-          dx12 = x2 - x1, dy12 = y2 - y1;
-  int32_t sa = 0, sb = 0;
-
-  // For upper part of triangle, find scanline crossings for segments
-  // 0-1 and 0-2.  If y1=y2 (flat-bottomed triangle), the scanline y1
-  // is included here (and second loop will be skipped, avoiding a /0
-  // error there), otherwise scanline y1 is skipped here and handled
-  // in the second loop...which also avoids a /0 error here if y0=y1
-  // (flat-topped triangle).
-  if (y1 == y2)
-    last = y1; // Include y1 scanline
-  else
-    last = y1 - 1; // Skip it
-
-  for (y = y0; y <= last; y++) {
-    a = x0 + sa / dy01;
-    b = x0 + sb / dy02;
-    sa += dx01;
-    sb += dx02;
-    /* longhand:
-    a = x0 + (x1 - x0) * (y - y0) / (y1 - y0);
-    b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
-    */
-    if (a > b)
-      _swap_int16_t(a, b);
-    writeFastHLine(a, y, b - a + 1, color);
-  }
-
-  // For lower part of triangle, find scanline crossings for segments
-  // 0-2 and 1-2.  This loop is skipped if y1=y2.
-  sa = (int32_t)dx12 * (y - y1);
-  sb = (int32_t)dx02 * (y - y0);
-  for (; y <= y2; y++) {
-    a = x1 + sa / dy12;
-    b = x0 + sb / dy02;
-    sa += dx12;
-    sb += dx02;
-    /* longhand:
-    a = x1 + (x2 - x1) * (y - y1) / (y2 - y1);
-    b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
-    */
-    if (a > b)
-      _swap_int16_t(a, b);
-    writeFastHLine(a, y, b - a + 1, color);
-  }
-  endWrite();
+  GFXspanSink s(this, color);
+  gfxFillTriangle(s, x0, y0, x1, y1, x2, y2);
+  s.end();
 }
 
 // BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
 
+/**************************************************************************/
+/*!
+   @brief   Hook for a subclass to draw a whole image faster than pixel by
+            pixel. The bitmap functions call it first, unclipped, and fall
+            back to writePixel() if it returns false, so an override is
+            used however the call is made, even through an Adafruit_GFX
+            reference. This version handles nothing.
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    bitmap  Image data, laid out as for the calling function
+    @param    pgm     True if bitmap is PROGMEM-resident
+    @param    format  GFX_IMAGE_1BIT etc.
+    @param    w       Width of bitmap in pixels
+    @param    h       Height of bitmap in pixels
+    @param    color   Color for set bits (1-bit formats)
+    @param    bg      Color for unset bits (GFX_IMAGE_1BIT_BG)
+    @returns  True if the image was drawn, false to draw it pixel by pixel
+*/
+/**************************************************************************/
+bool Adafruit_GFX::drawImageFast(int16_t x, int16_t y, const void *bitmap,
+                                 bool pgm, uint8_t format, int16_t w, int16_t h,
+                                 uint16_t color, uint16_t bg) {
+  (void)x;
+  (void)y;
+  (void)bitmap;
+  (void)pgm;
+  (void)format;
+  (void)w;
+  (void)h;
+  (void)color;
+  (void)bg;
+  return false;
+}
+
 /**************************************************************************/
 /*!
    @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
@@ -716,21 +928,17 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                               int16_t w, int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, true, GFX_IMAGE_1BIT, w, h, color, 0) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
 
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      if (byte & 0x80)
-        writePixel(x + i, y, color);
-    }
-  }
+  gfxBits<true, false>(bitmap, w, i0, j0, i1, j1,
+                       [&](int16_t i, int16_t j, bool set) {
+                         if (set)
+                           writePixel(x + i, y + j, color);
+                       });
   endWrite();
 }
 
@@ -751,20 +959,17 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                               int16_t w, int16_t h, uint16_t color,
                               uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, true, GFX_IMAGE_1BIT_BG, w, h, color,
+                    bg) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
 
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
-    }
-  }
+  gfxBits<true, false>(bitmap, w, i0, j0, i1, j1,
+                       [&](int16_t i, int16_t j, bool set) {
+                         writePixel(x + i, y + j, set ? color : bg);
+                       });
   endWrite();
 }
 
@@ -782,21 +987,17 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
                               int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, false, GFX_IMAGE_1BIT, w, h, color, 0) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
 
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = bitmap[j * byteWidth + i / 8];
-      if (byte & 0x80)
-        writePixel(x + i, y, color);
-    }
-  }
+  gfxBits<false, false>(bitmap, w, i0, j0, i1, j1,
+                        [&](int16_t i, int16_t j, bool set) {
+                          if (set)
+                            writePixel(x + i, y + j, color);
+                        });
   endWrite();
 }
 
@@ -816,20 +1017,17 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
                               int16_t h, uint16_t color, uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, false, GFX_IMAGE_1BIT_BG, w, h, color,
+                    bg) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
 
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = bitmap[j * byteWidth + i / 8];
-      writePixel(x + i, y, (byte & 0x80) ? color : bg);
-    }
-  }
+  gfxBits<false, false>(bitmap, w, i0, j0, i1, j1,
+                        [&](int16_t i, int16_t j, bool set) {
+                          writePixel(x + i, y + j, set ? color : bg);
+                        });
   endWrite();
 }
 
@@ -850,23 +1048,18 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                                int16_t w, int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
 
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte >>= 1;
-      else
-        byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      // Nearly identical to drawBitmap(), only the bit order
-      // is reversed here (left-to-right = LSB to MSB):
-      if (byte & 0x01)
-        writePixel(x + i, y, color);
-    }
-  }
+  // Nearly identical to drawBitmap(), only the bit order
+  // is reversed here (left-to-right = LSB to MSB):
+  gfxBits<true, true>(bitmap, w, i0, j0, i1, j1,
+                      [&](int16_t i, int16_t j, bool set) {
+                        if (set)
+                          writePixel(x + i, y + j, color);
+                      });
   endWrite();
 }
 
@@ -885,10 +1078,15 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        const uint8_t bitmap[], int16_t w,
                                        int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, true, GFX_IMAGE_GRAY8, w, h, 0, 0) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      writePixel(x + i, y + j, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
     }
   }
   endWrite();
@@ -908,10 +1106,15 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
 /**************************************************************************/
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        int16_t w, int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, false, GFX_IMAGE_GRAY8, w, h, 0, 0) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      writePixel(x + i, y + j, bitmap[j * w + i]);
     }
   }
   endWrite();
@@ -936,20 +1139,18 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        const uint8_t bitmap[],
                                        const uint8_t mask[], int16_t w,
                                        int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&mask[j * bw + i / 8]);
-      if (byte & 0x80) {
-        writePixel(x + i, y, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
-      }
-    }
-  }
+  gfxBits<true, false>(mask, w, i0, j0, i1, j1,
+                       [&](int16_t i, int16_t j, bool set) {
+                         if (set)
+                           writePixel(
+                               x + i, y + j,
+                               (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+                       });
   endWrite();
 }
 
@@ -970,20 +1171,16 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
 /**************************************************************************/
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        uint8_t *mask, int16_t w, int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = mask[j * bw + i / 8];
-      if (byte & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
-      }
-    }
-  }
+  gfxBits<false, false>(mask, w, i0, j0, i1, j1,
+                        [&](int16_t i, int16_t j, bool set) {
+                          if (set)
+                            writePixel(x + i, y + j, bitmap[j * w + i]);
+                        });
   endWrite();
 }
 
@@ -1000,10 +1197,15 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  int16_t w, int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, true, GFX_IMAGE_RGB565, w, h, 0, 0) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      writePixel(x + i, y + j, pgm_read_word(&bitmap[j * w + i]));
     }
   }
   endWrite();
@@ -1022,10 +1224,15 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  int16_t w, int16_t h) {
+  int16_t i0, j0, i1, j1;
+  if (drawImageFast(x, y, bitmap, false, GFX_IMAGE_RGB565, w, h, 0, 0) ||
+      !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      writePixel(x + i, y, bitmap[j * w + i]);
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      writePixel(x + i, y + j, bitmap[j * w + i]);
     }
   }
   endWrite();
@@ -1047,20 +1254,17 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  const uint8_t mask[], int16_t w, int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = pgm_read_byte(&mask[j * bw + i / 8]);
-      if (byte & 0x80) {
-        writePixel(x + i, y, pgm_read_word(&bitmap[j * w + i]));
-      }
-    }
-  }
+  gfxBits<true, false>(mask, w, i0, j0, i1, j1,
+                       [&](int16_t i, int16_t j, bool set) {
+                         if (set)
+                           writePixel(x + i, y + j,
+                                      pgm_read_word(&bitmap[j * w + i]));
+                       });
   endWrite();
 }
 
@@ -1080,20 +1284,16 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  uint8_t *mask, int16_t w, int16_t h) {
-  int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
-  uint8_t byte = 0;
+  int16_t i0, j0, i1, j1;
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        byte <<= 1;
-      else
-        byte = mask[j * bw + i / 8];
-      if (byte & 0x80) {
-        writePixel(x + i, y, bitmap[j * w + i]);
-      }
-    }
-  }
+  gfxBits<false, false>(mask, w, i0, j0, i1, j1,
+                        [&](int16_t i, int16_t j, bool set) {
+                          if (set)
+                            writePixel(x + i, y + j, bitmap[j * w + i]);
+                        });
   endWrite();
 }
 
@@ -1134,15 +1334,37 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
                             uint16_t color, uint16_t bg, uint8_t size_x,
                             uint8_t size_y) {
+  drawCodepoint(x, y, c, color, bg, size_x, size_y);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a single character by its Unicode codepoint, looking its
+            glyph up in the current font. Codepoints the font has no glyph
+            for draw nothing; the classic font only has 0 to 0xFF, indexed
+            as drawChar() does.
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    code  The codepoint
+    @param    color 16-bit 5-6-5 Color to draw chraracter with
+    @param    bg 16-bit 5-6-5 Color to fill background with (if same as color,
+   no background)
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawCodepoint(int16_t x, int16_t y, uint32_t code,
+                                 uint16_t color, uint16_t bg, uint8_t size_x,
+                                 uint8_t size_y) {
 
   if (!gfxFont) { // 'Classic' built-in font
 
-    if ((x >= _width) ||              // Clip right
-        (y >= _height) ||             // Clip bottom
-        ((x + 6 * size_x - 1) < 0) || // Clip left
-        ((y + 8 * size_y - 1) < 0))   // Clip top
+    if ((code > 0xFF) ||
+        isClipped(x, y, x + 6 * size_x - 1, y + 8 * size_y - 1))
       return;
 
+    unsigned char c = code;
+
     if (!_cp437 && (c >= 176))
       c++; // Handle 'classic' charset behavior
 
@@ -1174,97 +1396,150 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 
   } else { // Custom font
 
-    // Character is assumed previously filtered by write() to eliminate
-    // newlines, returns, non-printable characters, etc.  Calling
-    // drawChar() directly with 'bad' characters of font may cause mayhem!
+    const GFXfont *f = gfxFont;
+    GFXglyph *glyph = findGlyph(code, &f);
+    if (glyph)
+      drawGlyph(x, y, glyph, f, color, size_x, size_y);
 
-    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
-    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
-    uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
+  } // End classic vs custom font
+}
 
-    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
-    uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
-    int8_t xo = pgm_read_byte(&glyph->xOffset),
-           yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t xx, yy, bits = 0, bit = 0;
-    int16_t xo16 = 0, yo16 = 0;
+/**************************************************************************/
+/*!
+   @brief   Draw a custom font glyph that has already been looked up, so
+            drawCodepoint() and writeCodepoint() find each glyph just once
+    @param    x   Bottom left corner x coordinate
+    @param    y   Bottom left corner y coordinate
+    @param    glyph  The glyph, from findGlyph()
+    @param    font   The font the glyph is in, as findGlyph() set it
+    @param    color 16-bit 5-6-5 Color to draw the glyph with
+    @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+    @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawGlyph(int16_t x, int16_t y, GFXglyph *glyph,
+                             const GFXfont *font, uint16_t color,
+                             uint8_t size_x, uint8_t size_y) {
+  uint8_t *bitmap = pgm_read_bitmap_ptr(font);
 
-    if (size_x > 1 || size_y > 1) {
-      xo16 = xo;
-      yo16 = yo;
-    }
+  uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+  uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+  int8_t xo = pgm_read_byte(&glyph->xOffset),
+         yo = pgm_read_byte(&glyph->yOffset);
+  int32_t gx = x + xo * size_x, gy = y + yo * size_y; // Top-left pixel
 
-    // Todo: Add character clipping here
-
-    // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
-    // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
-    // has typically been used with the 'classic' font to overwrite old
-    // screen contents with new data.  This ONLY works because the
-    // characters are a uniform size; it's not a sensible thing to do with
-    // proportionally-spaced fonts with glyphs of varying sizes (and that
-    // may overlap).  To replace previously-drawn text when using a custom
-    // font, use the getTextBounds() function to determine the smallest
-    // rectangle encompassing a string, erase the area with fillRect(),
-    // then draw new text.  This WILL infortunately 'blink' the text, but
-    // is unavoidable.  Drawing 'background' pixels will NOT fix this,
-    // only creates a new set of problems.  Have an idea to work around
-    // this (a canvas object type for MCUs that can afford the RAM and
-    // displays supporting setAddrWindow() and pushColors()), but haven't
-    // implemented this yet.
+  // Skip glyphs that are entirely outside the clip rect
+  if (!w || !h || isClipped(gx, gy, gx + w * size_x - 1, gy + h * size_y - 1))
+    return;
 
-    startWrite();
-    for (yy = 0; yy < h; yy++) {
-      for (xx = 0; xx < w; xx++) {
-        if (!(bit++ & 7)) {
-          bits = pgm_read_byte(&bitmap[bo++]);
-        }
-        if (bits & 0x80) {
-          if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
-          } else {
-            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
-                          size_x, size_y, color);
-          }
-        }
-        bits <<= 1;
-      }
+  // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
+  // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
+  // has typically been used with the 'classic' font to overwrite old
+  // screen contents with new data.  This ONLY works because the
+  // characters are a uniform size; it's not a sensible thing to do with
+  // proportionally-spaced fonts with glyphs of varying sizes (and that
+  // may overlap).  To replace previously-drawn text when using a custom
+  // font, use the getTextBounds() function to determine the smallest
+  // rectangle encompassing a string, erase the area with fillRect(),
+  // then draw new text.  This WILL infortunately 'blink' the text, but
+  // is unavoidable.  Drawing 'background' pixels will NOT fix this,
+  // only creates a new set of problems.  To replace text without the
+  // blink on a SPITFT display, use drawTextLine(): it composites each
+  // scanline of the text, background included, into a small buffer and
+  // sends the whole line through one setAddrWindow().
+
+  // Only the rows inside the clip rect are decoded. The bitmap is one
+  // bit stream, so row r starts at bit r * w.
+  uint8_t r = 0, r1 = h;
+  if (gy < clipY0())
+    r = (clipY0() - gy) / size_y;
+  if (gy + h * size_y > clipY1())
+    r1 = (clipY1() - gy + size_y - 1) / size_y;
+
+  // Each row is drawn as its runs of set bits, one span (or, scaled, one
+  // rect) per run. Identical rows below it are merged into taller rects.
+  uint8_t row[32], next[32], n = (w + 7) / 8;
+  GFXspan spans[GFX_SPAN_BATCH];
+  uint16_t ns = 0;
+  uint8_t *glyphBits = bitmap + bo;
+  startWrite();
+  glyphRow(glyphBits, (uint32_t)r * w, w, row);
+  while (r < r1) {
+    uint8_t rows = 1;
+    while (r + rows < r1) {
+      glyphRow(glyphBits, (uint32_t)(r + rows) * w, w, next);
+      if (memcmp(row, next, n))
+        break;
+      rows++;
     }
-    endWrite();
-
-  } // End classic vs custom font
+    int16_t ry = gy + r * size_y;
+    for (uint8_t a = glyphRowFind(row, 0, w, true); a < w;) {
+      uint8_t b = glyphRowFind(row, a, w, false);
+      int16_t rx = gx + a * size_x;
+      if (rows == 1 && size_y == 1)
+        addSpan(this, spans, ns, rx, ry, (b - a) * size_x, color);
+      else
+        writeFillRect(rx, ry, (b - a) * size_x, rows * size_y, color);
+      a = glyphRowFind(row, b, w, true);
+    }
+    r += rows;
+    if (r < r1)
+      memcpy(row, next, n);
+  }
+  if (ns)
+    writeSpans(spans, ns, color);
+  endWrite();
 }
+
 /**************************************************************************/
 /*!
-    @brief  Print one byte/character of data, used to support print()
+    @brief  Print one byte/character of data, used to support print(). With
+            UTF-8 text (see utf8()), bytes are gathered until they make a
+            whole codepoint.
     @param  c  The 8-bit ascii character to write
 */
 /**************************************************************************/
 size_t Adafruit_GFX::write(uint8_t c) {
+  uint32_t code;
+  if (decodeUTF8(c, &code))
+    writeCodepoint(code);
+  return 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Print one character by its Unicode codepoint at the cursor,
+            wrapping and advancing it as write() does
+    @param  code  The codepoint, '\n' for a new line
+    @return 1
+*/
+/**************************************************************************/
+size_t Adafruit_GFX::writeCodepoint(uint32_t code) {
   if (!gfxFont) { // 'Classic' built-in font
 
-    if (c == '\n') {              // Newline?
+    if (code == '\n') {           // Newline?
       cursor_x = 0;               // Reset x to zero,
       cursor_y += textsize_y * 8; // advance y one line
-    } else if (c != '\r') {       // Ignore carriage returns
+    } else if ((code != '\r') && (code <= 0xFF)) { // Skip CR, no glyph
       if (wrap && ((cursor_x + textsize_x * 6) > _width)) { // Off right?
         cursor_x = 0;                                       // Reset x to zero,
         cursor_y += textsize_y * 8; // advance y one line
       }
-      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-               textsize_y);
+      drawCodepoint(cursor_x, cursor_y, code, textcolor, textbgcolor,
+                    textsize_x, textsize_y);
       cursor_x += textsize_x * 6; // Advance x one char
     }
 
   } else { // Custom font
 
-    if (c == '\n') {
+    if (code == '\n') {
       cursor_x = 0;
       cursor_y +=
           (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
-    } else if (c != '\r') {
-      uint8_t first = pgm_read_byte(&gfxFont->first);
-      if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+    } else if (code != '\r') {
+      const GFXfont *f = gfxFont;
+      GFXglyph *glyph = findGlyph(code, &f);
+      if (glyph) {
         uint8_t w = pgm_read_byte(&glyph->width),
                 h = pgm_read_byte(&glyph->height);
         if ((w > 0) && (h > 0)) { // Is there an associated bitmap?
@@ -1274,8 +1549,8 @@ size_t Adafruit_GFX::write(uint8_t c) {
             cursor_y += (int16_t)textsize_y *
                         (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
           }
-          drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
-                   textsize_y);
+          drawGlyph(cursor_x, cursor_y, glyph, f, textcolor, textsize_x,
+                    textsize_y);
         }
         cursor_x +=
             (uint8_t)pgm_read_byte(&glyph->xAdvance) * (int16_t)textsize_x;
@@ -1285,7 +1560,166 @@ size_t Adafruit_GFX::write(uint8_t c) {
   return 1;
 }
 
-/**************************************************************************/
+// Feed one byte of UTF-8 to a decoder whose state is *code and *left (the
+// continuation bytes still to come). Returns true once *code holds a whole
+// codepoint. A sequence cut short by a new lead byte, a stray continuation
+// byte, a lead byte no codepoint starts with, and an overlong form,
+// surrogate or value past U+10FFFF are dropped. While a sequence is read,
+// *code keeps a marker bit above the lead byte's bits, which ends up at
+// bit 11, 16 or 21 and so tells how long the sequence was.
+static bool utf8Step(uint8_t c, uint32_t *code, uint8_t *left) {
+  if ((c & 0xC0) == 0x80) { // Continuation byte
+    if (!*left)
+      return false;
+    *code = (*code << 6) | (c & 0x3F);
+    if (--*left)
+      return false;
+    uint32_t min = 0x80; // Least codepoint that needs this many bytes
+    if (*code >= (1UL << 21)) {
+      *code -= 1UL << 21;
+      min = 0x10000;
+    } else if (*code >= (1UL << 16)) {
+      *code -= 1UL << 16;
+      min = 0x800;
+    } else {
+      *code -= 1UL << 11;
+    }
+    return (*code >= min) && (*code <= 0x10FFFF) &&
+           ((*code & 0xFFFFF800UL) != 0xD800);
+  }
+  if (c < 0x80) {
+    *code = c;
+    *left = 0;
+    return true;
+  }
+  if (c >= 0xF8) { // Not UTF-8
+    *left = 0;
+  } else if (c >= 0xF0) { // Lead byte of a 4-byte sequence (U+10000 and up)
+    *code = (c & 0x07) | 0x08;
+    *left = 3;
+  } else if (c >= 0xE0) { // 3 bytes (U+0800 to U+FFFF)
+    *code = (c & 0x0F) | 0x10;
+    *left = 2;
+  } else { // 2 bytes (U+0080 to U+07FF)
+    *code = (c & 0x1F) | 0x20;
+    *left = 1;
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Check whether text is read as UTF-8: if utf8() turned it on, or
+            if the current font (or any in its chain) has codepoints past
+            0xFF
+    @return true for UTF-8, false for one byte per character
+*/
+/**************************************************************************/
+bool Adafruit_GFX::utf8Text(void) const {
+  if (_utf8)
+    return true;
+  if (fontChain) {
+    for (uint8_t i = 0; i < fontChainLength; i++)
+      if ((uint32_t)pgm_read_dword(&fontChain[i]->last) > 0xFF)
+        return true;
+    return false;
+  }
+  return gfxFont && ((uint32_t)pgm_read_dword(&gfxFont->last) > 0xFF);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Turn the bytes of print() text into codepoints, decoding UTF-8
+            if utf8Text() says so
+    @param  c     Next byte of text
+    @param  code  Returns the codepoint, if there is one
+    @return true if code was set, false if more bytes are needed
+*/
+/**************************************************************************/
+bool Adafruit_GFX::decodeUTF8(uint8_t c, uint32_t *code) {
+  if (!utf8Text()) {
+    *code = c;
+    return true;
+  }
+  if (!utf8Step(c, &utf8Code, &utf8Left))
+    return false;
+  *code = utf8Code;
+  return true;
+}
+
+// Look a codepoint up in one custom font, through its range table if it
+// is a GFXfontSparse. Returns NULL if f is NULL or has no glyph for c.
+static GFXglyph *fontGlyph(const GFXfont *f, uint32_t c) {
+  if (!f)
+    return NULL;
+  uint32_t first = pgm_read_dword(&f->first);
+  if (c > (uint32_t)pgm_read_dword(&f->last))
+    return NULL;
+  if (first != GFX_FONT_SPARSE)
+    return (c < first) ? NULL : pgm_read_glyph_ptr(f, c - first);
+
+  // Sparse font: binary search of the range table
+  const GFXfontSparse *font = (const GFXfontSparse *)f;
+  const GFXrange *range = pgm_read_range_ptr(font);
+  uint16_t lo = 0, hi = pgm_read_word(&font->rangeCount);
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    uint32_t start = pgm_read_dword(&range[mid].start);
+    if (c < start)
+      hi = mid;
+    else if (c - start >= (uint16_t)pgm_read_word(&range[mid].count))
+      lo = mid + 1;
+    else
+      return pgm_read_glyph_ptr(
+          f, pgm_read_word(&range[mid].glyphBase) + (c - start));
+  }
+  return NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Look a codepoint up in the current custom font, or in the first
+            font of the setFontChain() chain that has it
+    @param  c     The codepoint
+    @param  font  If not NULL, set to the font the glyph is in (left alone
+                  if there is none)
+    @return The glyph, NULL if there is no custom font or it has no glyph
+            for c
+*/
+/**************************************************************************/
+GFXglyph *Adafruit_GFX::findGlyph(uint32_t c, const GFXfont **font) {
+  if (!fontChain) {
+    if (font)
+      *font = gfxFont;
+    return fontGlyph(gfxFont, c);
+  }
+
+  if (c > 0x10FFFF) // Not Unicode, and 0xFFFFFFFF marks unused entries
+    return NULL;
+  uint8_t i = 0;
+  GFXglyph *glyph = NULL;
+#if GFX_GLYPH_CACHE_SIZE > 0
+  GFXglyphcache *entry = &glyphCache[c % GFX_GLYPH_CACHE_SIZE];
+  if (entry->code == c) {
+    i = entry->font;
+    glyph = entry->glyph;
+  } else {
+#endif
+    for (; i < fontChainLength; i++)
+      if ((glyph = fontGlyph(fontChain[i], c)))
+        break;
+#if GFX_GLYPH_CACHE_SIZE > 0
+    entry->code = c;
+    entry->glyph = glyph;
+    entry->font = i;
+  }
+#endif
+  if (glyph && font)
+    *font = fontChain[i];
+  return glyph;
+}
+
+/**************************************************************************/
 /*!
     @brief   Set text 'magnification' size. Each increase in s makes 1 pixel
    that much bigger.
@@ -1309,11 +1743,13 @@ void Adafruit_GFX::setTextSize(uint8_t s_x, uint8_t s_y) {
 
 /**************************************************************************/
 /*!
-    @brief      Set rotation setting for display
+    @brief      Set rotation setting for display. Also clears the clip
+                rect stack, see pushClipRect().
     @param  x   0 thru 3 corresponding to 4 cardinal rotations
 */
 /**************************************************************************/
 void Adafruit_GFX::setRotation(uint8_t x) {
+  clipDepth = 0; // Clip rects were in the old orientation
   rotation = (x & 3);
   switch (rotation) {
   case 0:
@@ -1348,6 +1784,239 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     cursor_y -= 6;
   }
   gfxFont = (GFXfont *)f;
+  fontChain = NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set a chain of fonts to print() with: each character is drawn
+            from the first font in the chain that has a glyph for it, so
+            e.g. Latin, CJK and emoji fonts can be mixed in one string. The
+            first font sets the line height. Recent lookups are cached, so
+            the characters repeated in a label are only searched for once.
+            setFont() ends the chain.
+    @param  fonts  Array of n custom fonts (not NULL), in the order to try
+                   them. Kept by reference: it must stay valid (and
+                   unchanged) while the chain is in use.
+    @param  n      Number of fonts in the array, 0 for the classic font
+*/
+/**************************************************************************/
+void Adafruit_GFX::setFontChain(const GFXfont *const *fonts, uint8_t n) {
+  setFont(n ? fonts[0] : NULL);
+  if (!n)
+    return;
+  fontChain = fonts;
+  fontChainLength = n;
+#if GFX_GLYPH_CACHE_SIZE > 0
+  for (uint8_t i = 0; i < GFX_GLYPH_CACHE_SIZE; i++) {
+    glyphCache[i].code = 0xFFFFFFFF;
+    glyphCache[i].glyph = NULL;
+    glyphCache[i].font = 0;
+  }
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief  Limit drawing to a rectangle (in the current rotation). Until
+            the matching popClipRect(), every primitive skips or trims
+            whatever falls outside, so repainting one region of the screen
+            only costs the pixels inside it. Clip rects nest: the new one
+            is intersected with the one already in effect. setRotation()
+            clears them all.
+    @param  x  Top left corner x coordinate
+    @param  y  Top left corner y coordinate
+    @param  w  Width in pixels
+    @param  h  Height in pixels
+    @return true on success, false if GFX_CLIP_DEPTH rects are already
+            pushed (the clip is left unchanged)
+    @note   The canvases, Adafruit_SPITFT and Adafruit_GrayOLED honor the
+            clip rect down to the pixel. Other subclasses get it through
+            the generic write*() functions, but drawing directly with
+            their own drawPixel() etc. is only clipped to the screen.
+*/
+/**************************************************************************/
+bool Adafruit_GFX::pushClipRect(int16_t x, int16_t y, int16_t w,
+                                int16_t h) {
+  if (clipDepth >= GFX_CLIP_DEPTH)
+    return false;
+  GFXcliprect r;
+  int32_t x1 = (int32_t)x + w, y1 = (int32_t)y + h;
+  r.x0 = (x > clipX0()) ? x : clipX0();
+  r.y0 = (y > clipY0()) ? y : clipY0();
+  r.x1 = (x1 < clipX1()) ? x1 : clipX1();
+  r.y1 = (y1 < clipY1()) ? y1 : clipY1();
+  if (r.x1 < r.x0) // Empty, which is fine: nothing will be drawn
+    r.x1 = r.x0;
+  if (r.y1 < r.y0)
+    r.y1 = r.y0;
+  clipStack[clipDepth++] = clip;
+  clip = r;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Go back to the clip rect that was in effect before the last
+            pushClipRect() (or to the whole screen).
+*/
+/**************************************************************************/
+void Adafruit_GFX::popClipRect(void) {
+  if (clipDepth)
+    clip = clipStack[--clipDepth];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the area that drawing is currently limited to: the clip
+            rect if one is pushed, else the whole screen.
+    @param  x  Top left corner x coordinate, returned
+    @param  y  Top left corner y coordinate, returned
+    @param  w  Width in pixels, returned
+    @param  h  Height in pixels, returned
+*/
+/**************************************************************************/
+void Adafruit_GFX::getClipRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  *x = clipX0();
+  *y = clipY0();
+  *w = clipX1() - clipX0();
+  *h = clipY1() - clipY0();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Work out which part of a w x h block (image, rectangle) placed
+            at (x,y) can be seen through the clip rect.
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  i0  First visible column, relative to x, returned
+    @param  j0  First visible row, relative to y, returned
+    @param  i1  Column past the last visible one, relative to x, returned
+    @param  j1  Row past the last visible one, relative to y, returned
+    @return true if any of the block is visible. If false, the returned
+            values are not meaningful.
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipImage(int16_t x, int16_t y, int16_t w, int16_t h,
+                             int16_t *i0, int16_t *j0, int16_t *i1,
+                             int16_t *j1) const {
+  int32_t a0 = (int32_t)clipX0() - x, a1 = (int32_t)clipX1() - x;
+  int32_t b0 = (int32_t)clipY0() - y, b1 = (int32_t)clipY1() - y;
+  if (a0 < 0)
+    a0 = 0;
+  if (a1 > w)
+    a1 = w;
+  if (b0 < 0)
+    b0 = 0;
+  if (b1 > h)
+    b1 = h;
+  if ((a1 <= a0) || (b1 <= b0))
+    return false;
+  *i0 = a0;
+  *i1 = a1;
+  *j0 = b0;
+  *j1 = b1;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a rectangle to the clip rect and convert it to unrotated
+            (rotation 0) coordinates, for subclasses that fill rectangles
+            straight into a buffer. Negative w or h extend left or up.
+    @param  x  Top left corner x coordinate, returned unrotated
+    @param  y  Top left corner y coordinate, returned unrotated
+    @param  w  Width in pixels, returned unrotated (always positive)
+    @param  h  Height in pixels, returned unrotated (always positive)
+    @return true if any of the rectangle is visible. If false, the
+            returned values are not meaningful.
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipRawRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  int32_t x0 = *x, y0 = *y, x1, y1;
+  if (*w < 0)
+    x0 += *w + 1;
+  if (*h < 0)
+    y0 += *h + 1;
+  x1 = x0 + abs(*w);
+  y1 = y0 + abs(*h);
+  if (x0 < clipX0())
+    x0 = clipX0();
+  if (y0 < clipY0())
+    y0 = clipY0();
+  if (x1 > clipX1())
+    x1 = clipX1();
+  if (y1 > clipY1())
+    y1 = clipY1();
+  if ((x1 <= x0) || (y1 <= y0))
+    return false;
+  switch (rotation) {
+  case 0:
+    *x = x0;
+    *y = y0;
+    break;
+  case 1:
+    *x = WIDTH - y1;
+    *y = x0;
+    break;
+  case 2:
+    *x = WIDTH - x1;
+    *y = HEIGHT - y1;
+    break;
+  case 3:
+    *x = y0;
+    *y = HEIGHT - x1;
+    break;
+  }
+  if (rotation & 1) {
+    *w = y1 - y0;
+    *h = x1 - x0;
+  } else {
+    *w = x1 - x0;
+    *h = y1 - y0;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip the rectangle of a scroll() to the clip rect, as
+            clipRawRect() does, and convert it and the distance to move its
+            contents to unrotated (rotation 0) coordinates
+    @param  x   Top left corner x coordinate, returned unrotated
+    @param  y   Top left corner y coordinate, returned unrotated
+    @param  w   Width in pixels, returned unrotated (always positive)
+    @param  h   Height in pixels, returned unrotated (always positive)
+    @param  dx  Pixels to move right, returned unrotated
+    @param  dy  Pixels to move down, returned unrotated
+    @return true if any of the rectangle is visible. If false, the
+            returned values are not meaningful.
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipRawScroll(int16_t *x, int16_t *y, int16_t *w,
+                                 int16_t *h, int16_t *dx, int16_t *dy) const {
+  if (!clipRawRect(x, y, w, h))
+    return false;
+  int16_t t = *dx;
+  switch (rotation) {
+  case 1:
+    *dx = -*dy;
+    *dy = t;
+    break;
+  case 2:
+    *dx = -*dx;
+    *dy = -*dy;
+    break;
+  case 3:
+    *dx = *dy;
+    *dy = -t;
+    break;
+  }
+  return true;
 }
 
 /**************************************************************************/
@@ -1355,7 +2024,7 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     @brief  Helper to determine size of a character with current font/size.
             Broke this out as it's used by both the PROGMEM- and RAM-resident
             getTextBounds() functions.
-    @param  c     The ASCII character in question
+    @param  c     The character's codepoint (ASCII for 8-bit text)
     @param  x     Pointer to x location of character. Value is modified by
                   this function to advance to next character.
     @param  y     Pointer to y location of character. Value is modified by
@@ -1368,7 +2037,7 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     @param  maxy  Pointer to maximum Y coord, passed in AND returned.
 */
 /**************************************************************************/
-void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
+void Adafruit_GFX::charBounds(uint32_t c, int16_t *x, int16_t *y,
                               int16_t *minx, int16_t *miny, int16_t *maxx,
                               int16_t *maxy) {
 
@@ -1378,10 +2047,8 @@ void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
       *x = 0;        // Reset x to zero, advance y by one line
       *y += textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
     } else if (c != '\r') { // Not a carriage return; is normal char
-      uint8_t first = pgm_read_byte(&gfxFont->first),
-              last = pgm_read_byte(&gfxFont->last);
-      if ((c >= first) && (c <= last)) { // Char present in this font?
-        GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+      GFXglyph *glyph = findGlyph(c);
+      if (glyph) { // Char present in this font?
         uint8_t gw = pgm_read_byte(&glyph->width),
                 gh = pgm_read_byte(&glyph->height),
                 xa = pgm_read_byte(&glyph->xAdvance);
@@ -1412,7 +2079,7 @@ void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
       *x = 0;               // Reset x to zero,
       *y += textsize_y * 8; // advance y one line
       // min/max x/y unchaged -- that waits for next 'normal' character
-    } else if (c != '\r') { // Normal char; ignore carriage returns
+    } else if ((c != '\r') && (c <= 0xFF)) { // Normal char; ignore CRs
       if (wrap && ((*x + textsize_x * 6) > _width)) { // Off right?
         *x = 0;                                       // Reset x to zero,
         *y += textsize_y * 8;                         // advance y one line
@@ -1452,6 +2119,9 @@ void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
   uint8_t c; // Current character
   int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1; // Bound rect
   // Bound rect is intentionally initialized inverted, so 1st char sets it
+  bool utf8 = utf8Text();
+  uint32_t code = 0;
+  uint8_t left = 0;
 
   *x1 = x; // Initial position is value passed in
   *y1 = y;
@@ -1460,7 +2130,10 @@ void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
   while ((c = *str++)) {
     // charBounds() modifies x/y to advance for each character,
     // and min/max x/y are updated to incrementally build bounding rect.
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    if (!utf8)
+      charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    else if (utf8Step(c, &code, &left))
+      charBounds(code, &x, &y, &minx, &miny, &maxx, &maxy);
   }
 
   if (maxx >= minx) {     // If legit string bounds were found...
@@ -1517,9 +2190,73 @@ void Adafruit_GFX::getTextBounds(const __FlashStringHelper *str, int16_t x,
   *w = *h = 0;
 
   int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+  bool utf8 = utf8Text();
+  uint32_t code = 0;
+  uint8_t left = 0;
+
+  while ((c = pgm_read_byte(s++))) {
+    if (!utf8)
+      charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    else if (utf8Step(c, &code, &left))
+      charBounds(code, &x, &y, &minx, &miny, &maxx, &maxy);
+  }
+
+  if (maxx >= minx) {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+// Set buf[s] to buf[s + len - 1] to color, skipping what is outside buf[0]
+// to buf[n - 1]
+static void textRun(uint16_t *buf, int32_t n, int32_t s, int32_t len,
+                    uint16_t color) {
+  int32_t e = s + len;
+  if (s < 0)
+    s = 0;
+  if (e > n)
+    e = n;
+  while (s < e)
+    buf[s++] = color;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Measure one line of text as getTextBounds() does, without
+            wrapping, up to the end of the string or the first newline
+    @param  str  The string
+    @param  x    The cursor X
+    @param  y    The cursor Y
+    @param  x1   The boundary X coordinate, set by function
+    @param  y1   The boundary Y coordinate, set by function
+    @param  w    The boundary width, set by function
+    @param  h    The boundary height, set by function
+*/
+/**************************************************************************/
+void Adafruit_GFX::textLineBounds(const char *str, int16_t x, int16_t y,
+                                  int16_t *x1, int16_t *y1, uint16_t *w,
+                                  uint16_t *h) {
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  bool utf8 = utf8Text(), saveWrap = wrap;
+  uint32_t code = 0;
+  uint8_t c, left = 0;
+
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
 
-  while ((c = pgm_read_byte(s++)))
-    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  wrap = false;
+  while ((c = *str++) && (c != '\n')) {
+    if (!utf8)
+      charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    else if (utf8Step(c, &code, &left))
+      charBounds(code, &x, &y, &minx, &miny, &maxx, &maxy);
+  }
+  wrap = saveWrap;
 
   if (maxx >= minx) {
     *x1 = minx;
@@ -1531,6 +2268,117 @@ void Adafruit_GFX::getTextBounds(const __FlashStringHelper *str, int16_t x,
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Lay out one line of text for textLineRow(), as print() would
+            from the cursor x,y in the current font(s) and text size but
+            without wrapping, up to the end of the string or the first
+            newline. Glyphs without pixels only move the cursor.
+    @param  str     The string; advanced past the text laid out. If it
+                    stops short of the end or a newline, glyphs was full:
+                    call again for the rest.
+    @param  x       The cursor X, advanced past the text laid out
+    @param  y       The cursor Y
+    @param  glyphs  Set to the visible glyphs, in drawing order
+    @param  max     Size of glyphs, > 0
+    @return Number of glyphs set
+*/
+/**************************************************************************/
+uint8_t Adafruit_GFX::textLineGlyphs(const char **str, int16_t *x, int16_t y,
+                                     GFXtextglyph *glyphs, uint8_t max) {
+  bool utf8 = utf8Text();
+  uint32_t code = 0;
+  uint8_t c, left = 0, count = 0;
+  int16_t tsx = textsize_x, tsy = textsize_y;
+
+  // Stopping only between glyphs leaves no UTF-8 sequence half read
+  while ((count < max) && (c = **str) && (c != '\n')) {
+    (*str)++;
+    if (!utf8)
+      code = c;
+    else if (!utf8Step(c, &code, &left))
+      continue;
+    if (code == '\r')
+      continue;
+
+    GFXtextglyph *g = &glyphs[count];
+    if (!gfxFont) { // 'Classic' built-in font, 6x8 cells
+      if (code > 0xFF)
+        continue;
+      uint8_t ch = code;
+      if (!_cp437 && (ch >= 176))
+        ch++; // Handle 'classic' charset behavior
+      g->bitmap = &font[ch * 5];
+      g->x = *x;
+      g->y = y;
+      g->width = 5;
+      g->height = 8;
+      count++;
+      *x += 6 * tsx;
+
+    } else { // Custom font
+
+      const GFXfont *f = gfxFont;
+      GFXglyph *glyph = findGlyph(code, &f);
+      if (!glyph)
+        continue;
+      g->width = pgm_read_byte(&glyph->width);
+      g->height = pgm_read_byte(&glyph->height);
+      if (g->width && g->height) {
+        g->bitmap =
+            pgm_read_bitmap_ptr(f) + pgm_read_word(&glyph->bitmapOffset);
+        g->x = *x + (int8_t)pgm_read_byte(&glyph->xOffset) * tsx;
+        g->y = y + (int8_t)pgm_read_byte(&glyph->yOffset) * tsy;
+        count++;
+      }
+      *x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * tsx;
+    }
+  }
+  return count;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Composite one scanline of a line of text into a pixel buffer,
+            for renderers that send whole rows (see
+            Adafruit_SPITFT::drawTextLine()). Pixels of its glyphs are set
+            to textcolor; the rest of the buffer is left as it is.
+    @param  glyphs  The text, laid out by textLineGlyphs()
+    @param  count   Number of glyphs
+    @param  row     The scanline to composite
+    @param  x0      X coordinate of buf[0]
+    @param  buf     Pixels x0 to x0 + n - 1 of the scanline
+    @param  n       Number of pixels in buf
+*/
+/**************************************************************************/
+void Adafruit_GFX::textLineRow(const GFXtextglyph *glyphs, uint8_t count,
+                               int16_t row, int16_t x0, uint16_t *buf,
+                               int16_t n) {
+  uint8_t bits[32];
+  int16_t tsx = textsize_x, tsy = textsize_y;
+
+  for (; count--; glyphs++) {
+    int16_t r = row - glyphs->y;
+    int32_t gx = (int32_t)glyphs->x - x0; // Left edge, relative to buf
+    uint8_t w = glyphs->width;
+    if ((r < 0) || (r >= glyphs->height * tsy) || (gx >= n) ||
+        (gx + w * tsx <= 0))
+      continue;
+    if (!gfxFont) {
+      for (uint8_t i = 0; i < 5; i++)
+        if (pgm_read_byte(&glyphs->bitmap[i]) & (1 << (r / tsy)))
+          textRun(buf, n, gx + i * tsx, tsx, textcolor);
+    } else {
+      glyphRow(glyphs->bitmap, (uint32_t)(r / tsy) * w, w, bits);
+      for (uint8_t a = glyphRowFind(bits, 0, w, true); a < w;) {
+        uint8_t b = glyphRowFind(bits, a, w, false);
+        textRun(buf, n, gx + a * tsx, (b - a) * tsx, textcolor);
+        a = glyphRowFind(bits, b, w, true);
+      }
+    }
+  }
+}
+
 /**************************************************************************/
 /*!
     @brief      Invert the display (ideally using built-in hardware command)
@@ -1753,6 +2601,115 @@ const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
                                                  0xF7, 0xFB, 0xFD, 0xFE};
 #endif
 
+// BitBLT word: one byte on AVR, else the widest native register
+#if defined(__AVR__)
+typedef uint8_t bltword_t;
+#elif UINTPTR_MAX > 0xFFFFFFFFUL
+typedef uint64_t bltword_t;
+#else
+typedef uint32_t bltword_t;
+#endif
+
+static inline uint8_t bltSwap(uint8_t v) { return v; }
+static inline uint32_t bltSwap(uint32_t v) { return __builtin_bswap32(v); }
+static inline uint64_t bltSwap(uint64_t v) { return __builtin_bswap64(v); }
+
+// Load a word of MSB-first pixels, so the leftmost pixel is the top bit
+static inline bltword_t bltLoad(const uint8_t *p, bool pgm) {
+  bltword_t v;
+#if defined(__AVR__) || defined(ESP8266)
+  if (pgm)
+    memcpy_P(&v, p, sizeof(v));
+  else
+#else
+  (void)pgm;
+#endif
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  v = bltSwap(v);
+#endif
+  return v;
+}
+
+static inline void bltStore(uint8_t *p, bltword_t v) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  v = bltSwap(v);
+#endif
+  memcpy(p, &v, sizeof(v));
+}
+
+static inline uint8_t bltByte(const uint8_t *p, bool pgm) {
+  return pgm ? pgm_read_byte(p) : *p;
+}
+
+template <class T> static inline T bltRop(T d, T s, uint8_t rop) {
+  switch (rop) {
+  case GFX_ROP_AND:
+    return d & s;
+  case GFX_ROP_OR:
+    return d | s;
+  case GFX_ROP_XOR:
+    return d ^ s;
+  case GFX_ROP_ANDNOT:
+    return d & ~s;
+  default:
+    return s;
+  }
+}
+
+// Combine a w x h block of a 1-bit MSB-first image, from (sx,sy) in src,
+// into dst at (dx,dy) with a raster op. Both are unrotated and already
+// clipped; strides are in bytes. Unaligned head and tail bits go a byte
+// at a time, the rest a whole bltword_t at a time, the source shifted into
+// line with the destination.
+static void bitBltRaw(uint8_t *dst, int16_t dstStride, int16_t dx, int16_t dy,
+                      const uint8_t *src, int16_t srcStride, int16_t sx,
+                      int16_t sy, int16_t w, int16_t h, uint8_t rop,
+                      bool pgm) {
+  const int16_t wordBits = sizeof(bltword_t) * 8;
+  for (; h--; dy++, sy++) {
+    uint8_t *d = &dst[(int32_t)dy * dstStride];
+    const uint8_t *s = &src[(int32_t)sy * srcStride];
+    int16_t db = dx, sb = sx, n = w, k;
+    for (; n > 0; db += k, sb += k, n -= k) {
+      uint8_t sh = sb & 7;
+      const uint8_t *sp = &s[sb >> 3];
+      if (!(db & 7) && (n >= wordBits)) {
+        k = wordBits;
+        bltword_t v = bltLoad(sp, pgm) << sh;
+        if (sh)
+          v |= bltByte(sp + sizeof(bltword_t), pgm) >> (8 - sh);
+        uint8_t *dp = &d[db >> 3];
+        bltStore(dp, bltRop(bltLoad(dp, false), v, rop));
+      } else {
+        uint8_t off = db & 7;
+        k = min(8 - off, n);
+        uint8_t v = bltByte(sp, pgm) << sh;
+        if (sh + k > 8)
+          v |= bltByte(sp + 1, pgm) >> (8 - sh);
+        uint8_t mask = (0xFF >> off) & ~(0xFF >> (off + k));
+        uint8_t *dp = &d[db >> 3];
+        *dp = (*dp & ~mask) | (bltRop<uint8_t>(*dp, v >> off, rop) & mask);
+      }
+    }
+  }
+}
+
+// Move n pixels of a 1-bit row right, from bit sx to bit dx > sx. A single
+// bitBltRaw() would overwrite source bits before reading them, so the
+// source goes through a small buffer a chunk at a time, rightmost first.
+static void bitShiftRight(uint8_t *row, int16_t sx, int16_t dx, int16_t n) {
+  uint8_t tmp[sizeof(bltword_t) * 8 + 1];
+  const int16_t chunk = sizeof(bltword_t) * 64;
+  while (n > 0) {
+    int16_t k = min(chunk, n);
+    n -= k;
+    int16_t b = sx + n;
+    memcpy(tmp, &row[b >> 3], ((b & 7) + k + 7) >> 3);
+    bitBltRaw(row, 0, dx + n, 0, tmp, 0, b & 7, 0, k, 1, GFX_ROP_COPY, false);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 1-bit canvas context for graphics
@@ -1760,23 +2717,71 @@ const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
    @param    h   Display height, in pixels
 */
 /**************************************************************************/
-GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), owned(true) {
   uint16_t bytes = ((w + 7) / 8) * h;
   if ((buffer = (uint8_t *)malloc(bytes))) {
     memset(buffer, 0, bytes);
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 1-bit canvas context for graphics, drawing into
+             a caller-supplied buffer (a static array, a slice of an arena
+             or a GFXbufferPool block, external RAM...) instead of one
+             allocated from the heap. The buffer's contents are kept, and
+             it is not freed when the canvas is deleted.
+   @param    w       Display width, in pixels
+   @param    h       Display height, in pixels
+   @param    buffer  ((w + 7) / 8) * h bytes, rows padded to whole bytes
+*/
+/**************************************************************************/
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, uint8_t *buffer)
+    : Adafruit_GFX(w, h), buffer(buffer), owned(false) {}
+
+/**************************************************************************/
+/*!
+   @brief    Move a canvas: take over its buffer, leaving it with none
+             (it then ignores drawing calls)
+   @param    canvas  Canvas to move from
+*/
+/**************************************************************************/
+GFXcanvas1::GFXcanvas1(GFXcanvas1 &&canvas)
+    : Adafruit_GFX(canvas), buffer(canvas.buffer), owned(canvas.owned) {
+  canvas.buffer = NULL;
+}
+
 /**************************************************************************/
 /*!
    @brief    Delete the canvas, free memory
 */
 /**************************************************************************/
 GFXcanvas1::~GFXcanvas1(void) {
-  if (buffer)
+  if (buffer && owned)
     free(buffer);
 }
 
+/**************************************************************************/
+/*!
+   @brief    Move a canvas into this one, freeing this one's buffer
+             first if it owns it
+   @param    canvas  Canvas to move from, left with no buffer
+   @return   This canvas
+*/
+/**************************************************************************/
+GFXcanvas1 &GFXcanvas1::operator=(GFXcanvas1 &&canvas) {
+  if (this != &canvas) {
+    if (buffer && owned)
+      free(buffer);
+    Adafruit_GFX::operator=(canvas);
+    buffer = canvas.buffer;
+    owned = canvas.owned;
+    canvas.buffer = NULL;
+  }
+  return *this;
+}
+
 /**************************************************************************/
 /*!
     @brief  Draw a pixel to the canvas framebuffer
@@ -1787,7 +2792,7 @@ GFXcanvas1::~GFXcanvas1(void) {
 /**************************************************************************/
 void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if (isClipped(x, y))
       return;
 
     int16_t t;
@@ -1808,18 +2813,7 @@ void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
       break;
     }
 
-    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
-#ifdef __AVR__
-    if (color)
-      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
-    else
-      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
-#else
-    if (color)
-      *ptr |= 0x80 >> (x & 7);
-    else
-      *ptr &= ~(0x80 >> (x & 7));
-#endif
+    drawRawPixel(x, y, color);
   }
 }
 
@@ -1882,11 +2876,16 @@ bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
 
 /**************************************************************************/
 /*!
-    @brief  Fill the framebuffer completely with one color
+    @brief  Fill the framebuffer completely with one color (or just the
+            clip rect, if one is pushed)
     @param  color Binary (on or off) color to fill with
 */
 /**************************************************************************/
 void GFXcanvas1::fillScreen(uint16_t color) {
+  if (clipDepth) { // Only the clip rect
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
   if (buffer) {
     uint16_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
     memset(buffer, color ? 0xFF : 0x00, bytes);
@@ -1895,91 +2894,354 @@ void GFXcanvas1::fillScreen(uint16_t color) {
 
 /**************************************************************************/
 /*!
-   @brief  Speed optimized vertical line drawing
-   @param  x      Line horizontal start point
-   @param  y      Line vertical start point
-   @param  h      Length of vertical line to be drawn, including first point
-   @param  color  Color to fill with
+   @brief  Fill a rectangle straight into the buffer, a row at a time in
+           buffer order whatever the rotation. Negative w or h extend left
+           or up, as on Adafruit_SPITFT.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
-                               uint16_t color) {
-
-  if (h < 0) { // Convert negative heights to positive equivalent
-    h *= -1;
-    y -= h - 1;
-    if (y < 0) {
-      h += y;
-      y = 0;
-    }
-  }
-
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+void GFXcanvas1::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  if (!buffer || !clipRawRect(&x, &y, &w, &h))
+    return;
+  if (w == WIDTH) { // Whole rows, one block
+    uint16_t rowBytes = (WIDTH + 7) / 8;
+    memset(&buffer[y * rowBytes], color ? 0xFF : 0x00, rowBytes * h);
     return;
   }
-
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
-  }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
-  }
-
-  if (getRotation() == 0) {
-    drawFastRawVLine(x, y, h, color);
-  } else if (getRotation() == 1) {
-    int16_t t = x;
-    x = WIDTH - 1 - y;
-    y = t;
-    x -= h - 1;
-    drawFastRawHLine(x, y, h, color);
-  } else if (getRotation() == 2) {
-    x = WIDTH - 1 - x;
-    y = HEIGHT - 1 - y;
-
-    y -= h - 1;
-    drawFastRawVLine(x, y, h, color);
-  } else if (getRotation() == 3) {
-    int16_t t = x;
-    x = y;
-    y = HEIGHT - 1 - t;
-    drawFastRawHLine(x, y, h, color);
-  }
+  for (int16_t y1 = y + h; y < y1; y++)
+    drawFastRawHLine(x, y, w, color);
 }
 
 /**************************************************************************/
 /*!
-   @brief  Speed optimized horizontal line drawing
-   @param  x      Line horizontal start point
-   @param  y      Line vertical start point
-   @param  w      Length of horizontal line to be drawn, including first point
-   @param  color  Color to fill with
+   @brief  Fill a rectangle, same as fillRect() on a canvas
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
+void GFXcanvas1::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                uint16_t color) {
-  if (w < 0) { // Convert negative widths to positive equivalent
-    w *= -1;
-    x -= w - 1;
-    if (x < 0) {
-      w += x;
-      x = 0;
-    }
-  }
+  GFXcanvas1::fillRect(x, y, w, h, color);
+}
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+/**************************************************************************/
+/*!
+   @brief  Move everything on the canvas by (dx,dy), as when scrolling a
+           log or a chart, filling the area it leaves with a color. Only
+           the clip rect moves, if one is set.
+   @param  dx     Pixels to move right (negative: left)
+   @param  dy     Pixels to move down (negative: up)
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::scroll(int16_t dx, int16_t dy, uint16_t color) {
+  GFXcanvas1::scroll(dx, dy, 0, 0, _width, _height, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move the contents of a rectangle by (dx,dy) with a memory move,
+           instead of redrawing them, filling the part they leave with a
+           color. Pixels moved out of the rectangle are lost and none
+           move in, so after scrolling a text or chart area only the new
+           line or column has to be drawn.
+   @param  dx     Pixels to move right (negative: left)
+   @param  dy     Pixels to move down (negative: up)
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::scroll(int16_t dx, int16_t dy, int16_t x, int16_t y,
+                        int16_t w, int16_t h, uint16_t color) {
+  if ((!dx && !dy) || !buffer || !clipRawScroll(&x, &y, &w, &h, &dx, &dy))
+    return;
+  int16_t stride = (WIDTH + 7) / 8, ax = abs(dx), ay = abs(dy);
+  if ((ax >= w) || (ay >= h))
+    ay = h; // Nothing stays, fill it all
+  int16_t n = w - ax, rows = h - ay;
+  int16_t sx = (dx > 0) ? x : x + ax, tx = (dx > 0) ? x + ax : x;
+  int16_t sy = (dy > 0) ? y : y + ay, ty = (dy > 0) ? y + ay : y;
+  if (dy > 0) { // Moving down: bottom row first
+    for (int16_t r = rows; r--;)
+      bitBltRaw(buffer, stride, tx, ty + r, buffer, stride, sx, sy + r, n, 1,
+                GFX_ROP_COPY, false);
+  } else if (dy || (dx < 0)) { // Sources are always read before written
+    bitBltRaw(buffer, stride, tx, ty, buffer, stride, sx, sy, n, rows,
+              GFX_ROP_COPY, false);
+  } else {
+    for (int16_t r = 0; r < rows; r++)
+      bitShiftRight(&buffer[(int32_t)(y + r) * stride], sx, tx, n);
+  }
+  // Fill the rows uncovered at the top or bottom, then the columns
+  for (int16_t r = 0; r < ay; r++)
+    drawFastRawHLine(x, ((dy > 0) ? y : y + rows) + r, w, color);
+  for (int16_t r = 0; ax && (r < rows); r++)
+    drawFastRawHLine((dx > 0) ? x : x + n, ty + r, ax, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Combine part of a 1-bit image into the canvas with bitBltRaw(),
+           rotation 0 only
+   @param  x       Top left corner x coordinate
+   @param  y       Top left corner y coordinate
+   @param  bitmap  MSB-first image, rows padded to whole bytes
+   @param  pgm     True if bitmap is PROGMEM-resident
+   @param  w       Width of bitmap in pixels
+   @param  h       Height of bitmap in pixels
+   @param  rop     Raster op, GFX_ROP_COPY etc.
+*/
+/**************************************************************************/
+void GFXcanvas1::blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                            bool pgm, int16_t w, int16_t h, uint8_t rop) {
+  int16_t i0, j0, i1, j1;
+  if (buffer && clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    bitBltRaw(buffer, (WIDTH + 7) / 8, x + i0, y + j0, bitmap, (w + 7) / 8,
+              i0, j0, i1 - i0, j1 - j0, rop, pgm);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Draw a 1-bit image with foreground and background colors,
+           as a fill and/or a single raster op at rotation 0
+   @param  x       Top left corner x coordinate
+   @param  y       Top left corner y coordinate
+   @param  bitmap  MSB-first image, rows padded to whole bytes
+   @param  pgm     True if bitmap is PROGMEM-resident
+   @param  w       Width of bitmap in pixels
+   @param  h       Height of bitmap in pixels
+   @param  color   Color for set bits
+   @param  bg      Color for unset bits
+*/
+/**************************************************************************/
+void GFXcanvas1::drawBitmapBg(int16_t x, int16_t y, const uint8_t *bitmap,
+                              bool pgm, int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg) {
+  if ((w <= 0) || (h <= 0))
+    return;
+  if (!color != !bg) { // Set bits in one color, unset in the other
+    if (!color)        // Inverted: fill, then clear the set bits
+      fillRect(x, y, w, h, bg);
+    blitBitmap(x, y, bitmap, pgm, w, h,
+               color ? GFX_ROP_COPY : GFX_ROP_ANDNOT);
+  } else {
+    fillRect(x, y, w, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief   Draw a drawBitmap() image a word at a time with bitBltRaw() at
+            rotation 0. Other rotations are left to Adafruit_GFX.
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    bitmap  MSB-first image, rows padded to whole bytes
+    @param    pgm     True if bitmap is PROGMEM-resident
+    @param    format  GFX_IMAGE_1BIT or GFX_IMAGE_1BIT_BG
+    @param    w       Width of bitmap in pixels
+    @param    h       Height of bitmap in pixels
+    @param    color   1-bit color for set bits
+    @param    bg      1-bit color for unset bits (GFX_IMAGE_1BIT_BG)
+    @returns  True if the image was drawn
+*/
+/**************************************************************************/
+bool GFXcanvas1::drawImageFast(int16_t x, int16_t y, const void *bitmap,
+                               bool pgm, uint8_t format, int16_t w, int16_t h,
+                               uint16_t color, uint16_t bg) {
+  if (rotation)
+    return false;
+  if (format == GFX_IMAGE_1BIT)
+    blitBitmap(x, y, (const uint8_t *)bitmap, pgm, w, h,
+               color ? GFX_ROP_OR : GFX_ROP_ANDNOT);
+  else if (format == GFX_IMAGE_1BIT_BG)
+    drawBitmapBg(x, y, (const uint8_t *)bitmap, pgm, w, h, color, bg);
+  else
+    return false;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief  Combine a RAM-resident 1-bit image (drawBitmap() layout) into
+           the canvas with a raster op. At rotation 0 this works a machine
+           word at a time for any alignment of x; otherwise pixel by pixel.
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    rop GFX_ROP_COPY, GFX_ROP_AND, GFX_ROP_OR, GFX_ROP_XOR or
+                  GFX_ROP_ANDNOT
+*/
+/**************************************************************************/
+void GFXcanvas1::bitBlt(int16_t x, int16_t y, const uint8_t *bitmap,
+                        int16_t w, int16_t h, uint8_t rop) {
+  if (!rotation) {
+    blitBitmap(x, y, bitmap, false, w, h, rop);
+    return;
+  }
+  int16_t bw = (w + 7) / 8, i0, j0, i1, j1;
+  if (!buffer || !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      uint8_t s = (bitmap[j * bw + i / 8] >> (7 - (i & 7))) & 1;
+      drawPixel(x + i, y + j, bltRop<uint8_t>(getPixel(x + i, y + j), s, rop));
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Combine a w x h block of another 1-bit canvas, from (sx,sy),
+           into this one at (x,y) with a raster op. Clipped to src and to
+           the clip rect. When both canvases are at rotation 0 this works a
+           machine word at a time for any alignment of x and sx; otherwise
+           pixel by pixel. src must not be this canvas.
+    @param    x   Destination top left corner x coordinate
+    @param    y   Destination top left corner y coordinate
+    @param    src Source canvas, read in its current rotation
+    @param    sx  Source top left corner x coordinate
+    @param    sy  Source top left corner y coordinate
+    @param    w   Width of block in pixels
+    @param    h   Height of block in pixels
+    @param    rop GFX_ROP_COPY, GFX_ROP_AND, GFX_ROP_OR, GFX_ROP_XOR or
+                  GFX_ROP_ANDNOT
+*/
+/**************************************************************************/
+void GFXcanvas1::bitBlt(int16_t x, int16_t y, const GFXcanvas1 &src,
+                        int16_t sx, int16_t sy, int16_t w, int16_t h,
+                        uint8_t rop) {
+  int16_t i0, j0, i1, j1, ox = max(-sx, 0), oy = max(-sy, 0);
+  if (!buffer || !src.buffer)
+    return;
+  // Trim the block to the source canvas, then to the clip rect
+  x += ox;
+  sx += ox;
+  w -= ox;
+  y += oy;
+  sy += oy;
+  h -= oy;
+  w = min(w, src.width() - sx);
+  h = min(h, src.height() - sy);
+  if (!clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return;
+  if (!rotation && !src.rotation) {
+    bitBltRaw(buffer, (WIDTH + 7) / 8, x + i0, y + j0, src.buffer,
+              (src.WIDTH + 7) / 8, sx + i0, sy + j0, i1 - i0, j1 - j0, rop,
+              false);
+    return;
+  }
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      uint8_t s = src.getPixel(sx + i, sy + j);
+      drawPixel(x + i, y + j, bltRop<uint8_t>(getPixel(x + i, y + j), s, rop));
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized vertical line drawing
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  h      Length of vertical line to be drawn, including first point
+   @param  color  Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                               uint16_t color) {
+
+  if (h < 0) { // Convert negative heights to positive equivalent
+    h *= -1;
+    y -= h - 1;
+    if (y < 0) {
+      h += y;
+      y = 0;
+    }
+  }
+
+  // Edge rejection (no-draw if totally off canvas or outside clip rect)
+  int16_t cy0 = clipY0(), cy1 = clipY1();
+  if ((x < clipX0()) || (x >= clipX1()) || (y >= cy1) ||
+      ((y + h - 1) < cy0)) {
+    return;
+  }
+
+  if (y < cy0) { // Clip top
+    h -= cy0 - y;
+    y = cy0;
+  }
+  if (y + h > cy1) { // Clip bottom
+    h = cy1 - y;
+  }
+
+  if (getRotation() == 0) {
+    drawFastRawVLine(x, y, h, color);
+  } else if (getRotation() == 1) {
+    int16_t t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    x -= h - 1;
+    drawFastRawHLine(x, y, h, color);
+  } else if (getRotation() == 2) {
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+
+    y -= h - 1;
+    drawFastRawVLine(x, y, h, color);
+  } else if (getRotation() == 3) {
+    int16_t t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    drawFastRawHLine(x, y, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized horizontal line drawing
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  w      Length of horizontal line to be drawn, including first point
+   @param  color  Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                               uint16_t color) {
+  if (w < 0) { // Convert negative widths to positive equivalent
+    w *= -1;
+    x -= w - 1;
+    if (x < 0) {
+      w += x;
+      x = 0;
+    }
+  }
+
+  // Edge rejection (no-draw if totally off canvas or outside clip rect)
+  int16_t cx0 = clipX0(), cx1 = clipX1();
+  if ((y < clipY0()) || (y >= clipY1()) || (x >= cx1) ||
+      ((x + w - 1) < cx0)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < cx0) { // Clip left
+    w -= cx0 - x;
+    x = cx0;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w >= cx1) { // Clip right
+    w = cx1 - x;
   }
 
   if (getRotation() == 0) {
@@ -2004,6 +3266,36 @@ void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Draw a batch of horizontal spans from the filled primitives.
+   Each span is clipped here and, when the canvas is not rotated, goes
+   straight to drawFastRawHLine().
+   @param    spans   Array of spans, each with a positive width
+   @param    count   Number of spans in the array
+   @param    color   Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::writeSpans(const GFXspan *spans, uint16_t count,
+                            uint16_t color) {
+  if (getRotation()) {
+    for (; count--; spans++)
+      GFXcanvas1::drawFastHLine(spans->x, spans->y, spans->w, color);
+    return;
+  }
+  int16_t cx0 = clipX0(), cy0 = clipY0(), cx1 = clipX1(), cy1 = clipY1();
+  for (; count--; spans++) {
+    int16_t x = spans->x, y = spans->y, x2 = x + spans->w - 1;
+    if ((y < cy0) || (y >= cy1) || (x >= cx1) || (x2 < cx0))
+      continue;
+    if (x < cx0) // Clip left
+      x = cx0;
+    if (x2 >= cx1) // Clip right
+      x2 = cx1 - 1;
+    drawFastRawHLine(x, y, x2 - x + 1, color);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Speed optimized vertical line drawing into the raw canvas buffer
@@ -2109,6 +3401,98 @@ void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   }
 }
 
+// Source pixel readers for blitRaw(), RAM or PROGMEM
+static inline uint8_t readPixel(const uint8_t *p, bool pgm) {
+  return pgm ? pgm_read_byte(p) : *p;
+}
+static inline uint16_t readPixel(const uint16_t *p, bool pgm) {
+  return pgm ? pgm_read_word(p) : *p;
+}
+
+// Copy the (i0,j0)-(i1,j1) part of a w-wide image placed at (x,y) straight
+// into a canvas buffer of raw size W x H, clip already done by clipImage().
+// Rotation 0 copies whole rows, rotation 2 walks rows backwards, and the
+// odd rotations transpose in strips of BLIT_STRIP source rows so both the
+// source and the buffer are read and written a short run at a time.
+#define BLIT_STRIP 8
+template <class T>
+static void blitRaw(T *buf, int16_t W, int16_t H, uint8_t rotation,
+                    const T *bitmap, bool pgm, int16_t x, int16_t y,
+                    int16_t w, int16_t i0, int16_t j0, int16_t i1,
+                    int16_t j1) {
+  int16_t n = i1 - i0;
+  const T *src = &bitmap[(int32_t)j0 * w + i0];
+  T *dst;
+  if (rotation == 0) {
+    dst = &buf[(int32_t)(y + j0) * W + x + i0];
+    for (int16_t j = j0; j < j1; j++, src += w, dst += W) {
+#if defined(__AVR__) || defined(ESP8266)
+      if (pgm)
+        memcpy_P(dst, src, n * sizeof(T));
+      else
+#endif
+        memcpy(dst, src, n * sizeof(T));
+    }
+  } else if (rotation == 2) {
+    dst = &buf[(int32_t)(H - 1 - y - j0) * W + W - 1 - x - i0];
+    for (int16_t j = j0; j < j1; j++, src += w, dst -= W) {
+      for (int16_t i = 0; i < n; i++)
+        dst[-i] = readPixel(&src[i], pgm);
+    }
+  } else {
+    // Source column i lands on one buffer row, source rows run along it:
+    // leftwards from the right edge for rotation 1, rightwards for 3.
+    int16_t step = (rotation == 1) ? -1 : 1;
+    for (int16_t jb = j0; jb < j1; jb += BLIT_STRIP) {
+      int16_t rows = min(BLIT_STRIP, j1 - jb);
+      for (int16_t i = i0; i < i1; i++) {
+        const T *s = &bitmap[(int32_t)jb * w + i];
+        if (rotation == 1)
+          dst = &buf[(int32_t)(x + i) * W + W - 1 - y - jb];
+        else
+          dst = &buf[(int32_t)(H - 1 - x - i) * W + y + jb];
+        for (int16_t j = 0; j < rows; j++, s += w, dst += step)
+          *dst = readPixel(s, pgm);
+      }
+    }
+  }
+}
+
+// Move a w x h block of a canvas buffer of raw width W by (dx,dy), a row
+// at a time with memmove, in the order that reads each row before it is
+// overwritten, then fill the strips it uncovers. All unrotated and
+// already clipped.
+template <class T>
+static void scrollRaw(T *buf, int16_t W, int16_t x, int16_t y, int16_t w,
+                      int16_t h, int16_t dx, int16_t dy, T color) {
+  int16_t ax = abs(dx), ay = abs(dy);
+  if ((ax >= w) || (ay >= h))
+    ay = h; // Nothing stays, fill it all
+  int16_t n = w - ax, rows = h - ay;
+  int16_t sx = (dx > 0) ? x : x + ax, tx = (dx > 0) ? x + ax : x;
+  int16_t sy = (dy > 0) ? y : y + ay, ty = (dy > 0) ? y + ay : y;
+  int32_t step = W;
+  if (rows) {
+    T *src = &buf[(int32_t)sy * W + sx], *dst = &buf[(int32_t)ty * W + tx];
+    if (dy > 0) { // Moving down: bottom row first
+      src += (int32_t)(rows - 1) * W;
+      dst += (int32_t)(rows - 1) * W;
+      step = -step;
+    }
+    for (int16_t r = rows; r--; src += step, dst += step)
+      memmove(dst, src, n * sizeof(T));
+  }
+  // Fill the rows uncovered at the top or bottom, then the columns
+  T *p = &buf[(int32_t)((dy > 0) ? y : y + rows) * W + x];
+  for (int16_t r = ay; r--; p += W)
+    for (int16_t i = 0; i < w; i++)
+      p[i] = color;
+  p = &buf[(int32_t)ty * W + ((dx > 0) ? x : x + n)];
+  for (int16_t r = ax ? rows : 0; r--; p += W)
+    for (int16_t i = 0; i < ax; i++)
+      p[i] = color;
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 8-bit canvas context for graphics
@@ -2116,7 +3500,8 @@ void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
    @param    h   Display height, in pixels
 */
 /**************************************************************************/
-GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), owned(true) {
   uint32_t bytes = w * h;
   if ((buffer = (uint8_t *)malloc(bytes))) {
     memset(buffer, 0, bytes);
@@ -2129,10 +3514,57 @@ GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
 */
 /**************************************************************************/
 GFXcanvas8::~GFXcanvas8(void) {
-  if (buffer)
+  if (buffer && owned)
     free(buffer);
 }
 
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 8-bit canvas context for graphics, drawing into
+             a caller-supplied buffer (a static array, a slice of an arena
+             or a GFXbufferPool block, external RAM...) instead of one
+             allocated from the heap. The buffer's contents are kept, and
+             it is not freed when the canvas is deleted.
+   @param    w       Display width, in pixels
+   @param    h       Display height, in pixels
+   @param    buffer  w * h bytes
+*/
+/**************************************************************************/
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h, uint8_t *buffer)
+    : Adafruit_GFX(w, h), buffer(buffer), owned(false) {}
+
+/**************************************************************************/
+/*!
+   @brief    Move a canvas: take over its buffer, leaving it with none
+             (it then ignores drawing calls)
+   @param    canvas  Canvas to move from
+*/
+/**************************************************************************/
+GFXcanvas8::GFXcanvas8(GFXcanvas8 &&canvas)
+    : Adafruit_GFX(canvas), buffer(canvas.buffer), owned(canvas.owned) {
+  canvas.buffer = NULL;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Move a canvas into this one, freeing this one's buffer
+             first if it owns it
+   @param    canvas  Canvas to move from, left with no buffer
+   @return   This canvas
+*/
+/**************************************************************************/
+GFXcanvas8 &GFXcanvas8::operator=(GFXcanvas8 &&canvas) {
+  if (this != &canvas) {
+    if (buffer && owned)
+      free(buffer);
+    Adafruit_GFX::operator=(canvas);
+    buffer = canvas.buffer;
+    owned = canvas.owned;
+    canvas.buffer = NULL;
+  }
+  return *this;
+}
+
 /**************************************************************************/
 /*!
     @brief  Draw a pixel to the canvas framebuffer
@@ -2143,7 +3575,7 @@ GFXcanvas8::~GFXcanvas8(void) {
 /**************************************************************************/
 void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if (isClipped(x, y))
       return;
 
     int16_t t;
@@ -2164,7 +3596,7 @@ void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
       break;
     }
 
-    buffer[x + y * WIDTH] = color;
+    drawRawPixel(x, y, color);
   }
 }
 
@@ -2218,16 +3650,128 @@ uint8_t GFXcanvas8::getRawPixel(int16_t x, int16_t y) const {
 
 /**************************************************************************/
 /*!
-    @brief  Fill the framebuffer completely with one color
+    @brief  Fill the framebuffer completely with one color (or just the
+            clip rect, if one is pushed)
     @param  color 8-bit Color to fill with. Only lower byte of uint16_t is used.
 */
 /**************************************************************************/
 void GFXcanvas8::fillScreen(uint16_t color) {
+  if (clipDepth) { // Only the clip rect
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
   if (buffer) {
     memset(buffer, color, WIDTH * HEIGHT);
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle straight into the buffer, a row at a time in
+           buffer order whatever the rotation. Negative w or h extend left
+           or up, as on Adafruit_SPITFT.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  8-bit color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas8::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  if (!buffer || !clipRawRect(&x, &y, &w, &h))
+    return;
+  uint8_t *ptr = &buffer[(uint32_t)y * WIDTH + x];
+  if (w == WIDTH) { // Whole rows, one block
+    memset(ptr, color, (uint32_t)w * h);
+    return;
+  }
+  for (; h--; ptr += WIDTH)
+    memset(ptr, color, w);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle, same as fillRect() on a canvas
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  8-bit color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas8::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                               uint16_t color) {
+  GFXcanvas8::fillRect(x, y, w, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move everything on the canvas by (dx,dy), as when scrolling a
+           log or a chart, filling the area it leaves with a color. Only
+           the clip rect moves, if one is set.
+   @param  dx     Pixels to move right (negative: left)
+   @param  dy     Pixels to move down (negative: up)
+   @param  color  8-bit color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::scroll(int16_t dx, int16_t dy, uint16_t color) {
+  GFXcanvas8::scroll(dx, dy, 0, 0, _width, _height, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move the contents of a rectangle by (dx,dy) with a memory move,
+           instead of redrawing them, filling the part they leave with a
+           color. Pixels moved out of the rectangle are lost and none
+           move in, so after scrolling a text or chart area only the new
+           line or column has to be drawn.
+   @param  dx     Pixels to move right (negative: left)
+   @param  dy     Pixels to move down (negative: up)
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  8-bit color to fill with. Only lower byte of uint16_t is used.
+*/
+/**************************************************************************/
+void GFXcanvas8::scroll(int16_t dx, int16_t dy, int16_t x, int16_t y,
+                        int16_t w, int16_t h, uint16_t color) {
+  if ((!dx && !dy) || !buffer || !clipRawScroll(&x, &y, &w, &h, &dx, &dy))
+    return;
+  scrollRaw<uint8_t>(buffer, WIDTH, x, y, w, h, dx, dy, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy a drawGrayscaleBitmap() image straight into the canvas
+            buffer, in any rotation
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    bitmap  byte array with grayscale bitmap
+    @param    pgm     True if bitmap is PROGMEM-resident
+    @param    format  Only GFX_IMAGE_GRAY8 is handled here
+    @param    w       Width of bitmap in pixels
+    @param    h       Height of bitmap in pixels
+    @param    color   Unused
+    @param    bg      Unused
+    @returns  True if the image was drawn
+*/
+/**************************************************************************/
+bool GFXcanvas8::drawImageFast(int16_t x, int16_t y, const void *bitmap,
+                               bool pgm, uint8_t format, int16_t w, int16_t h,
+                               uint16_t color, uint16_t bg) {
+  (void)color;
+  (void)bg;
+  if (format != GFX_IMAGE_GRAY8)
+    return false;
+  int16_t i0, j0, i1, j1;
+  if (buffer && clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    blitRaw(buffer, WIDTH, HEIGHT, rotation, (const uint8_t *)bitmap, pgm, x,
+            y, w, i0, j0, i1, j1);
+  return true;
+}
+
 /**************************************************************************/
 /*!
    @brief  Speed optimized vertical line drawing
@@ -2249,17 +3793,19 @@ void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or outside clip rect)
+  int16_t cy0 = clipY0(), cy1 = clipY1();
+  if ((x < clipX0()) || (x >= clipX1()) || (y >= cy1) ||
+      ((y + h - 1) < cy0)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < cy0) { // Clip top
+    h -= cy0 - y;
+    y = cy0;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > cy1) { // Clip bottom
+    h = cy1 - y;
   }
 
   if (getRotation() == 0) {
@@ -2306,17 +3852,19 @@ void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or outside clip rect)
+  int16_t cx0 = clipX0(), cx1 = clipX1();
+  if ((y < clipY0()) || (y >= clipY1()) || (x >= cx1) ||
+      ((x + w - 1) < cx0)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < cx0) { // Clip left
+    w -= cx0 - x;
+    x = cx0;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w >= cx1) { // Clip right
+    w = cx1 - x;
   }
 
   if (getRotation() == 0) {
@@ -2341,6 +3889,37 @@ void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Draw a batch of horizontal spans from the filled primitives.
+   Each span is clipped here and, when the canvas is not rotated, goes
+   straight to drawFastRawHLine().
+   @param    spans   Array of spans, each with a positive width
+   @param    count   Number of spans in the array
+   @param    color   8-bit Color to fill with. Only lower byte of uint16_t is
+                     used.
+*/
+/**************************************************************************/
+void GFXcanvas8::writeSpans(const GFXspan *spans, uint16_t count,
+                            uint16_t color) {
+  if (getRotation()) {
+    for (; count--; spans++)
+      GFXcanvas8::drawFastHLine(spans->x, spans->y, spans->w, color);
+    return;
+  }
+  int16_t cx0 = clipX0(), cy0 = clipY0(), cx1 = clipX1(), cy1 = clipY1();
+  for (; count--; spans++) {
+    int16_t x = spans->x, y = spans->y, x2 = x + spans->w - 1;
+    if ((y < cy0) || (y >= cy1) || (x >= cx1) || (x2 < cx0))
+      continue;
+    if (x < cx0) // Clip left
+      x = cx0;
+    if (x2 >= cx1) // Clip right
+      x2 = cx1 - 1;
+    drawFastRawHLine(x, y, x2 - x + 1, color);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Speed optimized vertical line drawing into the raw canvas buffer
@@ -2377,6 +3956,75 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   memset(buffer + y * WIDTH + x, color, w);
 }
 
+// Store n copies of an RGB565 pixel. Outside AVR the pointer is first
+// word aligned, then pixels go out 8 per store with SSE2 or NEON, else 4
+// per 64-bit store on 64-bit hosts, then in pairs; AVR stays scalar.
+static void fill16(uint16_t *ptr, uint32_t n, uint16_t color) {
+#if !defined(__AVR__)
+  if (n && ((uintptr_t)ptr & 2)) {
+    *ptr++ = color;
+    n--;
+  }
+#if defined(__SSE2__)
+  __m128i v = _mm_set1_epi16((short)color);
+  for (; n >= 8; n -= 8, ptr += 8)
+    _mm_storeu_si128((__m128i *)ptr, v);
+#elif defined(__ARM_NEON)
+  uint16x8_t v = vdupq_n_u16(color);
+  for (; n >= 8; n -= 8, ptr += 8)
+    vst1q_u16(ptr, v);
+#elif UINTPTR_MAX > 0xFFFFFFFFUL
+  uint64_t quad = color * 0x0001000100010001ULL;
+  for (; n >= 4; n -= 4, ptr += 4)
+    memcpy(ptr, &quad, 8);
+#endif
+  uint32_t pair = color * 0x00010001UL;
+  for (; n >= 2; n -= 2, ptr += 2)
+    memcpy(ptr, &pair, 4);
+#endif
+  while (n--)
+    *ptr++ = color;
+}
+
+// Swap the bytes of n RGB565 pixels in place, in bulk the same way as
+// fill16(): 8 pixels per SSE2/NEON register, else 4 per 64-bit word on
+// 64-bit hosts, then in pairs. AVR stays scalar.
+static void swap16(uint16_t *ptr, uint32_t n) {
+#if !defined(__AVR__)
+#if defined(__SSE2__)
+  for (; n >= 8; n -= 8, ptr += 8) {
+    __m128i v = _mm_loadu_si128((const __m128i *)ptr);
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    _mm_storeu_si128((__m128i *)ptr, v);
+  }
+#elif defined(__ARM_NEON)
+  for (; n >= 8; n -= 8, ptr += 8)
+    vst1q_u8((uint8_t *)ptr, vrev16q_u8(vld1q_u8((const uint8_t *)ptr)));
+#elif UINTPTR_MAX > 0xFFFFFFFFUL
+  for (; n >= 4; n -= 4, ptr += 4) {
+    uint64_t quad;
+    memcpy(&quad, ptr, 8);
+    quad = ((quad & 0x00FF00FF00FF00FFULL) << 8) |
+           ((quad >> 8) & 0x00FF00FF00FF00FFULL);
+    memcpy(ptr, &quad, 8);
+  }
+#endif
+  for (; n >= 2; n -= 2, ptr += 2) {
+    uint32_t pair;
+    memcpy(&pair, ptr, 4);
+    pair = ((pair & 0x00FF00FFUL) << 8) | ((pair >> 8) & 0x00FF00FFUL);
+    memcpy(ptr, &pair, 4);
+  }
+#endif
+  for (; n--; ptr++)
+    *ptr = __builtin_bswap16(*ptr);
+}
+
+// Number of dirty tiles needed to cover a canvas dimension
+static inline uint16_t dirtyTiles(uint16_t pixels) {
+  return (pixels + (1 << GFX_DIRTY_TILE_SHIFT) - 1) >> GFX_DIRTY_TILE_SHIFT;
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 16-bit canvas context for graphics
@@ -2384,7 +4032,9 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
    @param    h   Display height, in pixels
 */
 /**************************************************************************/
-GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), dirty(NULL), dirtyStride(0), frame(NULL),
+      frameValid(false), owned(true) {
   uint32_t bytes = w * h * 2;
   if ((buffer = (uint16_t *)malloc(bytes))) {
     memset(buffer, 0, bytes);
@@ -2397,8 +4047,243 @@ GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
 */
 /**************************************************************************/
 GFXcanvas16::~GFXcanvas16(void) {
-  if (buffer)
+  if (buffer && owned)
     free(buffer);
+  if (dirty)
+    free(dirty);
+  if (frame)
+    free(frame);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 16-bit canvas context for graphics, drawing into
+             a caller-supplied buffer (a static array, a slice of an arena
+             or a GFXbufferPool block, external RAM...) instead of one
+             allocated from the heap. The buffer's contents are kept, and
+             it is not freed when the canvas is deleted.
+   @param    w       Display width, in pixels
+   @param    h       Display height, in pixels
+   @param    buffer  w * h 16-bit pixels
+*/
+/**************************************************************************/
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, uint16_t *buffer)
+    : Adafruit_GFX(w, h), buffer(buffer), dirty(NULL), dirtyStride(0),
+      frame(NULL), frameValid(false), owned(false) {}
+
+/**************************************************************************/
+/*!
+   @brief    Move a canvas: take over its buffer, dirty tiles and kept
+             frame, leaving it with none (it then ignores drawing calls)
+   @param    canvas  Canvas to move from
+*/
+/**************************************************************************/
+GFXcanvas16::GFXcanvas16(GFXcanvas16 &&canvas)
+    : Adafruit_GFX(canvas), buffer(canvas.buffer), dirty(canvas.dirty),
+      dirtyStride(canvas.dirtyStride), frame(canvas.frame),
+      frameValid(canvas.frameValid), owned(canvas.owned) {
+  canvas.buffer = NULL;
+  canvas.dirty = NULL;
+  canvas.frame = NULL;
+  canvas.frameValid = false;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Move a canvas into this one, first freeing this one's dirty
+             tiles, kept frame and (if it owns it) buffer
+   @param    canvas  Canvas to move from, left with no buffer
+   @return   This canvas
+*/
+/**************************************************************************/
+GFXcanvas16 &GFXcanvas16::operator=(GFXcanvas16 &&canvas) {
+  if (this != &canvas) {
+    if (buffer && owned)
+      free(buffer);
+    if (dirty)
+      free(dirty);
+    if (frame)
+      free(frame);
+    Adafruit_GFX::operator=(canvas);
+    buffer = canvas.buffer;
+    dirty = canvas.dirty;
+    dirtyStride = canvas.dirtyStride;
+    frame = canvas.frame;
+    frameValid = canvas.frameValid;
+    owned = canvas.owned;
+    canvas.buffer = NULL;
+    canvas.dirty = NULL;
+    canvas.frame = NULL;
+    canvas.frameValid = false;
+  }
+  return *this;
+}
+
+/**************************************************************************/
+/*!
+   @brief  Keep a copy of the last frame sent by flushDiff(), so it can
+           send only what differs from it. Unlike trackDirty(), this needs
+           nothing from the drawing code, so it suits code that redraws
+           everything each frame, but it doubles the canvas' RAM. The
+           first flushDiff() after turning it on sends the whole canvas.
+   @param  enable  true to keep frames, false to free the copy
+   @return true on success, false if the copy could not be allocated
+*/
+/**************************************************************************/
+bool GFXcanvas16::keepFrame(bool enable) {
+  frameValid = false;
+  if (!enable) {
+    free(frame);
+    frame = NULL;
+    return true;
+  }
+  if (!frame)
+    frame = (uint16_t *)malloc((uint32_t)WIDTH * HEIGHT * 2);
+  return frame != NULL;
+}
+
+/**************************************************************************/
+/*!
+   @brief  Turn dirty-tile tracking on or off. While on, every drawing call
+           marks the 16x16 pixel tiles it touches (GFX_DIRTY_TILE_SHIFT
+           sets the size), so flushDirty() can send a display just the
+           parts that changed. Turning it on marks the whole canvas dirty,
+           as the display's contents are unknown. Writes made directly
+           through getBuffer() must be reported with markDirty().
+   @param  enable  true to track, false to stop and free the tile map
+   @return true on success, false if the tile map could not be allocated
+*/
+/**************************************************************************/
+bool GFXcanvas16::trackDirty(bool enable) {
+  if (!enable) {
+    free(dirty);
+    dirty = NULL;
+    return true;
+  }
+  if (!dirty) {
+    dirtyStride = (dirtyTiles(WIDTH) + 7) / 8;
+    dirty = (uint8_t *)malloc((uint32_t)dirtyTiles(HEIGHT) * dirtyStride);
+    if (!dirty)
+      return false;
+  }
+  markRawDirty(0, 0, WIDTH, HEIGHT);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief  Mark a rectangle as changed, for drawing done straight into
+           getBuffer(). Not limited by the clip rect. Does nothing unless
+           trackDirty() is on.
+   @param  x  Top left corner x coordinate
+   @param  y  Top left corner y coordinate
+   @param  w  Width in pixels
+   @param  h  Height in pixels
+*/
+/**************************************************************************/
+void GFXcanvas16::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int32_t x0 = max((int32_t)x, (int32_t)0), y0 = max((int32_t)y, (int32_t)0);
+  int32_t x1 = min((int32_t)x + w, (int32_t)_width);
+  int32_t y1 = min((int32_t)y + h, (int32_t)_height);
+  if (!dirty || (x1 <= x0) || (y1 <= y0))
+    return;
+  switch (rotation) {
+  case 0:
+    markRawDirty(x0, y0, x1 - x0, y1 - y0);
+    break;
+  case 1:
+    markRawDirty(WIDTH - y1, x0, y1 - y0, x1 - x0);
+    break;
+  case 2:
+    markRawDirty(WIDTH - x1, HEIGHT - y1, x1 - x0, y1 - y0);
+    break;
+  case 3:
+    markRawDirty(y0, HEIGHT - x1, y1 - y0, x1 - x0);
+    break;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Mark the tiles under a rectangle in raw (rotation 0)
+           coordinates as changed. No clipping; does nothing unless
+           trackDirty() is on.
+   @param  x  Top left corner x coordinate, 0 to WIDTH-1
+   @param  y  Top left corner y coordinate, 0 to HEIGHT-1
+   @param  w  Width in pixels, at least 1
+   @param  h  Height in pixels, at least 1
+*/
+/**************************************************************************/
+void GFXcanvas16::markRawDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (!dirty)
+    return;
+  int16_t tx0 = x >> GFX_DIRTY_TILE_SHIFT,
+          tx1 = (x + w - 1) >> GFX_DIRTY_TILE_SHIFT,
+          ty1 = (y + h - 1) >> GFX_DIRTY_TILE_SHIFT;
+  for (int16_t ty = y >> GFX_DIRTY_TILE_SHIFT; ty <= ty1; ty++) {
+    uint8_t *row = &dirty[ty * dirtyStride];
+    for (int16_t tx = tx0; tx <= tx1; tx++)
+      row[tx / 8] |= 0x80 >> (tx & 7);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Forget all changes, e.g. after pushing the canvas by some other
+           means than flushDirty()
+*/
+/**************************************************************************/
+void GFXcanvas16::clearDirty(void) {
+  if (dirty)
+    memset(dirty, 0, (uint32_t)dirtyTiles(HEIGHT) * dirtyStride);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Take the next changed area off the dirty tile map: a run of
+           dirty tiles along a tile row, extended down over following rows
+           with the same run dirty. Those tiles are then marked clean.
+   @param  x  Returns left edge, raw (rotation 0) coordinates
+   @param  y  Returns top edge, raw (rotation 0) coordinates
+   @param  w  Returns width in pixels, clipped to the canvas
+   @param  h  Returns height in pixels, clipped to the canvas
+   @return true if an area was returned, false if nothing is dirty (or
+           tracking is off)
+*/
+/**************************************************************************/
+bool GFXcanvas16::nextDirtyRect(int16_t *x, int16_t *y, int16_t *w,
+                                int16_t *h) {
+  const uint8_t S = GFX_DIRTY_TILE_SHIFT;
+  int16_t cols = dirtyTiles(WIDTH), rows = dirtyTiles(HEIGHT);
+  if (!dirty)
+    return false;
+  for (int16_t ty = 0; ty < rows; ty++) {
+    uint8_t *row = &dirty[ty * dirtyStride];
+    for (int16_t tx = 0; tx < cols; tx++) {
+      if (!(row[tx / 8] & (0x80 >> (tx & 7))))
+        continue;
+      int16_t tx1 = tx + 1, ty1 = ty + 1, t;
+      while ((tx1 < cols) && (row[tx1 / 8] & (0x80 >> (tx1 & 7))))
+        tx1++;
+      for (; ty1 < rows; ty1++) { // Grow down while the whole run is dirty
+        uint8_t *next = &dirty[ty1 * dirtyStride];
+        for (t = tx; (t < tx1) && (next[t / 8] & (0x80 >> (t & 7))); t++)
+          ;
+        if (t < tx1)
+          break;
+      }
+      for (int16_t j = ty; j < ty1; j++) {
+        for (t = tx; t < tx1; t++)
+          dirty[j * dirtyStride + t / 8] &= ~(0x80 >> (t & 7));
+      }
+      *x = tx << S;
+      *y = ty << S;
+      *w = min((int32_t)tx1 << S, (int32_t)WIDTH) - *x;
+      *h = min((int32_t)ty1 << S, (int32_t)HEIGHT) - *y;
+      return true;
+    }
+  }
+  return false;
 }
 
 /**************************************************************************/
@@ -2411,7 +4296,7 @@ GFXcanvas16::~GFXcanvas16(void) {
 /**************************************************************************/
 void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if (isClipped(x, y))
       return;
 
     int16_t t;
@@ -2432,7 +4317,7 @@ void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
       break;
     }
 
-    buffer[x + y * WIDTH] = color;
+    drawRawPixel(x, y, color);
   }
 }
 
@@ -2486,23 +4371,146 @@ uint16_t GFXcanvas16::getRawPixel(int16_t x, int16_t y) const {
 
 /**************************************************************************/
 /*!
-    @brief  Fill the framebuffer completely with one color
+    @brief  Fill the framebuffer completely with one color (or just the
+            clip rect, if one is pushed)
     @param  color 16-bit 5-6-5 Color to fill with
 */
 /**************************************************************************/
 void GFXcanvas16::fillScreen(uint16_t color) {
+  if (clipDepth) { // Only the clip rect
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
   if (buffer) {
     uint8_t hi = color >> 8, lo = color & 0xFF;
     if (hi == lo) {
       memset(buffer, lo, WIDTH * HEIGHT * 2);
     } else {
-      uint32_t i, pixels = WIDTH * HEIGHT;
-      for (i = 0; i < pixels; i++)
-        buffer[i] = color;
+      fill16(buffer, (uint32_t)WIDTH * HEIGHT, color);
     }
+    markRawDirty(0, 0, WIDTH, HEIGHT);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle straight into the buffer, a row at a time in
+           buffer order whatever the rotation. Negative w or h extend left
+           or up, as on Adafruit_SPITFT.
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                           uint16_t color) {
+  if (!buffer || !clipRawRect(&x, &y, &w, &h))
+    return;
+  markRawDirty(x, y, w, h);
+  uint16_t *ptr = &buffer[(uint32_t)y * WIDTH + x];
+  uint8_t hi = color >> 8, lo = color & 0xFF;
+  if (w == WIDTH) { // Whole rows, one block
+    if (hi == lo)
+      memset(ptr, lo, (uint32_t)w * h * 2);
+    else
+      fill16(ptr, (uint32_t)w * h, color);
+    return;
+  }
+  for (; h--; ptr += WIDTH) {
+    if (hi == lo)
+      memset(ptr, lo, w * 2);
+    else
+      fill16(ptr, w, color);
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief  Fill a rectangle, same as fillRect() on a canvas
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                uint16_t color) {
+  GFXcanvas16::fillRect(x, y, w, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move everything on the canvas by (dx,dy), as when scrolling a
+           log or a chart, filling the area it leaves with a color. Only
+           the clip rect moves, if one is set.
+   @param  dx     Pixels to move right (negative: left)
+   @param  dy     Pixels to move down (negative: up)
+   @param  color  16-bit 5-6-5 color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::scroll(int16_t dx, int16_t dy, uint16_t color) {
+  GFXcanvas16::scroll(dx, dy, 0, 0, _width, _height, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief  Move the contents of a rectangle by (dx,dy) with a memory move,
+           instead of redrawing them, filling the part they leave with a
+           color. Pixels moved out of the rectangle are lost and none
+           move in, so after scrolling a text or chart area only the new
+           line or column has to be drawn.
+   @param  dx     Pixels to move right (negative: left)
+   @param  dy     Pixels to move down (negative: up)
+   @param  x      Top left corner x coordinate
+   @param  y      Top left corner y coordinate
+   @param  w      Width in pixels
+   @param  h      Height in pixels
+   @param  color  16-bit 5-6-5 color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::scroll(int16_t dx, int16_t dy, int16_t x, int16_t y,
+                         int16_t w, int16_t h, uint16_t color) {
+  if ((!dx && !dy) || !buffer || !clipRawScroll(&x, &y, &w, &h, &dx, &dy))
+    return;
+  markRawDirty(x, y, w, h);
+  scrollRaw<uint16_t>(buffer, WIDTH, x, y, w, h, dx, dy, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief   Copy a drawRGBBitmap() image straight into the canvas buffer,
+            in any rotation
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    bitmap  array with 16-bit color bitmap
+    @param    pgm     True if bitmap is PROGMEM-resident
+    @param    format  Only GFX_IMAGE_RGB565 is handled here
+    @param    w       Width of bitmap in pixels
+    @param    h       Height of bitmap in pixels
+    @param    color   Unused
+    @param    bg      Unused
+    @returns  True if the image was drawn
+*/
+/**************************************************************************/
+bool GFXcanvas16::drawImageFast(int16_t x, int16_t y, const void *bitmap,
+                                bool pgm, uint8_t format, int16_t w, int16_t h,
+                                uint16_t color, uint16_t bg) {
+  (void)color;
+  (void)bg;
+  if (format != GFX_IMAGE_RGB565)
+    return false;
+  int16_t i0, j0, i1, j1;
+  if (!buffer || !clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+    return true;
+  blitRaw(buffer, WIDTH, HEIGHT, rotation, (const uint16_t *)bitmap, pgm, x,
+          y, w, i0, j0, i1, j1);
+  markDirty(x + i0, y + j0, i1 - i0, j1 - j0);
+  return true;
+}
+
 /**************************************************************************/
 /*!
     @brief  Reverses the "endian-ness" of each 16-bit pixel within the
@@ -2518,9 +4526,8 @@ void GFXcanvas16::fillScreen(uint16_t color) {
 /**************************************************************************/
 void GFXcanvas16::byteSwap(void) {
   if (buffer) {
-    uint32_t i, pixels = WIDTH * HEIGHT;
-    for (i = 0; i < pixels; i++)
-      buffer[i] = __builtin_bswap16(buffer[i]);
+    swap16(buffer, (uint32_t)WIDTH * HEIGHT);
+    markRawDirty(0, 0, WIDTH, HEIGHT);
   }
 }
 
@@ -2544,17 +4551,19 @@ void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or outside clip rect)
+  int16_t cy0 = clipY0(), cy1 = clipY1();
+  if ((x < clipX0()) || (x >= clipX1()) || (y >= cy1) ||
+      ((y + h - 1) < cy0)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < cy0) { // Clip top
+    h -= cy0 - y;
+    y = cy0;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > cy1) { // Clip bottom
+    h = cy1 - y;
   }
 
   if (getRotation() == 0) {
@@ -2599,17 +4608,19 @@ void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or outside clip rect)
+  int16_t cx0 = clipX0(), cx1 = clipX1();
+  if ((y < clipY0()) || (y >= clipY1()) || (x >= cx1) ||
+      ((x + w - 1) < cx0)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < cx0) { // Clip left
+    w -= cx0 - x;
+    x = cx0;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w >= cx1) { // Clip right
+    w = cx1 - x;
   }
 
   if (getRotation() == 0) {
@@ -2634,6 +4645,36 @@ void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Draw a batch of horizontal spans from the filled primitives.
+   Each span is clipped here and, when the canvas is not rotated, goes
+   straight to drawFastRawHLine().
+   @param    spans   Array of spans, each with a positive width
+   @param    count   Number of spans in the array
+   @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::writeSpans(const GFXspan *spans, uint16_t count,
+                             uint16_t color) {
+  if (getRotation()) {
+    for (; count--; spans++)
+      GFXcanvas16::drawFastHLine(spans->x, spans->y, spans->w, color);
+    return;
+  }
+  int16_t cx0 = clipX0(), cy0 = clipY0(), cx1 = clipX1(), cy1 = clipY1();
+  for (; count--; spans++) {
+    int16_t x = spans->x, y = spans->y, x2 = x + spans->w - 1;
+    if ((y < cy0) || (y >= cy1) || (x >= cx1) || (x2 < cx0))
+      continue;
+    if (x < cx0) // Clip left
+      x = cx0;
+    if (x2 >= cx1) // Clip right
+      x2 = cx1 - 1;
+    drawFastRawHLine(x, y, x2 - x + 1, color);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Speed optimized vertical line drawing into the raw canvas buffer
@@ -2647,6 +4688,7 @@ void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
                                    uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
   uint16_t *buffer_ptr = buffer + y * WIDTH + x;
+  markRawDirty(x, y, 1, h);
   for (int16_t i = 0; i < h; i++) {
     (*buffer_ptr) = color;
     buffer_ptr += WIDTH;
@@ -2665,8 +4707,99 @@ void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
 void GFXcanvas16::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
                                    uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  uint32_t buffer_index = y * WIDTH + x;
-  for (uint32_t i = buffer_index; i < buffer_index + w; i++) {
-    buffer[i] = color;
+  fill16(&buffer[(uint32_t)y * WIDTH + x], w, color);
+  markRawDirty(x, y, w, 1);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instantiate a pool, allocating all its blocks at once
+   @param    blockSize  Bytes per block, e.g. w * h * 2 for a GFXcanvas16
+   @param    count      Number of blocks, at most 32. The pool is empty
+                        (capacity() 0) if they could not be allocated.
+*/
+/**************************************************************************/
+GFXbufferPool::GFXbufferPool(uint32_t blockSize, uint8_t count)
+    : size((blockSize + 3) & ~(uint32_t)3), used(0),
+      count(count > 32 ? 32 : count), owned(true) {
+  if (!(arena = (uint8_t *)malloc(size * this->count)))
+    this->count = 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instantiate a pool carved out of caller-supplied memory, such
+             as a static array or an external RAM region. It is not freed
+             when the pool is deleted.
+   @param    arena      Start of the memory, aligned for the buffers' type
+   @param    arenaSize  Bytes of memory at arena
+   @param    blockSize  Bytes per block. As many blocks as fit (at most
+                        32) are made.
+*/
+/**************************************************************************/
+GFXbufferPool::GFXbufferPool(void *arena, uint32_t arenaSize,
+                             uint32_t blockSize)
+    : arena((uint8_t *)arena), size((blockSize + 3) & ~(uint32_t)3),
+      used(0), count(0), owned(false) {
+  if (arena && size)
+    count = (arenaSize / size > 32) ? 32 : arenaSize / size;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the pool, freeing its memory if it allocated it. Any
+             block still handed out becomes invalid.
+*/
+/**************************************************************************/
+GFXbufferPool::~GFXbufferPool(void) {
+  if (arena && owned)
+    free(arena);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Take a block from the pool. Its contents are whatever the
+             last user left there.
+   @return   Pointer to blockSize() bytes, NULL if all blocks are in use
+*/
+/**************************************************************************/
+void *GFXbufferPool::alloc(void) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (!(used & ((uint32_t)1 << i))) {
+      used |= (uint32_t)1 << i;
+      return arena + i * size;
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Give a block back to the pool. Pointers that are NULL or not
+             a block of this pool are ignored.
+   @param    block  Pointer returned by alloc()
+*/
+/**************************************************************************/
+void GFXbufferPool::release(void *block) {
+  uint8_t *p = (uint8_t *)block;
+  if (p < arena || p >= arena + count * size)
+    return;
+  uint32_t offset = p - arena;
+  if (offset % size == 0)
+    used &= ~((uint32_t)1 << (offset / size));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Get the number of blocks not handed out
+   @return   Blocks alloc() can still return
+*/
+/**************************************************************************/
+uint8_t GFXbufferPool::available(void) const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (!(used & ((uint32_t)1 << i)))
+      n++;
   }
+  return n;
 }
@@ -12,6 +12,100 @@
 #include <Adafruit_I2CDevice.h>
 #include <Adafruit_SPIDevice.h>
 
+// Filled primitives collect this many spans on the stack before passing
+// them to writeSpans(). Can be overridden at compile time.
+#if !defined(GFX_SPAN_BATCH)
+#if defined(__AVR__)
+#define GFX_SPAN_BATCH 8 ///< Spans per writeSpans() batch (small: AVR stack)
+#else
+#define GFX_SPAN_BATCH 32 ///< Spans per writeSpans() batch
+#endif
+#endif
+
+// Number of clip rects pushClipRect() can nest, at most 32. Each level
+// costs 8 bytes per display object.
+#if !defined(GFX_CLIP_DEPTH)
+#if defined(__AVR__)
+#define GFX_CLIP_DEPTH 2 ///< Clip stack depth (small: AVR RAM)
+#else
+#define GFX_CLIP_DEPTH 4 ///< Clip stack depth
+#endif
+#endif
+
+// Codepoints setFontChain() remembers the font and glyph of, in a
+// direct-mapped cache. Each entry costs 12 bytes (7 on AVR) per display
+// object, chain or not; 0 turns the cache off.
+#if !defined(GFX_GLYPH_CACHE_SIZE)
+#if defined(__AVR__)
+#define GFX_GLYPH_CACHE_SIZE 0 ///< No glyph cache (AVR RAM)
+#else
+#define GFX_GLYPH_CACHE_SIZE 8 ///< Glyph cache entries
+#endif
+#endif
+
+// GFXcanvas16 dirty tracking: tiles are 1 << GFX_DIRTY_TILE_SHIFT pixels
+// square, one bit each.
+#if !defined(GFX_DIRTY_TILE_SHIFT)
+#define GFX_DIRTY_TILE_SHIFT 4 ///< 16x16 pixel dirty tiles
+#endif
+
+// GFXcanvas16::flushDiff(): unchanged runs shorter than this many pixels
+// are sent anyway, as that's cheaper than setting up another window.
+#if !defined(GFX_DIFF_GAP)
+#define GFX_DIFF_GAP 8 ///< Pixels of unchanged gap merged into a span
+#endif
+
+// fillPolygon() fill rules: even-odd treats a point as inside if a ray from
+// it crosses an odd number of edges, nonzero if the edge winding is nonzero.
+#define GFX_FILL_EVEN_ODD 0 ///< fillPolygon(): even-odd fill rule
+#define GFX_FILL_NONZERO 1  ///< fillPolygon(): nonzero winding fill rule
+
+#define GFX_ROP_COPY 0   ///< GFXcanvas1::bitBlt(): dst = src
+#define GFX_ROP_AND 1    ///< GFXcanvas1::bitBlt(): dst = dst & src
+#define GFX_ROP_OR 2     ///< GFXcanvas1::bitBlt(): dst = dst | src
+#define GFX_ROP_XOR 3    ///< GFXcanvas1::bitBlt(): dst = dst ^ src
+#define GFX_ROP_ANDNOT 4 ///< GFXcanvas1::bitBlt(): dst = dst & ~src
+
+// Image formats passed to drawImageFast() by the bitmap functions
+#define GFX_IMAGE_1BIT 0    ///< drawBitmap(), unset bits transparent
+#define GFX_IMAGE_1BIT_BG 1 ///< drawBitmap(), unset bits in bg
+#define GFX_IMAGE_GRAY8 2   ///< drawGrayscaleBitmap(), unmasked
+#define GFX_IMAGE_RGB565 3  ///< drawRGBBitmap(), unmasked
+
+/// A clip rectangle: x0,y0 is the top-left pixel, x1,y1 is just past the
+/// bottom-right one
+typedef struct {
+  int16_t x0; ///< Left-most column inside
+  int16_t y0; ///< Top-most row inside
+  int16_t x1; ///< First column past the right edge
+  int16_t y1; ///< First row past the bottom edge
+} GFXcliprect;
+
+/// A font chain lookup remembered by setFontChain()'s glyph cache
+typedef struct {
+  uint32_t code;   ///< Codepoint, 0xFFFFFFFF if the entry is unused
+  GFXglyph *glyph; ///< Its glyph, NULL if no font in the chain has one
+  uint8_t font;    ///< Index in the chain of the font the glyph is in
+} GFXglyphcache;
+
+/// A horizontal run of pixels on one scanline, as passed to writeSpans()
+typedef struct {
+  int16_t x; ///< Left-most x coordinate
+  int16_t y; ///< Scanline y coordinate
+  int16_t w; ///< Width in pixels (positive)
+} GFXspan;
+
+/// One visible glyph of a line of text, as laid out by textLineGlyphs()
+typedef struct {
+  const uint8_t *bitmap; ///< Glyph bitmap (classic font: its 5 columns)
+  int16_t x;             ///< Left edge
+  int16_t y;             ///< Top edge
+  uint8_t width;         ///< Bitmap width in pixels, before scaling
+  uint8_t height;        ///< Bitmap height in pixels, before scaling
+} GFXtextglyph;
+
+class Adafruit_SPITFT;
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a
 /// minimum you can subclass and provide drawPixel(). At a maximum you can do a
 /// ton of overriding to optimize. Used for any/all Adafruit displays!
@@ -42,6 +136,8 @@ public:
   virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                          uint16_t color);
+  virtual void writeSpans(const GFXspan *spans, uint16_t count,
+                          uint16_t color);
   virtual void endWrite(void);
 
   // CONTROL API
@@ -77,6 +173,9 @@ public:
                     int16_t y2, uint16_t color);
   void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
                     int16_t y2, uint16_t color);
+  void drawPolygon(const int16_t *xy, uint16_t n, uint16_t color);
+  void fillPolygon(const int16_t *xy, uint16_t n, uint16_t color,
+                   uint8_t rule = GFX_FILL_EVEN_ODD);
   void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
                      int16_t radius, uint16_t color);
   void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
@@ -111,6 +210,9 @@ public:
                 uint16_t bg, uint8_t size);
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
                 uint16_t bg, uint8_t size_x, uint8_t size_y);
+  void drawCodepoint(int16_t x, int16_t y, uint32_t c, uint16_t color,
+                     uint16_t bg, uint8_t size_x, uint8_t size_y);
+  size_t writeCodepoint(uint32_t c);
   void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1,
                      int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y,
@@ -120,6 +222,10 @@ public:
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setFont(const GFXfont *f = NULL);
+  void setFontChain(const GFXfont *const *fonts, uint8_t n);
+  bool pushClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void popClipRect(void);
+  void getClipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
 
   /**********************************************************************/
   /*!
@@ -180,6 +286,26 @@ public:
   /**********************************************************************/
   void cp437(bool x = true) { _cp437 = x; }
 
+  /**********************************************************************/
+  /*!
+    @brief  Enable (or disable) UTF-8 text. print() and write() then
+            decode multi-byte sequences, a byte at a time, and draw each
+            whole codepoint with writeCodepoint(), so strings of Greek,
+            Cyrillic or emoji print as they are written in the source.
+            Malformed sequences (overlong, surrogates, past U+10FFFF, cut
+            short) print nothing.
+            getTextBounds() measures them the same way. Always on while the
+            font has glyphs past 0xFF, which single bytes can't reach. Off
+            by default, so bytes 0x80-0xFF still select the classic font's
+            CP437 symbols or an 8-bit font's glyphs.
+    @param  x  true = decode UTF-8, false = one byte per character
+  */
+  /**********************************************************************/
+  void utf8(bool x = true) {
+    _utf8 = x;
+    utf8Left = 0;
+  }
+
   using Print::write;
 #if ARDUINO >= 100
   virtual size_t write(uint8_t);
@@ -229,9 +355,112 @@ public:
   /************************************************************************/
   int16_t getCursorY(void) const { return cursor_y; };
 
+  /************************************************************************/
+  /*!
+    @brief      Get the custom font text is drawn with
+    @returns    The setFont() font, or the first of a setFontChain()
+                chain; NULL for the classic font
+  */
+  /************************************************************************/
+  const GFXfont *getFont(void) const { return gfxFont; }
+
+  /************************************************************************/
+  /*!
+    @brief      Get the font chain set by setFontChain()
+    @param      n  Set to the number of fonts in the chain
+    @returns    The chain, NULL if there is none (setFont() is in use)
+  */
+  /************************************************************************/
+  const GFXfont *const *getFontChain(uint8_t *n) const {
+    *n = fontChainLength;
+    return fontChain;
+  }
+
 protected:
-  void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
+  virtual bool drawImageFast(int16_t x, int16_t y, const void *bitmap,
+                             bool pgm, uint8_t format, int16_t w, int16_t h,
+                             uint16_t color, uint16_t bg);
+  void charBounds(uint32_t c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
+  void textLineBounds(const char *str, int16_t x, int16_t y, int16_t *x1,
+                      int16_t *y1, uint16_t *w, uint16_t *h);
+  uint8_t textLineGlyphs(const char **str, int16_t *x, int16_t y,
+                         GFXtextglyph *glyphs, uint8_t max);
+  void textLineRow(const GFXtextglyph *glyphs, uint8_t count, int16_t row,
+                   int16_t x0, uint16_t *buf, int16_t n);
+  bool decodeUTF8(uint8_t c, uint32_t *code);
+  bool utf8Text(void) const;
+  GFXglyph *findGlyph(uint32_t c, const GFXfont **font = NULL);
+  void drawGlyph(int16_t x, int16_t y, GFXglyph *glyph, const GFXfont *font,
+                 uint16_t color, uint8_t size_x, uint8_t size_y);
+  bool clipImage(int16_t x, int16_t y, int16_t w, int16_t h, int16_t *i0,
+                 int16_t *j0, int16_t *i1, int16_t *j1) const;
+  bool clipRawRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  bool clipRawScroll(int16_t *x, int16_t *y, int16_t *w, int16_t *h,
+                     int16_t *dx, int16_t *dy) const;
+
+  /************************************************************************/
+  /*!
+    @brief    Left edge of the area that may be drawn: the clip rect if one
+              is pushed, else the screen.
+    @returns  Left-most x coordinate inside
+  */
+  /************************************************************************/
+  int16_t clipX0(void) const { return clipDepth ? clip.x0 : 0; }
+
+  /************************************************************************/
+  /*!
+    @brief    Top edge of the area that may be drawn
+    @returns  Top-most y coordinate inside
+  */
+  /************************************************************************/
+  int16_t clipY0(void) const { return clipDepth ? clip.y0 : 0; }
+
+  /************************************************************************/
+  /*!
+    @brief    Right edge of the area that may be drawn
+    @returns  First x coordinate past the right edge
+  */
+  /************************************************************************/
+  int16_t clipX1(void) const { return clipDepth ? clip.x1 : _width; }
+
+  /************************************************************************/
+  /*!
+    @brief    Bottom edge of the area that may be drawn
+    @returns  First y coordinate past the bottom edge
+  */
+  /************************************************************************/
+  int16_t clipY1(void) const { return clipDepth ? clip.y1 : _height; }
+
+  /************************************************************************/
+  /*!
+    @brief    Check one pixel against the screen and clip rect
+    @param    x  X coordinate in pixels
+    @param    y  Y coordinate in pixels
+    @returns  true if the pixel must not be drawn
+  */
+  /************************************************************************/
+  bool isClipped(int16_t x, int16_t y) const {
+    return (x < clipX0()) || (y < clipY0()) || (x >= clipX1()) ||
+           (y >= clipY1());
+  }
+
+  /************************************************************************/
+  /*!
+    @brief    Check a bounding box against the screen and clip rect, to skip
+              shapes that are entirely out of sight
+    @param    x0  Left-most x coordinate of the box
+    @param    y0  Top-most y coordinate of the box
+    @param    x1  Right-most x coordinate of the box (inclusive)
+    @param    y1  Bottom-most y coordinate of the box (inclusive)
+    @returns  true if none of the box can be seen
+  */
+  /************************************************************************/
+  bool isClipped(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const {
+    return (x1 < clipX0()) || (y1 < clipY0()) || (x0 >= clipX1()) ||
+           (y0 >= clipY1());
+  }
+
   int16_t WIDTH;        ///< This is the 'raw' display width - never changes
   int16_t HEIGHT;       ///< This is the 'raw' display height - never changes
   int16_t _width;       ///< Display width as modified by current rotation
@@ -245,7 +474,18 @@ protected:
   uint8_t rotation;     ///< Display rotation (0 thru 3)
   bool wrap;            ///< If set, 'wrap' text at right edge of display
   bool _cp437;          ///< If set, use correct CP437 charset (default is off)
+  bool _utf8;           ///< If set, text is UTF-8 (default is off)
+  uint8_t utf8Left;     ///< Continuation bytes write() still expects
+  uint32_t utf8Code;    ///< Codepoint write() is decoding
   GFXfont *gfxFont;     ///< Pointer to special font
+  const GFXfont *const *fontChain; ///< Fallback fonts, NULL for gfxFont only
+  uint8_t fontChainLength;         ///< Number of fonts in fontChain
+#if GFX_GLYPH_CACHE_SIZE > 0
+  GFXglyphcache glyphCache[GFX_GLYPH_CACHE_SIZE]; ///< fontChain lookups
+#endif
+  GFXcliprect clip;     ///< Current clip rect, valid if clipDepth > 0
+  GFXcliprect clipStack[GFX_CLIP_DEPTH]; ///< Clip rects saved by push
+  uint8_t clipDepth;                     ///< Number of clip rects pushed
 };
 
 /// A simple drawn button UI element
@@ -310,11 +550,25 @@ private:
 class GFXcanvas1 : public Adafruit_GFX {
 public:
   GFXcanvas1(uint16_t w, uint16_t h);
+  GFXcanvas1(uint16_t w, uint16_t h, uint8_t *buffer);
+  GFXcanvas1(GFXcanvas1 &&canvas);
   ~GFXcanvas1(void);
+  GFXcanvas1 &operator=(GFXcanvas1 &&canvas);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void scroll(int16_t dx, int16_t dy, uint16_t color = 0);
+  void scroll(int16_t dx, int16_t dy, int16_t x, int16_t y, int16_t w,
+              int16_t h, uint16_t color = 0);
+  void bitBlt(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+              int16_t h, uint8_t rop = GFX_ROP_COPY);
+  void bitBlt(int16_t x, int16_t y, const GFXcanvas1 &src, int16_t sx,
+              int16_t sy, int16_t w, int16_t h, uint8_t rop = GFX_ROP_COPY);
   bool getPixel(int16_t x, int16_t y) const;
   /**********************************************************************/
   /*!
@@ -326,11 +580,43 @@ public:
 
 protected:
   bool getRawPixel(int16_t x, int16_t y) const;
+  /**********************************************************************/
+  /*!
+    @brief  Set one pixel in raw (rotation 0) coordinates. No clipping or
+            buffer check; inline so GFXRenderer loops become buffer stores.
+    @param  x      Raw x coordinate, 0 to WIDTH-1
+    @param  y      Raw y coordinate, 0 to HEIGHT-1
+    @param  color  Binary (on or off) color to fill with
+  */
+  /**********************************************************************/
+  void drawRawPixel(int16_t x, int16_t y, uint16_t color) {
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+#ifdef __AVR__
+    if (color)
+      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
+    else
+      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
+#else
+    if (color)
+      *ptr |= 0x80 >> (x & 7);
+    else
+      *ptr &= ~(0x80 >> (x & 7));
+#endif
+  }
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  bool drawImageFast(int16_t x, int16_t y, const void *bitmap, bool pgm,
+                     uint8_t format, int16_t w, int16_t h, uint16_t color,
+                     uint16_t bg);
 
 private:
+  void blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap, bool pgm,
+                  int16_t w, int16_t h, uint8_t rop);
+  void drawBitmapBg(int16_t x, int16_t y, const uint8_t *bitmap, bool pgm,
+                    int16_t w, int16_t h, uint16_t color, uint16_t bg);
+
   uint8_t *buffer;
+  bool owned; ///< buffer was allocated here and is freed on destruction
 
 #ifdef __AVR__
   // Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
@@ -342,11 +628,21 @@ private:
 class GFXcanvas8 : public Adafruit_GFX {
 public:
   GFXcanvas8(uint16_t w, uint16_t h);
+  GFXcanvas8(uint16_t w, uint16_t h, uint8_t *buffer);
+  GFXcanvas8(GFXcanvas8 &&canvas);
   ~GFXcanvas8(void);
+  GFXcanvas8 &operator=(GFXcanvas8 &&canvas);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void scroll(int16_t dx, int16_t dy, uint16_t color = 0);
+  void scroll(int16_t dx, int16_t dy, int16_t x, int16_t y, int16_t w,
+              int16_t h, uint16_t color = 0);
   uint8_t getPixel(int16_t x, int16_t y) const;
   /**********************************************************************/
   /*!
@@ -358,23 +654,49 @@ public:
 
 protected:
   uint8_t getRawPixel(int16_t x, int16_t y) const;
+  /**********************************************************************/
+  /*!
+    @brief  Set one pixel in raw (rotation 0) coordinates. No clipping or
+            buffer check; inline so GFXRenderer loops become buffer stores.
+    @param  x      Raw x coordinate, 0 to WIDTH-1
+    @param  y      Raw y coordinate, 0 to HEIGHT-1
+    @param  color  8-bit color to fill with
+  */
+  /**********************************************************************/
+  void drawRawPixel(int16_t x, int16_t y, uint16_t color) {
+    buffer[x + y * WIDTH] = color;
+  }
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  bool drawImageFast(int16_t x, int16_t y, const void *bitmap, bool pgm,
+                     uint8_t format, int16_t w, int16_t h, uint16_t color,
+                     uint16_t bg);
 
 private:
   uint8_t *buffer;
+  bool owned; ///< buffer was allocated here and is freed on destruction
 };
 
 ///  A GFX 16-bit canvas context for graphics
 class GFXcanvas16 : public Adafruit_GFX {
 public:
   GFXcanvas16(uint16_t w, uint16_t h);
+  GFXcanvas16(uint16_t w, uint16_t h, uint16_t *buffer);
+  GFXcanvas16(GFXcanvas16 &&canvas);
   ~GFXcanvas16(void);
+  GFXcanvas16 &operator=(GFXcanvas16 &&canvas);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   void fillScreen(uint16_t color);
   void byteSwap(void);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void scroll(int16_t dx, int16_t dy, uint16_t color = 0);
+  void scroll(int16_t dx, int16_t dy, int16_t x, int16_t y, int16_t w,
+              int16_t h, uint16_t color = 0);
   uint16_t getPixel(int16_t x, int16_t y) const;
   /**********************************************************************/
   /*!
@@ -383,14 +705,293 @@ public:
   */
   /**********************************************************************/
   uint16_t *getBuffer(void) const { return buffer; }
+  bool trackDirty(bool enable);
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  void clearDirty(void);
+  bool nextDirtyRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+  void flushDirty(Adafruit_SPITFT &tft, int16_t x = 0, int16_t y = 0);
+  bool keepFrame(bool enable);
+  void flushDiff(Adafruit_SPITFT &tft, int16_t x = 0, int16_t y = 0,
+                 uint8_t gap = GFX_DIFF_GAP);
 
 protected:
   uint16_t getRawPixel(int16_t x, int16_t y) const;
+  /**********************************************************************/
+  /*!
+    @brief  Set one pixel in raw (rotation 0) coordinates, marking its
+            tile if trackDirty() is on. No clipping or buffer check; inline
+            so GFXRenderer loops become buffer stores.
+    @param  x      Raw x coordinate, 0 to WIDTH-1
+    @param  y      Raw y coordinate, 0 to HEIGHT-1
+    @param  color  16-bit 5-6-5 color to fill with
+  */
+  /**********************************************************************/
+  void drawRawPixel(int16_t x, int16_t y, uint16_t color) {
+    buffer[x + y * WIDTH] = color;
+    if (dirty) {
+      x >>= GFX_DIRTY_TILE_SHIFT;
+      y >>= GFX_DIRTY_TILE_SHIFT;
+      dirty[y * dirtyStride + x / 8] |= 0x80 >> (x & 7);
+    }
+  }
   void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void markRawDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  bool drawImageFast(int16_t x, int16_t y, const void *bitmap, bool pgm,
+                     uint8_t format, int16_t w, int16_t h, uint16_t color,
+                     uint16_t bg);
 
 private:
   uint16_t *buffer;
+  uint8_t *dirty;       ///< Dirty tile bits, NULL when not tracking
+  uint16_t dirtyStride; ///< Bytes per row of tiles in dirty
+  uint16_t *frame;      ///< Last frame flushDiff() sent, NULL if not kept
+  bool frameValid;      ///< false until flushDiff() has sent a whole frame
+  bool owned;           ///< buffer was allocated here, freed on destruction
+};
+
+/// A GFX canvas (GFXcanvas1, GFXcanvas8 or GFXcanvas16) with its rotation
+/// fixed at compile time, for sketches that never change it. Pixel and
+/// line calls skip the per-call rotation switch; setRotation() keeps ROT.
+/// Also usable as the Device of a GFXRenderer, which then maps
+/// coordinates with no switch at all.
+template <class Canvas, uint8_t ROT> class GFXcanvasRotated : public Canvas {
+  static_assert(ROT < 4, "rotation must be 0 to 3");
+
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Instantiate a canvas with a fixed rotation
+    @param  w  Width in pixels at rotation 0, as for the Canvas
+    @param  h  Height in pixels at rotation 0, as for the Canvas
+  */
+  /**********************************************************************/
+  GFXcanvasRotated(uint16_t w, uint16_t h) : Canvas(w, h) {
+    Canvas::setRotation(ROT);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Instantiate a canvas with a fixed rotation, drawing into a
+            caller-supplied buffer, as for the Canvas
+    @param  w       Width in pixels at rotation 0, as for the Canvas
+    @param  h       Height in pixels at rotation 0, as for the Canvas
+    @param  buffer  Buffer of the Canvas' size and type, not freed here
+  */
+  /**********************************************************************/
+  template <class T>
+  GFXcanvasRotated(uint16_t w, uint16_t h, T *buffer) : Canvas(w, h, buffer) {
+    Canvas::setRotation(ROT);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Get the rotation, a compile-time constant
+    @returns  ROT
+  */
+  /**********************************************************************/
+  uint8_t getRotation(void) const { return ROT; }
+
+  /**********************************************************************/
+  /*!
+    @brief  Rotation is fixed, so this only resets the clip stack like
+            Adafruit_GFX::setRotation() does
+    @param  r  Ignored
+  */
+  /**********************************************************************/
+  void setRotation(uint8_t r) {
+    (void)r;
+    Canvas::setRotation(ROT);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a pixel, clipped
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (this->getBuffer() && !this->isClipped(x, y)) {
+      toRaw(x, y);
+      this->drawRawPixel(x, y, color);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Get the pixel color value at a given coordinate
+    @param  x  x coordinate
+    @param  y  y coordinate
+    @returns  The pixel's color value, 0 if outside the canvas
+  */
+  /**********************************************************************/
+  auto getPixel(int16_t x, int16_t y) const
+      -> decltype(Canvas::getRawPixel(x, y)) {
+    toRaw(x, y);
+    return this->getRawPixel(x, y);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a horizontal line, clipped
+    @param  x      Left-most x coordinate
+    @param  y      Row y coordinate
+    @param  w      Width in pixels, negative to extend left of x
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (this->getBuffer())
+      hline(x, y, w, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a vertical line, clipped
+    @param  x      Column x coordinate
+    @param  y      Top-most y coordinate
+    @param  h      Height in pixels, negative to extend above y
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    int32_t y0 = y, y1;
+    if (!this->getBuffer() || (x < this->clipX0()) || (x >= this->clipX1()))
+      return;
+    if (h < 0) {
+      y0 += h + 1;
+      h = -h;
+    }
+    y1 = y0 + h;
+    if (y0 < this->clipY0())
+      y0 = this->clipY0();
+    if (y1 > this->clipY1())
+      y1 = this->clipY1();
+    if (y1 <= y0)
+      return;
+    h = y1 - y0;
+    switch (ROT) {
+    case 0:
+      this->drawFastRawVLine(x, y0, h, color);
+      break;
+    case 1:
+      this->drawFastRawHLine(this->WIDTH - y0 - h, x, h, color);
+      break;
+    case 2:
+      this->drawFastRawVLine(this->WIDTH - 1 - x, this->HEIGHT - y0 - h, h,
+                             color);
+      break;
+    default:
+      this->drawFastRawHLine(y0, this->HEIGHT - 1 - x, h, color);
+      break;
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a batch of horizontal spans, clipped
+    @param  spans  Array of spans, each with a positive width
+    @param  count  Number of spans in the array
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color) {
+    if (this->getBuffer())
+      for (; count--; spans++)
+        hline(spans->x, spans->y, spans->w, color);
+  }
+
+private:
+  // Logical to raw (rotation 0) coordinates; the switch folds away
+  void toRaw(int16_t &x, int16_t &y) const {
+    int16_t t = x;
+    switch (ROT) {
+    case 1:
+      x = this->WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = this->WIDTH - 1 - x;
+      y = this->HEIGHT - 1 - y;
+      break;
+    case 3:
+      x = y;
+      y = this->HEIGHT - 1 - t;
+      break;
+    }
+  }
+
+  void hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    int32_t x0 = x, x1;
+    if ((y < this->clipY0()) || (y >= this->clipY1()))
+      return;
+    if (w < 0) {
+      x0 += w + 1;
+      w = -w;
+    }
+    x1 = x0 + w;
+    if (x0 < this->clipX0())
+      x0 = this->clipX0();
+    if (x1 > this->clipX1())
+      x1 = this->clipX1();
+    if (x1 <= x0)
+      return;
+    w = x1 - x0;
+    switch (ROT) {
+    case 0:
+      this->drawFastRawHLine(x0, y, w, color);
+      break;
+    case 1:
+      this->drawFastRawVLine(this->WIDTH - 1 - y, x0, w, color);
+      break;
+    case 2:
+      this->drawFastRawHLine(this->WIDTH - x0 - w, this->HEIGHT - 1 - y, w,
+                             color);
+      break;
+    default:
+      this->drawFastRawVLine(y, this->HEIGHT - x0 - w, w, color);
+      break;
+    }
+  }
+};
+
+/// A fixed number of equal-size blocks, for canvas and display buffers
+/// that come and go: the memory is set aside once, so taking and giving
+/// back buffers cannot fragment the heap or fail halfway through a sketch
+class GFXbufferPool {
+public:
+  GFXbufferPool(uint32_t blockSize, uint8_t count);
+  GFXbufferPool(void *arena, uint32_t arenaSize, uint32_t blockSize);
+  ~GFXbufferPool(void);
+  GFXbufferPool(const GFXbufferPool &) = delete;
+  GFXbufferPool &operator=(const GFXbufferPool &) = delete;
+
+  void *alloc(void);
+  void release(void *block);
+  uint8_t available(void) const;
+  /**********************************************************************/
+  /*!
+    @brief    Get the size of each block
+    @returns  Block size in bytes, rounded up to a multiple of 4
+  */
+  /**********************************************************************/
+  uint32_t blockSize(void) const { return size; }
+  /**********************************************************************/
+  /*!
+    @brief    Get the number of blocks in the pool
+    @returns  Block count, 0 if the pool's memory could not be allocated
+  */
+  /**********************************************************************/
+  uint8_t capacity(void) const { return count; }
+
+private:
+  uint8_t *arena; ///< count blocks of size bytes, back to back
+  uint32_t size;  ///< Bytes per block
+  uint32_t used;  ///< Bit n set while block n is handed out
+  uint8_t count;  ///< Blocks in arena, at most 32
+  bool owned;     ///< arena was allocated here and is freed on destruction
 };
 
 #endif // _ADAFRUIT_GFX_H
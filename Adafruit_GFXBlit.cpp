@@ -0,0 +1,390 @@
+/*!
+ * @file Adafruit_GFXBlit.cpp
+ *
+ * Part of Adafruit's GFX graphics library: gfxBlit(), copying a rectangle
+ * of a GFXcanvas16 onto a canvas, display or other Adafruit_GFX target,
+ * GFXcanvas16::flushDirty()/flushDiff(), sending a display just what
+ * changed, and GFXcanvasIndexed::flush(), sending an indexed canvas
+ * through its palette.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_GFXBlit.h"
+#include "Adafruit_GFXcanvasT.h"
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+// Pixels gathered per call when the source canvas is rotated, so it
+// can't hand out pointers into its buffer. Costs 2 bytes each of stack.
+#if !defined(GFX_BLIT_LINE)
+#if defined(__AVR__)
+#define GFX_BLIT_LINE 16 ///< Source pixels gathered per run on AVR
+#else
+#define GFX_BLIT_LINE 64 ///< Source pixels gathered per run
+#endif
+#endif
+
+/*!
+  @brief  The part of a blit that survives clipping: source rect (sx,sy)
+          w x h, landing at (dx,dy) on the destination
+*/
+struct BlitArea {
+  int16_t sx; ///< Source left edge
+  int16_t sy; ///< Source top edge
+  int16_t dx; ///< Destination left edge
+  int16_t dy; ///< Destination top edge
+  int16_t w;  ///< Width in pixels
+  int16_t h;  ///< Height in pixels
+};
+
+// Clip a source rect (all of src if NULL) to the source canvas and to the
+// destination's clip rect. False if nothing is left to copy.
+static bool blitClip(const Adafruit_GFX &dst, int16_t dx, int16_t dy,
+                     const GFXcanvas16 &src, const GFXrect *srcRect,
+                     BlitArea *a) {
+  int32_t sx = 0, sy = 0, w = src.width(), h = src.height(), x = dx, y = dy, d;
+  int16_t cx, cy, cw, ch;
+  if (!src.getBuffer())
+    return false;
+  if (srcRect) {
+    sx = srcRect->x;
+    sy = srcRect->y;
+    w = srcRect->w;
+    h = srcRect->h;
+  }
+  dst.getClipRect(&cx, &cy, &cw, &ch);
+  // Each edge: the source bound first, then the destination clip rect
+  d = max(max(-sx, (int32_t)cx - x), (int32_t)0);
+  sx += d;
+  x += d;
+  w -= d;
+  d = max(max(-sy, (int32_t)cy - y), (int32_t)0);
+  sy += d;
+  y += d;
+  h -= d;
+  w = min(w, min(src.width() - sx, (int32_t)cx + cw - x));
+  h = min(h, min(src.height() - sy, (int32_t)cy + ch - y));
+  if ((w <= 0) || (h <= 0))
+    return false;
+  a->sx = sx;
+  a->sy = sy;
+  a->dx = x;
+  a->dy = y;
+  a->w = w;
+  a->h = h;
+  return true;
+}
+
+// Hand each run of opaque source pixels in a clipped area to
+// run(x, y, pixels, n), in destination coordinates, top row first. Runs
+// point straight into the source buffer when it is unrotated.
+template <class Run>
+static void blitRuns(const GFXcanvas16 &src, const BlitArea &a,
+                     const GFXblitOptions *options, Run run) {
+  const uint16_t *buf = src.getBuffer();
+  uint16_t line[GFX_BLIT_LINE];
+  bool direct = (src.getRotation() == 0);
+  const uint8_t *mask = options ? options->mask : NULL;
+  bool useKey = options && options->useKey;
+  uint16_t key = useKey ? options->key : 0;
+  int16_t maskBytes = (src.width() + 7) / 8, n;
+
+  for (int16_t j = 0; j < a.h; j++) {
+    int16_t sy = a.sy + j;
+    for (int16_t i = 0; i < a.w; i += n) {
+      int16_t sx = a.sx + i;
+      const uint16_t *px;
+      if (direct) {
+        n = a.w - i;
+        px = &buf[(int32_t)sy * src.width() + sx];
+      } else {
+        n = min(a.w - i, GFX_BLIT_LINE);
+        for (int16_t k = 0; k < n; k++)
+          line[k] = src.getPixel(sx + k, sy);
+        px = line;
+      }
+      if (!mask && !useKey) {
+        run(a.dx + i, a.dy + j, px, n);
+        continue;
+      }
+      const uint8_t *m = mask ? &mask[(int32_t)sy * maskBytes] : NULL;
+      for (int16_t k = 0, k0; k < n;) {
+        for (k0 = k; k < n; k++) { // Extend run while pixels are opaque
+          int16_t b = sx + k;
+          if ((useKey && (px[k] == key)) ||
+              (m && !(m[b >> 3] & (0x80 >> (b & 7)))))
+            break;
+        }
+        if (k > k0)
+          run(a.dx + i + k0, a.dy + j, &px[k0], k - k0);
+        if (k == k0) // Transparent pixel, step past it
+          k++;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Copy a rectangle of a canvas onto any Adafruit_GFX, one
+           writePixel() per opaque pixel
+   @param  dst      Destination, drawn in its current rotation
+   @param  dx       Destination x of the rectangle's top left corner
+   @param  dy       Destination y of the rectangle's top left corner
+   @param  src      Source canvas, read in its current rotation
+   @param  srcRect  Part of src to copy, NULL for all of it
+   @param  options  Color key and mask, NULL to copy every pixel
+*/
+/**************************************************************************/
+void gfxBlit(Adafruit_GFX &dst, int16_t dx, int16_t dy,
+             const GFXcanvas16 &src, const GFXrect *srcRect,
+             const GFXblitOptions *options) {
+  BlitArea a;
+  if (!blitClip(dst, dx, dy, src, srcRect, &a))
+    return;
+  dst.startWrite();
+  blitRuns(src, a, options,
+           [&dst](int16_t x, int16_t y, const uint16_t *px, int16_t n) {
+             for (int16_t k = 0; k < n; k++)
+               dst.writePixel(x + k, y, px[k]);
+           });
+  dst.endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief  Copy a rectangle of a canvas onto another canvas, a row (or, with
+           a color key or mask, a run of opaque pixels) at a time straight
+           into the destination buffer. src and dst must not be the same
+           canvas.
+   @param  dst      Destination canvas, drawn in its current rotation
+   @param  dx       Destination x of the rectangle's top left corner
+   @param  dy       Destination y of the rectangle's top left corner
+   @param  src      Source canvas, read in its current rotation
+   @param  srcRect  Part of src to copy, NULL for all of it
+   @param  options  Color key and mask, NULL to copy every pixel
+*/
+/**************************************************************************/
+void gfxBlit(GFXcanvas16 &dst, int16_t dx, int16_t dy, const GFXcanvas16 &src,
+             const GFXrect *srcRect, const GFXblitOptions *options) {
+  BlitArea a;
+  if (!dst.getBuffer() || !blitClip(dst, dx, dy, src, srcRect, &a))
+    return;
+  blitRuns(src, a, options,
+           [&dst](int16_t x, int16_t y, const uint16_t *px, int16_t n) {
+             dst.drawRGBBitmap(x, y, (uint16_t *)px, n, 1);
+           });
+}
+
+// Word for comparing frames in flushDiff(), 4 or 2 pixels at a time
+#if UINTPTR_MAX > 0xFFFFFFFFUL
+typedef uint64_t diffword_t;
+#else
+typedef uint32_t diffword_t;
+#endif
+
+// Index of the first pixel from i (up to n) where rows a and b differ,
+// comparing a word at a time while they match
+static int16_t diffFrom(const uint16_t *a, const uint16_t *b, int16_t i,
+                        int16_t n) {
+  const int16_t px = sizeof(diffword_t) / 2;
+  for (; i + px <= n; i += px) {
+    diffword_t wa, wb;
+    memcpy(&wa, &a[i], sizeof(wa));
+    memcpy(&wb, &b[i], sizeof(wb));
+    if (wa != wb)
+      break;
+  }
+  while ((i < n) && (a[i] == b[i]))
+    i++;
+  return i;
+}
+
+#if !defined(__AVR_ATtiny85__)
+/**************************************************************************/
+/*!
+   @brief  Copy a rectangle of a canvas onto a display: one address window
+           and a writePixels() per row for a plain copy, or a window per
+           run of opaque pixels with a color key or mask
+   @param  dst      Destination display, drawn in its current rotation
+   @param  dx       Destination x of the rectangle's top left corner
+   @param  dy       Destination y of the rectangle's top left corner
+   @param  src      Source canvas, read in its current rotation
+   @param  srcRect  Part of src to copy, NULL for all of it
+   @param  options  Color key and mask, NULL to copy every pixel
+*/
+/**************************************************************************/
+void gfxBlit(Adafruit_SPITFT &dst, int16_t dx, int16_t dy,
+             const GFXcanvas16 &src, const GFXrect *srcRect,
+             const GFXblitOptions *options) {
+  BlitArea a;
+  if (!blitClip(dst, dx, dy, src, srcRect, &a))
+    return;
+  dst.startWrite();
+  if (!options || (!options->mask && !options->useKey)) {
+    // Runs arrive in raster order and fill the window exactly
+    dst.setAddrWindow(a.dx, a.dy, a.w, a.h);
+    blitRuns(src, a, options,
+             [&dst](int16_t, int16_t, const uint16_t *px, int16_t n) {
+               dst.writePixels((uint16_t *)px, n);
+             });
+  } else {
+    blitRuns(src, a, options,
+             [&dst](int16_t x, int16_t y, const uint16_t *px, int16_t n) {
+               dst.setAddrWindow(x, y, n, 1);
+               dst.writePixels((uint16_t *)px, n);
+             });
+  }
+  dst.endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief  Send the parts of the canvas that changed since the last flush
+           to a display, then mark them clean. Each area from
+           nextDirtyRect() gets one address window; its rows go out with
+           writePixels(), as one call when the area is full width. With
+           trackDirty() off, the whole canvas is sent. The raw (rotation
+           0) buffer is sent, like drawRGBBitmap(x, y, getBuffer(),
+           WIDTH, HEIGHT) would, and areas are clipped to the display.
+   @param  tft  Display, drawn in its current rotation
+   @param  x    Display x of the canvas' top left corner
+   @param  y    Display y of the canvas' top left corner
+*/
+/**************************************************************************/
+void GFXcanvas16::flushDirty(Adafruit_SPITFT &tft, int16_t x, int16_t y) {
+  int16_t rx = 0, ry = 0, rw = WIDTH, rh = HEIGHT;
+  bool all = !dirty; // Not tracking: one area, the whole canvas
+  if (!buffer)
+    return;
+  tft.startWrite();
+  while (all || nextDirtyRect(&rx, &ry, &rw, &rh)) {
+    all = false;
+    // Trim the area to the display, in display coordinates
+    int32_t x0 = max((int32_t)x + rx, (int32_t)0);
+    int32_t y0 = max((int32_t)y + ry, (int32_t)0);
+    int32_t x1 = min((int32_t)x + rx + rw, (int32_t)tft.width());
+    int32_t y1 = min((int32_t)y + ry + rh, (int32_t)tft.height());
+    if ((x1 <= x0) || (y1 <= y0))
+      continue;
+    uint16_t *ptr = &buffer[(y0 - y) * WIDTH + (x0 - x)];
+    tft.setAddrWindow(x0, y0, x1 - x0, y1 - y0);
+    if (x1 - x0 == WIDTH) {
+      tft.writePixels(ptr, (uint32_t)WIDTH * (y1 - y0));
+    } else {
+      for (int32_t j = y0; j < y1; j++, ptr += WIDTH)
+        tft.writePixels(ptr, x1 - x0);
+    }
+  }
+  tft.endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief  Send a display the pixels that differ from the frame sent last
+           time (see keepFrame()), then remember them. Each row is compared
+           a word at a time; changed pixels are sent as horizontal spans,
+           one address window and writePixels() each, joining spans split
+           by fewer than gap unchanged pixels. Without keepFrame() on, the
+           whole canvas is sent. The raw (rotation 0) buffer is sent, like
+           flushDirty(), clipped to the display. If x or y change, or
+           something else draws on the display, call keepFrame(true) again
+           so the next flush resends everything.
+   @param  tft  Display, drawn in its current rotation
+   @param  x    Display x of the canvas' top left corner
+   @param  y    Display y of the canvas' top left corner
+   @param  gap  Shortest run of unchanged pixels worth a new window
+*/
+/**************************************************************************/
+void GFXcanvas16::flushDiff(Adafruit_SPITFT &tft, int16_t x, int16_t y,
+                            uint8_t gap) {
+  // Visible part of the canvas, in canvas coordinates
+  int16_t i0 = max(-x, 0), j0 = max(-y, 0);
+  int16_t i1 = min((int32_t)WIDTH, (int32_t)tft.width() - x);
+  int16_t j1 = min((int32_t)HEIGHT, (int32_t)tft.height() - y);
+  if (!buffer || (i1 <= i0) || (j1 <= j0))
+    return;
+  tft.startWrite();
+  if (!frame || !frameValid) { // Nothing to compare against: send it all
+    tft.setAddrWindow(x + i0, y + j0, i1 - i0, j1 - j0);
+    for (int16_t j = j0; j < j1; j++)
+      tft.writePixels(&buffer[(int32_t)j * WIDTH + i0], i1 - i0);
+    if (frame)
+      memcpy(frame, buffer, (uint32_t)WIDTH * HEIGHT * 2);
+    frameValid = (frame != NULL);
+  } else {
+    for (int16_t j = j0; j < j1; j++) {
+      uint16_t *now = &buffer[(int32_t)j * WIDTH],
+               *was = &frame[(int32_t)j * WIDTH];
+      for (int16_t a = diffFrom(now, was, i0, i1); a < i1;) {
+        int16_t b = a + 1, next; // Span is a to b (exclusive)
+        for (;;) {
+          while ((b < i1) && (now[b] != was[b]))
+            b++;
+          next = diffFrom(now, was, b, i1);
+          if ((next >= i1) || (next - b >= gap))
+            break;
+          b = next + 1; // Gap too short to be worth a window, join it
+        }
+        tft.setAddrWindow(x + a, y + j, b - a, 1);
+        tft.writePixels(&now[a], b - a);
+        memcpy(&was[a], &now[a], (b - a) * 2);
+        a = next;
+      }
+    }
+  }
+  tft.endWrite();
+}
+
+/**************************************************************************/
+/*!
+   @brief  Send the canvas to a display, looking each pixel up in the
+           palette on the way. Pixels are expanded GFX_PALETTE_LINE at a
+           time, alternating between two line buffers: with DMA, one
+           buffer is sent while the next is filled. The raw (rotation 0)
+           buffer is sent into a single address window, clipped to the
+           display, like GFXcanvas16::flushDirty().
+   @param  tft  Display, drawn in its current rotation
+   @param  x    Display x of the canvas' top left corner
+   @param  y    Display y of the canvas' top left corner
+*/
+/**************************************************************************/
+template <uint8_t BITS>
+void GFXcanvasIndexed<BITS>::flush(Adafruit_SPITFT &tft, int16_t x,
+                                   int16_t y) {
+  // Visible part of the canvas, in canvas coordinates
+  int16_t i0 = max(-x, 0), j0 = max(-y, 0);
+  int16_t i1 = min((int32_t)this->WIDTH, (int32_t)tft.width() - x);
+  int16_t j1 = min((int32_t)this->HEIGHT, (int32_t)tft.height() - y);
+  const uint8_t *buffer = this->getBuffer();
+  if (!buffer || (i1 <= i0) || (j1 <= j0))
+    return;
+  uint16_t line[2][GFX_PALETTE_LINE];
+  uint8_t k = 0;
+  tft.startWrite();
+  tft.setAddrWindow(x + i0, y + j0, i1 - i0, j1 - j0);
+  for (int16_t j = j0; j < j1; j++) {
+    const uint8_t *row = &buffer[(uint32_t)j * this->bytesPerRow()];
+    for (int16_t i = i0, n; i < i1; i += n) {
+      n = min(i1 - i, GFX_PALETTE_LINE);
+      expand(row, i, n, line[k]);
+      // Doesn't wait for DMA to finish. A DMA writePixels() first waits
+      // for the one before, so the buffer filled next is free again.
+      tft.writePixels(line[k], n, false, true);
+      k ^= 1;
+    }
+  }
+  tft.dmaWait();
+  tft.endWrite();
+}
+
+template void GFXcanvasIndexed<2>::flush(Adafruit_SPITFT &, int16_t, int16_t);
+template void GFXcanvasIndexed<4>::flush(Adafruit_SPITFT &, int16_t, int16_t);
+template void GFXcanvasIndexed<8>::flush(Adafruit_SPITFT &, int16_t, int16_t);
+#endif // !__AVR_ATtiny85__
@@ -0,0 +1,55 @@
+/*!
+ * @file Adafruit_GFXBlit.h
+ *
+ * Part of Adafruit's GFX graphics library. gfxBlit() copies a rectangle
+ * of a GFXcanvas16 onto another GFXcanvas16, onto an Adafruit_SPITFT
+ * display or onto any other Adafruit_GFX, at any position. The copy is
+ * clipped to both the source canvas and the destination's clip rect, and
+ * can skip pixels through a transparent color key and/or a 1-bit mask.
+ * This is the building block for sprites and layered interfaces: draw
+ * each layer into its own canvas once, then composite only what moved.
+ *
+ *   GFXcanvas16 sprite(16, 16);
+ *   GFXblitOptions opt = {NULL, 0xF81F, true}; // Magenta is transparent
+ *   gfxBlit(tft, x, y, sprite, NULL, &opt);
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFXBLIT_H_
+#define _ADAFRUIT_GFXBLIT_H_
+
+#include "Adafruit_GFX.h"
+#include "Adafruit_SPITFT.h"
+
+/// A rectangle in a canvas' own (rotated) coordinates
+typedef struct {
+  int16_t x; ///< Left edge
+  int16_t y; ///< Top edge
+  int16_t w; ///< Width in pixels
+  int16_t h; ///< Height in pixels
+} GFXrect;
+
+/// How gfxBlit() picks the source pixels to copy. All zero = copy all.
+typedef struct {
+  const uint8_t *mask; ///< RAM-resident 1-bit mask the size of the whole
+                       ///< source canvas, rows padded to whole bytes, MSB
+                       ///< first, set bits opaque (as in drawRGBBitmap()).
+                       ///< NULL for none.
+  uint16_t key;        ///< Transparent color, if useKey is set
+  bool useKey;         ///< If set, source pixels equal to key are skipped
+} GFXblitOptions;
+
+void gfxBlit(Adafruit_GFX &dst, int16_t dx, int16_t dy,
+             const GFXcanvas16 &src, const GFXrect *srcRect = NULL,
+             const GFXblitOptions *options = NULL);
+void gfxBlit(GFXcanvas16 &dst, int16_t dx, int16_t dy, const GFXcanvas16 &src,
+             const GFXrect *srcRect = NULL,
+             const GFXblitOptions *options = NULL);
+#if !defined(__AVR_ATtiny85__)
+void gfxBlit(Adafruit_SPITFT &dst, int16_t dx, int16_t dy,
+             const GFXcanvas16 &src, const GFXrect *srcRect = NULL,
+             const GFXblitOptions *options = NULL);
+#endif
+
+#endif // _ADAFRUIT_GFXBLIT_H_
@@ -0,0 +1,1249 @@
+/*!
+ * @file Adafruit_GFXDisplayList.cpp
+ *
+ * Part of Adafruit's GFX graphics library: GFXDisplayList, recording
+ * drawing calls and rendering them to a display one band at a time.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_GFXDisplayList.h"
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+// A command is an opcode byte, the bounding box it may draw to (left, top,
+// right, bottom, inclusive, as int16_t, already trimmed to the clip rect)
+// and then the opcode's argument struct, all byte packed.
+#define DL_HEADER 9 ///< Bytes of opcode and box ahead of the arguments
+
+enum {
+  DL_PIXEL,         ///< DLPixel
+  DL_RECT,          ///< DLRect, filled
+  DL_LINE,          ///< DLLine
+  DL_CIRCLE,        ///< DLCircle, outline
+  DL_FILLCIRCLE,    ///< DLCircle, filled
+  DL_TRIANGLE,      ///< DLTriangle, outline
+  DL_FILLTRIANGLE,  ///< DLTriangle, filled
+  DL_ROUNDRECT,     ///< DLRoundRect, outline
+  DL_FILLROUNDRECT, ///< DLRoundRect, filled
+  DL_CHAR,          ///< DLChar
+  DL_BITMAP,        ///< DLBitmap
+  DL_RGBBITMAP,     ///< DLRGBBitmap
+  DL_CLIP,          ///< DLRect (color unused), pushClipRect()
+  DL_UNCLIP         ///< No arguments, popClipRect()
+};
+
+#define DL_BG 0x01  ///< DLBitmap: draw 0 bits in bg
+#define DL_RAM 0x02 ///< DLBitmap/DLRGBBitmap: bitmap (and mask) are in RAM
+#define DL_XBM 0x04 ///< DLBitmap: XBM bit order (drawXBitmap())
+
+/// DL_PIXEL arguments
+struct DLPixel {
+  int16_t x;      ///< X coordinate
+  int16_t y;      ///< Y coordinate
+  uint16_t color; ///< 16-bit color
+};
+
+/// DL_RECT and DL_CLIP arguments
+struct DLRect {
+  int16_t x;      ///< Left edge
+  int16_t y;      ///< Top edge
+  int16_t w;      ///< Width, positive
+  int16_t h;      ///< Height, positive
+  uint16_t color; ///< 16-bit color
+};
+
+/// DL_LINE arguments
+struct DLLine {
+  int16_t x0;     ///< Start x
+  int16_t y0;     ///< Start y
+  int16_t x1;     ///< End x
+  int16_t y1;     ///< End y
+  uint16_t color; ///< 16-bit color
+};
+
+/// DL_CIRCLE and DL_FILLCIRCLE arguments
+struct DLCircle {
+  int16_t x;      ///< Center x
+  int16_t y;      ///< Center y
+  int16_t r;      ///< Radius
+  uint16_t color; ///< 16-bit color
+};
+
+/// DL_TRIANGLE and DL_FILLTRIANGLE arguments
+struct DLTriangle {
+  int16_t xy[6];  ///< Corners, x0 y0 x1 y1 x2 y2
+  uint16_t color; ///< 16-bit color
+};
+
+/// DL_ROUNDRECT and DL_FILLROUNDRECT arguments
+struct DLRoundRect {
+  int16_t x;      ///< Left edge
+  int16_t y;      ///< Top edge
+  int16_t w;      ///< Width
+  int16_t h;      ///< Height
+  int16_t r;      ///< Corner radius
+  uint16_t color; ///< 16-bit color
+};
+
+/// DL_CHAR arguments
+struct DLChar {
+  const GFXfont *font; ///< Font, NULL for the classic one
+  int16_t x;           ///< drawChar() x
+  int16_t y;           ///< drawChar() y
+  uint16_t color;      ///< Text color
+  uint16_t bg;         ///< Background color, same as color for none
+  uint32_t c;          ///< Character's codepoint
+  uint8_t size_x;      ///< Horizontal magnification
+  uint8_t size_y;      ///< Vertical magnification
+};
+
+/// DL_BITMAP arguments
+struct DLBitmap {
+  const uint8_t *bitmap; ///< 1-bit bitmap, in PROGMEM unless DL_RAM
+  int16_t x;             ///< Left edge
+  int16_t y;             ///< Top edge
+  int16_t w;             ///< Width
+  int16_t h;             ///< Height
+  uint16_t color;        ///< Color of 1 bits
+  uint16_t bg;           ///< Color of 0 bits, if DL_BG
+  uint8_t flags;         ///< DL_BG, DL_RAM, DL_XBM
+};
+
+/// DL_RGBBITMAP arguments
+struct DLRGBBitmap {
+  const uint16_t *bitmap; ///< 16-bit bitmap, in PROGMEM unless DL_RAM
+  const uint8_t *mask;    ///< 1-bit mask, NULL for none
+  int16_t x;              ///< Left edge
+  int16_t y;              ///< Top edge
+  int16_t w;              ///< Width
+  int16_t h;              ///< Height
+  uint8_t flags;          ///< DL_RAM
+};
+
+// Argument bytes following the header, by opcode
+static const uint8_t argBytes[] = {
+    sizeof(DLPixel),     sizeof(DLRect),      sizeof(DLLine),
+    sizeof(DLCircle),    sizeof(DLCircle),    sizeof(DLTriangle),
+    sizeof(DLTriangle),  sizeof(DLRoundRect), sizeof(DLRoundRect),
+    sizeof(DLChar),      sizeof(DLBitmap),    sizeof(DLRGBBitmap),
+    sizeof(DLRect),      0};
+
+/**************************************************************************/
+/*!
+   @brief    Create a display list, allocating its command buffer
+   @param    w     Width in pixels, as the display it will be rendered to
+   @param    h     Height in pixels
+   @param    size  Bytes of command buffer. A command takes 11 to 25 bytes
+                   on 32-bit targets; each character of text is one.
+*/
+/**************************************************************************/
+GFXDisplayList::GFXDisplayList(uint16_t w, uint16_t h, uint32_t size)
+    : Adafruit_GFX(w, h), size(size), used(0), full(false), owned(true),
+      capturing(false) {
+  list = (uint8_t *)malloc(size);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Create a display list recording into a buffer of the caller's,
+             for instance a static array. The buffer is not freed.
+   @param    w       Width in pixels, as the display it will be rendered to
+   @param    h       Height in pixels
+   @param    buffer  Command buffer
+   @param    size    Bytes in buffer
+*/
+/**************************************************************************/
+GFXDisplayList::GFXDisplayList(uint16_t w, uint16_t h, uint8_t *buffer,
+                               uint32_t size)
+    : Adafruit_GFX(w, h), list(buffer), size(size), used(0), full(false),
+      owned(false), capturing(false) {}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the display list, free memory
+*/
+/**************************************************************************/
+GFXDisplayList::~GFXDisplayList(void) {
+  if (list && owned)
+    free(list);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Forget all recorded commands, to record the next frame
+*/
+/**************************************************************************/
+void GFXDisplayList::clear(void) {
+  used = 0;
+  full = false;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Check whether a command's bounding box can be seen through the
+             clip rect, and so is worth recording. While a character is
+             being measured, add the rows to the measurement instead.
+   @param    x0  Left-most x coordinate
+   @param    y0  Top-most y coordinate
+   @param    x1  Right-most x coordinate (inclusive)
+   @param    y1  Bottom-most y coordinate (inclusive)
+   @returns  true if the command should be recorded
+*/
+/**************************************************************************/
+bool GFXDisplayList::visible(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+  if (isClipped(x0, y0, x1, y1))
+    return false;
+  if (capturing) {
+    capX0 = min((int32_t)capX0, max(x0, (int32_t)clipX0()));
+    capY0 = min((int32_t)capY0, max(y0, (int32_t)clipY0()));
+    capX1 = max((int32_t)capX1, min(x1, (int32_t)clipX1() - 1));
+    capY1 = max((int32_t)capY1, min(y1, (int32_t)clipY1() - 1));
+    return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Append a command to the list. Once one doesn't fit, the list is
+             marked full and takes no more until clear().
+   @param    op    Opcode
+   @param    x0    Left-most column the command draws to
+   @param    y0    Top row
+   @param    x1    Right-most column (inclusive)
+   @param    y1    Bottom row (inclusive)
+   @param    args  The opcode's argument struct
+*/
+/**************************************************************************/
+void GFXDisplayList::put(uint8_t op, int32_t x0, int32_t y0, int32_t x1,
+                         int32_t y1, const void *args) {
+  uint8_t len = argBytes[op];
+  if (!list || full || (used + DL_HEADER + len > size)) {
+    full = true;
+    return;
+  }
+  int16_t box[4] = {(int16_t)max(x0, (int32_t)clipX0()),
+                    (int16_t)max(y0, (int32_t)clipY0()),
+                    (int16_t)min(x1, (int32_t)clipX1() - 1),
+                    (int16_t)min(y1, (int32_t)clipY1() - 1)};
+  uint8_t *p = &list[used];
+  p[0] = op;
+  memcpy(&p[1], box, sizeof(box));
+  if (len)
+    memcpy(&p[DL_HEADER], args, len);
+  used += DL_HEADER + len;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled rectangle. A negative width or height extends
+             left or up from (x,y), as on the canvases.
+   @param    x      Left edge
+   @param    y      Top edge
+   @param    w      Width in pixels
+   @param    h      Height in pixels
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::putRect(int32_t x, int32_t y, int32_t w, int32_t h,
+                             uint16_t color) {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (!w || !h || !visible(x, y, x + w - 1, y + h - 1))
+    return;
+  // Trim to the clip rect, so the target replaying it has less to clip
+  // and the coordinates are sure to fit an int16_t
+  int32_t x1 = min(x + w, (int32_t)clipX1());
+  int32_t y1 = min(y + h, (int32_t)clipY1());
+  x = max(x, (int32_t)clipX0());
+  y = max(y, (int32_t)clipY0());
+  DLRect a = {(int16_t)x, (int16_t)y, (int16_t)(x1 - x), (int16_t)(y1 - y),
+              color};
+  put(DL_RECT, x, y, x1 - 1, y1 - 1, &a);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a pixel
+   @param    x      X coordinate
+   @param    y      Y coordinate
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (visible(x, y, x, y)) {
+    DLPixel a = {x, y, color};
+    put(DL_PIXEL, x, y, x, y, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a pixel, same as drawPixel()
+   @param    x      X coordinate
+   @param    y      Y coordinate
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::writePixel(int16_t x, int16_t y, uint16_t color) {
+  drawPixel(x, y, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled rectangle, same as fillRect()
+   @param    x      Left edge
+   @param    y      Top edge
+   @param    w      Width in pixels
+   @param    h      Height in pixels
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                   uint16_t color) {
+  putRect(x, y, w, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a vertical line, as a 1-pixel wide rectangle
+   @param    x      Top-most x coordinate
+   @param    y      Top-most y coordinate
+   @param    h      Height in pixels
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                    uint16_t color) {
+  putRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a horizontal line, as a 1-pixel high rectangle
+   @param    x      Left-most x coordinate
+   @param    y      Left-most y coordinate
+   @param    w      Width in pixels
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                    uint16_t color) {
+  putRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a line
+   @param    x0     Start point x coordinate
+   @param    y0     Start point y coordinate
+   @param    x1     End point x coordinate
+   @param    y1     End point y coordinate
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                               uint16_t color) {
+  if (visible(min(x0, x1), min(y0, y1), max(x0, x1), max(y0, y1))) {
+    DLLine a = {x0, y0, x1, y1, color};
+    put(DL_LINE, min(x0, x1), min(y0, y1), max(x0, x1), max(y0, y1), &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record horizontal spans, one 1-pixel high rectangle each
+   @param    spans  Array of spans
+   @param    count  Number of spans
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::writeSpans(const GFXspan *spans, uint16_t count,
+                                uint16_t color) {
+  for (uint16_t i = 0; i < count; i++)
+    putRect(spans[i].x, spans[i].y, spans[i].w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a vertical line
+   @param    x      Top-most x coordinate
+   @param    y      Top-most y coordinate
+   @param    h      Height in pixels
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                   uint16_t color) {
+  putRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a horizontal line
+   @param    x      Left-most x coordinate
+   @param    y      Left-most y coordinate
+   @param    w      Width in pixels
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                   uint16_t color) {
+  putRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled rectangle
+   @param    x      Left edge
+   @param    y      Top edge
+   @param    w      Width in pixels
+   @param    h      Height in pixels
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                              uint16_t color) {
+  putRect(x, y, w, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record filling the screen (the clip rect, if one is pushed)
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::fillScreen(uint16_t color) {
+  putRect(0, 0, _width, _height, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a line
+   @param    x0     Start point x coordinate
+   @param    y0     Start point y coordinate
+   @param    x1     End point x coordinate
+   @param    y1     End point y coordinate
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              uint16_t color) {
+  writeLine(x0, y0, x1, y1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a circle outline
+   @param    x0     Center x coordinate
+   @param    y0     Center y coordinate
+   @param    r      Radius of circle
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::drawCircle(int16_t x0, int16_t y0, int16_t r,
+                                uint16_t color) {
+  if (visible((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+              (int32_t)y0 + r)) {
+    DLCircle a = {x0, y0, r, color};
+    put(DL_CIRCLE, (int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+        (int32_t)y0 + r, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled circle
+   @param    x0     Center x coordinate
+   @param    y0     Center y coordinate
+   @param    r      Radius of circle
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::fillCircle(int16_t x0, int16_t y0, int16_t r,
+                                uint16_t color) {
+  if (visible((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+              (int32_t)y0 + r)) {
+    DLCircle a = {x0, y0, r, color};
+    put(DL_FILLCIRCLE, (int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+        (int32_t)y0 + r, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a triangle outline
+   @param    x0     Vertex #0 x coordinate
+   @param    y0     Vertex #0 y coordinate
+   @param    x1     Vertex #1 x coordinate
+   @param    y1     Vertex #1 y coordinate
+   @param    x2     Vertex #2 x coordinate
+   @param    y2     Vertex #2 y coordinate
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::drawTriangle(int16_t x0, int16_t y0, int16_t x1,
+                                  int16_t y1, int16_t x2, int16_t y2,
+                                  uint16_t color) {
+  int16_t left = min(min(x0, x1), x2), top = min(min(y0, y1), y2),
+          right = max(max(x0, x1), x2), bottom = max(max(y0, y1), y2);
+  if (visible(left, top, right, bottom)) {
+    DLTriangle a = {{x0, y0, x1, y1, x2, y2}, color};
+    put(DL_TRIANGLE, left, top, right, bottom, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled triangle
+   @param    x0     Vertex #0 x coordinate
+   @param    y0     Vertex #0 y coordinate
+   @param    x1     Vertex #1 x coordinate
+   @param    y1     Vertex #1 y coordinate
+   @param    x2     Vertex #2 x coordinate
+   @param    y2     Vertex #2 y coordinate
+   @param    color  16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::fillTriangle(int16_t x0, int16_t y0, int16_t x1,
+                                  int16_t y1, int16_t x2, int16_t y2,
+                                  uint16_t color) {
+  int16_t left = min(min(x0, x1), x2), top = min(min(y0, y1), y2),
+          right = max(max(x0, x1), x2), bottom = max(max(y0, y1), y2);
+  if (visible(left, top, right, bottom)) {
+    DLTriangle a = {{x0, y0, x1, y1, x2, y2}, color};
+    put(DL_FILLTRIANGLE, left, top, right, bottom, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a rounded rectangle outline
+   @param    x0      Top left corner x coordinate
+   @param    y0      Top left corner y coordinate
+   @param    w       Width in pixels
+   @param    h       Height in pixels
+   @param    radius  Radius of corner rounding
+   @param    color   16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::drawRoundRect(int16_t x0, int16_t y0, int16_t w,
+                                   int16_t h, int16_t radius, uint16_t color) {
+  if ((w <= 0) || (h <= 0)) // Odd shapes; record the primitives instead
+    Adafruit_GFX::drawRoundRect(x0, y0, w, h, radius, color);
+  else if (visible(x0, y0, (int32_t)x0 + w - 1, (int32_t)y0 + h - 1)) {
+    DLRoundRect a = {x0, y0, w, h, radius, color};
+    put(DL_ROUNDRECT, x0, y0, (int32_t)x0 + w - 1, (int32_t)y0 + h - 1, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled rounded rectangle
+   @param    x0      Top left corner x coordinate
+   @param    y0      Top left corner y coordinate
+   @param    w       Width in pixels
+   @param    h       Height in pixels
+   @param    radius  Radius of corner rounding
+   @param    color   16-bit color
+*/
+/**************************************************************************/
+void GFXDisplayList::fillRoundRect(int16_t x0, int16_t y0, int16_t w,
+                                   int16_t h, int16_t radius, uint16_t color) {
+  if ((w <= 0) || (h <= 0)) // Odd shapes; record the primitives instead
+    Adafruit_GFX::fillRoundRect(x0, y0, w, h, radius, color);
+  else if (visible(x0, y0, (int32_t)x0 + w - 1, (int32_t)y0 + h - 1)) {
+    DLRoundRect a = {x0, y0, w, h, radius, color};
+    put(DL_FILLROUNDRECT, x0, y0, (int32_t)x0 + w - 1, (int32_t)y0 + h - 1,
+        &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a 1-bit bitmap, by reference
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Bitmap, which must outlive the list's next rendering
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+   @param    color   Color of 1 bits
+   @param    bg      Color of 0 bits, if flags has DL_BG
+   @param    flags   DL_BG, DL_RAM and/or DL_XBM
+*/
+/**************************************************************************/
+void GFXDisplayList::putBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                               int16_t w, int16_t h, uint16_t color,
+                               uint16_t bg, uint8_t flags) {
+  if ((w > 0) && (h > 0) &&
+      visible(x, y, (int32_t)x + w - 1, (int32_t)y + h - 1)) {
+    DLBitmap a = {bitmap, x, y, w, h, color, bg, flags};
+    put(DL_BITMAP, x, y, (int32_t)x + w - 1, (int32_t)y + h - 1, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a PROGMEM-resident 1-bit bitmap, by reference. 0 bits
+             are transparent.
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with monochrome bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+   @param    color   16-bit color to draw with
+*/
+/**************************************************************************/
+void GFXDisplayList::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                int16_t w, int16_t h, uint16_t color) {
+  putBitmap(x, y, bitmap, w, h, color, 0, 0);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a PROGMEM-resident 1-bit bitmap, by reference, with
+             background color
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with monochrome bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+   @param    color   16-bit color to draw set bits with
+   @param    bg      16-bit color to draw clear bits with
+*/
+/**************************************************************************/
+void GFXDisplayList::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                int16_t w, int16_t h, uint16_t color,
+                                uint16_t bg) {
+  putBitmap(x, y, bitmap, w, h, color, bg, DL_BG);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a RAM-resident 1-bit bitmap, by reference. 0 bits are
+             transparent.
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with monochrome bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+   @param    color   16-bit color to draw with
+*/
+/**************************************************************************/
+void GFXDisplayList::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                int16_t w, int16_t h, uint16_t color) {
+  putBitmap(x, y, bitmap, w, h, color, 0, DL_RAM);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a RAM-resident 1-bit bitmap, by reference, with
+             background color
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with monochrome bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+   @param    color   16-bit color to draw set bits with
+   @param    bg      16-bit color to draw clear bits with
+*/
+/**************************************************************************/
+void GFXDisplayList::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                                int16_t w, int16_t h, uint16_t color,
+                                uint16_t bg) {
+  putBitmap(x, y, bitmap, w, h, color, bg, DL_BG | DL_RAM);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a PROGMEM-resident XBitMap, by reference
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with XBM bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+   @param    color   16-bit color to draw pixels with
+*/
+/**************************************************************************/
+void GFXDisplayList::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                 int16_t w, int16_t h, uint16_t color) {
+  putBitmap(x, y, bitmap, w, h, color, 0, DL_XBM);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a 16-bit bitmap, by reference
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Bitmap, which must outlive the list's next rendering
+   @param    mask    1-bit mask, NULL for none
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+   @param    flags   DL_RAM if bitmap and mask are in RAM
+*/
+/**************************************************************************/
+void GFXDisplayList::putRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                                  const uint8_t *mask, int16_t w, int16_t h,
+                                  uint8_t flags) {
+  if ((w > 0) && (h > 0) &&
+      visible(x, y, (int32_t)x + w - 1, (int32_t)y + h - 1)) {
+    DLRGBBitmap a = {bitmap, mask, x, y, w, h, flags};
+    put(DL_RGBBITMAP, x, y, (int32_t)x + w - 1, (int32_t)y + h - 1, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a PROGMEM-resident 16-bit bitmap, by reference
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with 16-bit color bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXDisplayList::drawRGBBitmap(int16_t x, int16_t y,
+                                   const uint16_t bitmap[], int16_t w,
+                                   int16_t h) {
+  putRGBBitmap(x, y, bitmap, NULL, w, h, 0);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a RAM-resident 16-bit bitmap, by reference
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with 16-bit color bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXDisplayList::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                   int16_t w, int16_t h) {
+  putRGBBitmap(x, y, bitmap, NULL, w, h, DL_RAM);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a PROGMEM-resident 16-bit bitmap with a 1-bit mask, by
+             reference
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with 16-bit color bitmap
+   @param    mask    Byte array with mask bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXDisplayList::drawRGBBitmap(int16_t x, int16_t y,
+                                   const uint16_t bitmap[],
+                                   const uint8_t mask[], int16_t w,
+                                   int16_t h) {
+  putRGBBitmap(x, y, bitmap, mask, w, h, 0);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a RAM-resident 16-bit bitmap with a 1-bit mask, by
+             reference
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Byte array with 16-bit color bitmap
+   @param    mask    Byte array with mask bitmap
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void GFXDisplayList::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
+                                   uint8_t *mask, int16_t w, int16_t h) {
+  putRGBBitmap(x, y, bitmap, mask, w, h, DL_RAM);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a character, measuring the rows it covers by drawing it
+             in capture mode
+   @param    x       Bottom left corner x coordinate
+   @param    y       Bottom left corner y coordinate
+   @param    c       The character's codepoint
+   @param    color   16-bit 5-6-5 Color to draw chraracter with
+   @param    bg      16-bit 5-6-5 Color to fill background with (if same as
+                     color, no background)
+   @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+   @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void GFXDisplayList::putChar(int16_t x, int16_t y, uint32_t c,
+                             uint16_t color, uint16_t bg, uint8_t size_x,
+                             uint8_t size_y) {
+  capturing = true;
+  capX0 = capY0 = INT16_MAX;
+  capX1 = capY1 = INT16_MIN;
+  Adafruit_GFX::drawCodepoint(x, y, c, color, bg, size_x, size_y);
+  capturing = false;
+  if (capY0 <= capY1) {
+    const GFXfont *font = gfxFont; // Or the chain's font with the glyph
+    findGlyph(c, &font);
+    DLChar a = {font, x, y, color, bg, c, size_x, size_y};
+    put(DL_CHAR, capX0, capY0, capX1, capY1, &a);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a character
+   @param    x       Bottom left corner x coordinate
+   @param    y       Bottom left corner y coordinate
+   @param    c       The 8-bit font-indexed character (likely ascii)
+   @param    color   16-bit 5-6-5 Color to draw chraracter with
+   @param    bg      16-bit 5-6-5 Color to fill background with (if same as
+                     color, no background)
+   @param    size    Font magnification level, 1 is 'original' size
+*/
+/**************************************************************************/
+void GFXDisplayList::drawChar(int16_t x, int16_t y, unsigned char c,
+                              uint16_t color, uint16_t bg, uint8_t size) {
+  putChar(x, y, c, color, bg, size, size);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a character
+   @param    x       Bottom left corner x coordinate
+   @param    y       Bottom left corner y coordinate
+   @param    c       The 8-bit font-indexed character (likely ascii)
+   @param    color   16-bit 5-6-5 Color to draw chraracter with
+   @param    bg      16-bit 5-6-5 Color to fill background with (if same as
+                     color, no background)
+   @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+   @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void GFXDisplayList::drawChar(int16_t x, int16_t y, unsigned char c,
+                              uint16_t color, uint16_t bg, uint8_t size_x,
+                              uint8_t size_y) {
+  putChar(x, y, c, color, bg, size_x, size_y);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a character by its Unicode codepoint
+   @param    x       Bottom left corner x coordinate
+   @param    y       Bottom left corner y coordinate
+   @param    c       The codepoint
+   @param    color   16-bit 5-6-5 Color to draw chraracter with
+   @param    bg      16-bit 5-6-5 Color to fill background with (if same as
+                     color, no background)
+   @param    size_x  Font magnification level in X-axis, 1 is 'original' size
+   @param    size_y  Font magnification level in Y-axis, 1 is 'original' size
+*/
+/**************************************************************************/
+void GFXDisplayList::drawCodepoint(int16_t x, int16_t y, uint32_t c,
+                                   uint16_t color, uint16_t bg,
+                                   uint8_t size_x, uint8_t size_y) {
+  putChar(x, y, c, color, bg, size_x, size_y);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Print one byte/character of text. Each whole character (see
+             Adafruit_GFX::utf8()) is recorded by writeCodepoint().
+   @param    c  The 8-bit ascii character to write
+   @returns  1
+*/
+/**************************************************************************/
+size_t GFXDisplayList::write(uint8_t c) {
+  uint32_t code;
+  if (decodeUTF8(c, &code))
+    writeCodepoint(code);
+  return 1;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Print one character by its codepoint, recording it as a single
+             command placed where it was drawn, after any line wrap
+   @param    c  The codepoint, '\n' for a new line
+   @returns  1
+*/
+/**************************************************************************/
+size_t GFXDisplayList::writeCodepoint(uint32_t c) {
+  int16_t x = cursor_x, y = cursor_y;
+  capturing = true;
+  capX0 = capY0 = INT16_MAX;
+  capX1 = capY1 = INT16_MIN;
+  Adafruit_GFX::writeCodepoint(c);
+  capturing = false;
+  if (capY0 <= capY1) {
+    // A character that draws anything moves the cursor down only when it
+    // wraps, and then it is drawn at the start of the new line
+    if (cursor_y != y) {
+      x = 0;
+      y = cursor_y;
+    }
+    const GFXfont *font = gfxFont;
+    findGlyph(c, &font);
+    DLChar a = {font, x, y, textcolor, textbgcolor, c, textsize_x, textsize_y};
+    put(DL_CHAR, capX0, capY0, capX1, capY1, &a);
+  }
+  return 1;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Limit drawing to a rectangle, as Adafruit_GFX::pushClipRect(),
+             recording it so the list is clipped the same way when rendered
+   @param    x  Left edge
+   @param    y  Top edge
+   @param    w  Width in pixels
+   @param    h  Height in pixels
+   @return   true on success, false if the clip stack is full
+*/
+/**************************************************************************/
+bool GFXDisplayList::pushClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (!Adafruit_GFX::pushClipRect(x, y, w, h))
+    return false;
+  DLRect a = {x, y, w, h, 0};
+  put(DL_CLIP, x, y, (int32_t)x + w - 1, (int32_t)y + h - 1, &a);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Undo the last pushClipRect(), recording it too
+*/
+/**************************************************************************/
+void GFXDisplayList::popClipRect(void) {
+  Adafruit_GFX::popClipRect();
+  put(DL_UNCLIP, 0, 0, 0, 0, NULL);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the list onto a target, shifted by (dx,dy), skipping each
+             command whose box misses the target's clip rect. Templated on
+             the target, so that calls made on it reach its own bitmap and
+             shape routines where it has them.
+   @param    dst  Target to draw to
+   @param    dx   Offset added to every x coordinate
+   @param    dy   Offset added to every y coordinate
+*/
+/**************************************************************************/
+template <class GFX>
+void GFXDisplayList::replayTo(GFX &dst, int16_t dx, int16_t dy) const {
+  int16_t cx, cy, cw, ch, x = dst.getCursorX(), y = dst.getCursorY();
+  uint8_t chainLength;
+  const GFXfont *font = dst.getFont();
+  const GFXfont *const *chain = dst.getFontChain(&chainLength);
+  bool fonted = false; // dst's font was changed for a DL_CHAR
+  uint8_t level = 0;   // Depth of the list's own clip stack
+  uint32_t pushed = 0; // Bit n set if dst took the clip rect at level n
+  static_assert(GFX_CLIP_DEPTH <= 32, "pushed has one bit per clip level");
+  bool bounded = false;
+  dst.getClipRect(&cx, &cy, &cw, &ch);
+  // Shapes may have been recorded running off the list's edges. Clip them
+  // there if the target would show more.
+  if (((int32_t)cx < dx) || ((int32_t)cy < dy) ||
+      ((int32_t)cx + cw > (int32_t)dx + _width) ||
+      ((int32_t)cy + ch > (int32_t)dy + _height)) {
+    bounded = dst.pushClipRect(dx, dy, _width, _height);
+    dst.getClipRect(&cx, &cy, &cw, &ch);
+  }
+  for (uint32_t i = 0; list && (i < used);) {
+    const uint8_t *p = &list[i];
+    uint8_t op = p[0];
+    int16_t box[4];
+    memcpy(box, &p[1], sizeof(box));
+    i += DL_HEADER + argBytes[op];
+    // Clip rects apply to the commands after them, seen or not
+    if (op == DL_UNCLIP) {
+      if (level && (pushed & (1UL << --level))) {
+        pushed &= ~(1UL << level);
+        dst.popClipRect();
+        dst.getClipRect(&cx, &cy, &cw, &ch);
+      }
+      continue;
+    }
+    if ((op != DL_CLIP) &&
+        (((int32_t)box[2] + dx < cx) || ((int32_t)box[0] + dx >= cx + cw) ||
+         ((int32_t)box[3] + dy < cy) || ((int32_t)box[1] + dy >= cy + ch)))
+      continue;
+    union {
+      DLPixel pixel;
+      DLRect rect;
+      DLLine line;
+      DLCircle circle;
+      DLTriangle tri;
+      DLRoundRect rrect;
+      DLChar chr;
+      DLBitmap bmp;
+      DLRGBBitmap rgb;
+    } a;
+    memcpy(&a, &p[DL_HEADER], argBytes[op]);
+    switch (op) {
+    case DL_PIXEL:
+      dst.drawPixel(a.pixel.x + dx, a.pixel.y + dy, a.pixel.color);
+      break;
+    case DL_RECT:
+      dst.fillRect(a.rect.x + dx, a.rect.y + dy, a.rect.w, a.rect.h,
+                   a.rect.color);
+      break;
+    case DL_LINE:
+      dst.drawLine(a.line.x0 + dx, a.line.y0 + dy, a.line.x1 + dx,
+                   a.line.y1 + dy, a.line.color);
+      break;
+    case DL_CIRCLE:
+      dst.drawCircle(a.circle.x + dx, a.circle.y + dy, a.circle.r,
+                     a.circle.color);
+      break;
+    case DL_FILLCIRCLE:
+      dst.fillCircle(a.circle.x + dx, a.circle.y + dy, a.circle.r,
+                     a.circle.color);
+      break;
+    case DL_TRIANGLE:
+      dst.drawTriangle(a.tri.xy[0] + dx, a.tri.xy[1] + dy, a.tri.xy[2] + dx,
+                       a.tri.xy[3] + dy, a.tri.xy[4] + dx, a.tri.xy[5] + dy,
+                       a.tri.color);
+      break;
+    case DL_FILLTRIANGLE:
+      dst.fillTriangle(a.tri.xy[0] + dx, a.tri.xy[1] + dy, a.tri.xy[2] + dx,
+                       a.tri.xy[3] + dy, a.tri.xy[4] + dx, a.tri.xy[5] + dy,
+                       a.tri.color);
+      break;
+    case DL_ROUNDRECT:
+      dst.drawRoundRect(a.rrect.x + dx, a.rrect.y + dy, a.rrect.w, a.rrect.h,
+                        a.rrect.r, a.rrect.color);
+      break;
+    case DL_FILLROUNDRECT:
+      dst.fillRoundRect(a.rrect.x + dx, a.rrect.y + dy, a.rrect.w, a.rrect.h,
+                        a.rrect.r, a.rrect.color);
+      break;
+    case DL_CHAR:
+      dst.setFont(a.chr.font);
+      fonted = true;
+      dst.drawCodepoint(a.chr.x + dx, a.chr.y + dy, a.chr.c, a.chr.color,
+                        a.chr.bg, a.chr.size_x, a.chr.size_y);
+      break;
+    case DL_BITMAP:
+      if (a.bmp.flags & DL_XBM)
+        dst.drawXBitmap(a.bmp.x + dx, a.bmp.y + dy, a.bmp.bitmap, a.bmp.w,
+                        a.bmp.h, a.bmp.color);
+      else if (a.bmp.flags & DL_RAM) {
+        uint8_t *bitmap = (uint8_t *)a.bmp.bitmap;
+        if (a.bmp.flags & DL_BG)
+          dst.drawBitmap(a.bmp.x + dx, a.bmp.y + dy, bitmap, a.bmp.w, a.bmp.h,
+                         a.bmp.color, a.bmp.bg);
+        else
+          dst.drawBitmap(a.bmp.x + dx, a.bmp.y + dy, bitmap, a.bmp.w, a.bmp.h,
+                         a.bmp.color);
+      } else if (a.bmp.flags & DL_BG)
+        dst.drawBitmap(a.bmp.x + dx, a.bmp.y + dy, a.bmp.bitmap, a.bmp.w,
+                       a.bmp.h, a.bmp.color, a.bmp.bg);
+      else
+        dst.drawBitmap(a.bmp.x + dx, a.bmp.y + dy, a.bmp.bitmap, a.bmp.w,
+                       a.bmp.h, a.bmp.color);
+      break;
+    case DL_RGBBITMAP:
+      if (!(a.rgb.flags & DL_RAM)) {
+        if (a.rgb.mask)
+          dst.drawRGBBitmap(a.rgb.x + dx, a.rgb.y + dy, a.rgb.bitmap,
+                            a.rgb.mask, a.rgb.w, a.rgb.h);
+        else
+          dst.drawRGBBitmap(a.rgb.x + dx, a.rgb.y + dy, a.rgb.bitmap, a.rgb.w,
+                            a.rgb.h);
+      } else if (a.rgb.mask)
+        dst.drawRGBBitmap(a.rgb.x + dx, a.rgb.y + dy, (uint16_t *)a.rgb.bitmap,
+                          (uint8_t *)a.rgb.mask, a.rgb.w, a.rgb.h);
+      else
+        dst.drawRGBBitmap(a.rgb.x + dx, a.rgb.y + dy, (uint16_t *)a.rgb.bitmap,
+                          a.rgb.w, a.rgb.h);
+      break;
+    case DL_CLIP:
+      if (dst.pushClipRect(a.rect.x + dx, a.rect.y + dy, a.rect.w,
+                           a.rect.h)) {
+        pushed |= 1UL << level;
+        dst.getClipRect(&cx, &cy, &cw, &ch);
+      }
+      level++;
+      break;
+    }
+  }
+  while (level) {
+    if (pushed & (1UL << --level))
+      dst.popClipRect();
+  }
+  if (bounded)
+    dst.popClipRect();
+  if (fonted) {
+    if (chain)
+      dst.setFontChain(chain, chainLength);
+    else
+      dst.setFont(font);
+  }
+  dst.setCursor(x, y); // setFont() moves it
+}
+
+/**************************************************************************/
+/*!
+   @brief    Redraw one rectangle of the target from the list: push it as a
+             clip rect, replay the list (so only the commands that touch it
+             are drawn) and pop it again. The list should paint every pixel
+             it is expected to restore, e.g. by starting with fillScreen().
+   @param    dst  Target to draw to
+   @param    x    Left edge of the rectangle
+   @param    y    Top edge
+   @param    w    Width in pixels
+   @param    h    Height in pixels
+*/
+/**************************************************************************/
+template <class GFX>
+void GFXDisplayList::redrawTo(GFX &dst, int16_t x, int16_t y, int16_t w,
+                              int16_t h) const {
+  if (dst.pushClipRect(x, y, w, h)) {
+    replayTo(dst, 0, 0);
+    dst.popClipRect();
+  } else { // Clip stack full: redraw everything instead
+    replayTo(dst, 0, 0);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the list onto any Adafruit_GFX, shifted by (dx,dy). Only
+             the commands whose bounding box meets the target's clip rect
+             are drawn. The list's own clip rects are pushed onto the
+             target's stack as they come up, and popped by the end. The
+             target's font (or font chain) and cursor are kept.
+   @param    dst  Target to draw to, in the same rotation as the list
+   @param    dx   Offset added to every x coordinate
+   @param    dy   Offset added to every y coordinate
+*/
+/**************************************************************************/
+void GFXDisplayList::replay(Adafruit_GFX &dst, int16_t dx, int16_t dy) const {
+  replayTo(dst, dx, dy);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the list onto a GFXcanvas16 (or GFXRenderer of one),
+             shifted by (dx,dy), as replay(Adafruit_GFX &) but with the
+             canvas' own bitmap copies
+   @param    dst  Canvas to draw to, in the same rotation as the list
+   @param    dx   Offset added to every x coordinate
+   @param    dy   Offset added to every y coordinate
+*/
+/**************************************************************************/
+void GFXDisplayList::replay(GFXcanvas16 &dst, int16_t dx, int16_t dy) const {
+  replayTo(dst, dx, dy);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Redraw only the part of any Adafruit_GFX that falls inside a
+             rectangle, from the commands that touch it
+   @param    dst  Target to draw to, in the same rotation as the list
+   @param    x    Left edge of the rectangle
+   @param    y    Top edge
+   @param    w    Width in pixels
+   @param    h    Height in pixels
+*/
+/**************************************************************************/
+void GFXDisplayList::redraw(Adafruit_GFX &dst, int16_t x, int16_t y,
+                            int16_t w, int16_t h) const {
+  redrawTo(dst, x, y, w, h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Redraw only the part of a GFXcanvas16 that falls inside a
+             rectangle, from the commands that touch it
+   @param    dst  Canvas to draw to, in the same rotation as the list
+   @param    x    Left edge of the rectangle
+   @param    y    Top edge
+   @param    w    Width in pixels
+   @param    h    Height in pixels
+*/
+/**************************************************************************/
+void GFXDisplayList::redraw(GFXcanvas16 &dst, int16_t x, int16_t y,
+                            int16_t w, int16_t h) const {
+  redrawTo(dst, x, y, w, h);
+}
+
+#if !defined(__AVR_ATtiny85__)
+/**************************************************************************/
+/*!
+   @brief    Draw the list onto a display, shifted by (dx,dy), as
+             replay(Adafruit_GFX &) but with the display's own bitmap
+             routines, which send a whole bitmap through one window
+   @param    dst  Display to draw to, in the same rotation as the list
+   @param    dx   Offset added to every x coordinate
+   @param    dy   Offset added to every y coordinate
+*/
+/**************************************************************************/
+void GFXDisplayList::replay(Adafruit_SPITFT &dst, int16_t dx,
+                            int16_t dy) const {
+  replayTo(dst, dx, dy);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Redraw only the part of a display that falls inside a
+             rectangle, from the commands that touch it
+   @param    dst  Display to draw to, in the same rotation as the list
+   @param    x    Left edge of the rectangle
+   @param    y    Top edge
+   @param    w    Width in pixels
+   @param    h    Height in pixels
+*/
+/**************************************************************************/
+void GFXDisplayList::redraw(Adafruit_SPITFT &dst, int16_t x, int16_t y,
+                            int16_t w, int16_t h) const {
+  redrawTo(dst, x, y, w, h);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Render the list to a display, one band of rows at a time: clear
+             the band canvas to bg, draw the commands that fall on it and
+             send it with one address window and writePixels(). The
+             display shows the whole frame once done, without any of the
+             intermediate steps. The list and display must have the same
+             rotation.
+   @param    tft   Display to draw to, at least as big as the list
+   @param    band  Canvas to compose each band in. As wide as the list and
+                   unrotated; its height sets the band height.
+   @param    bg    Color the band is cleared to ahead of each band
+   @return   true on success, false if the list or band has no buffer or
+             the sizes don't fit
+*/
+/**************************************************************************/
+bool GFXDisplayList::renderBands(Adafruit_SPITFT &tft, GFXcanvas16 &band,
+                                 uint16_t bg) const {
+  uint16_t *pixels = band.getBuffer();
+  if (!list || !pixels || band.getRotation() || (band.width() != _width) ||
+      (_width > tft.width()) || (_height > tft.height()))
+    return false;
+  for (int32_t top = 0; top < _height; top += band.height()) {
+    int16_t rows = min((int32_t)band.height(), _height - top);
+    band.fillScreen(bg);
+    replayTo(band, 0, -top);
+    tft.startWrite();
+    tft.setAddrWindow(0, top, _width, rows);
+    tft.writePixels(pixels, (uint32_t)_width * rows);
+    tft.endWrite();
+  }
+  return true;
+}
+#endif
@@ -0,0 +1,183 @@
+/*!
+ * @file Adafruit_GFXDisplayList.h
+ *
+ * Part of Adafruit's GFX graphics library. GFXDisplayList is an
+ * Adafruit_GFX that draws nothing: it records the calls made on it (rects,
+ * lines, circles, round rects, triangles, text and bitmaps) as a compact
+ * list of commands, each tagged with its bounding box. The list can then
+ * be replayed onto any Adafruit_GFX, skipping the commands that fall
+ * outside the target's clip rect, so a static screen (a menu, a keypad)
+ * is laid out once and any part of it redrawn cheaply later:
+ *
+ *   GFXDisplayList menu(320, 240);
+ *   menu.fillScreen(0);
+ *   menu.setCursor(10, 10);
+ *   menu.print("Settings");
+ *   ...
+ *   menu.replay(tft);                    // Everything
+ *   menu.redraw(tft, 0, 100, 320, 20);   // Just what a popup covered
+ *
+ * It can also be rendered to a display one horizontal band at a time
+ * through a small GFXcanvas16, so a full frame is composed off-screen and
+ * sent without flicker, in a fraction of the RAM of a full-screen canvas:
+ *
+ *   GFXcanvas16 band(320, 16); // 10 KB instead of 150 KB
+ *   menu.renderBands(tft, band);
+ *
+ * Bitmaps and fonts are recorded by reference and must stay valid while
+ * the list is in use. Calls that the list does not record compactly (or
+ * that are made through an Adafruit_GFX reference, where they are not
+ * virtual) still work: they reach the list as the rects, lines and pixels
+ * they are drawn with.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFXDISPLAYLIST_H_
+#define _ADAFRUIT_GFXDISPLAYLIST_H_
+
+#include "Adafruit_GFX.h"
+#if !defined(__AVR_ATtiny85__)
+#include "Adafruit_SPITFT.h"
+#endif
+
+// Bytes of command buffer a GFXDisplayList allocates unless told otherwise
+#if !defined(GFX_DISPLAYLIST_SIZE)
+#if defined(__AVR__)
+#define GFX_DISPLAYLIST_SIZE 512 ///< Default command buffer on AVR
+#else
+#define GFX_DISPLAYLIST_SIZE 4096 ///< Default command buffer
+#endif
+#endif
+
+/// An Adafruit_GFX that records drawing calls, to replay them later
+class GFXDisplayList : public Adafruit_GFX {
+public:
+  GFXDisplayList(uint16_t w, uint16_t h, uint32_t size = GFX_DISPLAYLIST_SIZE);
+  GFXDisplayList(uint16_t w, uint16_t h, uint8_t *buffer, uint32_t size);
+  ~GFXDisplayList(void);
+  GFXDisplayList(const GFXDisplayList &) = delete;
+  GFXDisplayList &operator=(const GFXDisplayList &) = delete;
+
+  void clear(void);
+  /**********************************************************************/
+  /*!
+    @brief    Get the command buffer
+    @returns  Pointer to the buffer, NULL if it could not be allocated
+  */
+  /**********************************************************************/
+  const uint8_t *getBuffer(void) const { return list; }
+  /**********************************************************************/
+  /*!
+    @brief    Bytes of command buffer in use
+    @returns  Length of the recorded list
+  */
+  /**********************************************************************/
+  uint32_t length(void) const { return used; }
+  /**********************************************************************/
+  /*!
+    @brief    Check whether commands were dropped since the last clear(),
+              because the buffer was full. The list then only holds the
+              commands before the first one that did not fit.
+    @returns  true if the list is incomplete
+  */
+  /**********************************************************************/
+  bool overflowed(void) const { return full; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void writePixel(int16_t x, int16_t y, uint16_t color);
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color);
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color);
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color);
+  size_t write(uint8_t c);
+  size_t writeCodepoint(uint32_t c);
+
+  // Recorded as one command each when called on a GFXDisplayList
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+                    int16_t y2, uint16_t color);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+                    int16_t y2, uint16_t color);
+  void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                     int16_t radius, uint16_t color);
+  void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h,
+                     int16_t radius, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color, uint16_t bg);
+  void drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                   int16_t h, uint16_t color);
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w,
+                     int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                     int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                     const uint8_t mask[], int16_t w, int16_t h);
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask,
+                     int16_t w, int16_t h);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                uint16_t bg, uint8_t size);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                uint16_t bg, uint8_t size_x, uint8_t size_y);
+  void drawCodepoint(int16_t x, int16_t y, uint32_t c, uint16_t color,
+                     uint16_t bg, uint8_t size_x, uint8_t size_y);
+  bool pushClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void popClipRect(void);
+
+  void replay(Adafruit_GFX &dst, int16_t dx = 0, int16_t dy = 0) const;
+  void replay(GFXcanvas16 &dst, int16_t dx = 0, int16_t dy = 0) const;
+  void redraw(Adafruit_GFX &dst, int16_t x, int16_t y, int16_t w,
+              int16_t h) const;
+  void redraw(GFXcanvas16 &dst, int16_t x, int16_t y, int16_t w,
+              int16_t h) const;
+#if !defined(__AVR_ATtiny85__)
+  void replay(Adafruit_SPITFT &dst, int16_t dx = 0, int16_t dy = 0) const;
+  void redraw(Adafruit_SPITFT &dst, int16_t x, int16_t y, int16_t w,
+              int16_t h) const;
+  bool renderBands(Adafruit_SPITFT &tft, GFXcanvas16 &band,
+                   uint16_t bg = 0) const;
+#endif
+
+private:
+  template <class GFX> void replayTo(GFX &dst, int16_t dx, int16_t dy) const;
+  template <class GFX>
+  void redrawTo(GFX &dst, int16_t x, int16_t y, int16_t w, int16_t h) const;
+  bool visible(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+  void put(uint8_t op, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+           const void *args);
+  void putRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+  void putBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w,
+                 int16_t h, uint16_t color, uint16_t bg, uint8_t flags);
+  void putRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                    const uint8_t *mask, int16_t w, int16_t h, uint8_t flags);
+  void putChar(int16_t x, int16_t y, uint32_t c, uint16_t color,
+               uint16_t bg, uint8_t size_x, uint8_t size_y);
+  uint8_t *list;  ///< Command buffer
+  uint32_t size;  ///< Capacity of list in bytes
+  uint32_t used;  ///< Bytes of list recorded
+  int16_t capX0;  ///< Left-most column drawn while capturing
+  int16_t capY0;  ///< Top row drawn while capturing
+  int16_t capX1;  ///< Right-most column drawn while capturing
+  int16_t capY1;  ///< Bottom row drawn while capturing
+  bool full;      ///< A command did not fit since the last clear()
+  bool owned;     ///< list was allocated here and is freed on destruction
+  bool capturing; ///< Primitives only extend the capture box, not record
+};
+
+#endif // _ADAFRUIT_GFXDISPLAYLIST_H_
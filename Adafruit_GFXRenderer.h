@@ -0,0 +1,851 @@
+/*!
+ * @file Adafruit_GFXRenderer.h
+ *
+ * Part of Adafruit's GFX graphics library. GFXRenderer is a statically
+ * dispatched front-end for the GFX canvases: the same drawing calls as
+ * Adafruit_GFX, but each pixel and span goes straight to the canvas
+ * buffer through inline, non-virtual calls rather than through virtual
+ * writePixel()/writeFastHLine(), so the compiler can inline the buffer
+ * stores and tight loops (circles, bitmaps, fills) reduce to pointer
+ * arithmetic. The shapes are rasterized by the same templates as in
+ * Adafruit_GFX (see Adafruit_GFXShapes.h), so the pixels are identical.
+ *
+ * Declare the canvas as, for example,
+ *
+ *   GFXRenderer<GFXcanvas16> canvas(320, 240);
+ *
+ * instead of GFXcanvas16. It still is a GFXcanvas16 (and an Adafruit_GFX),
+ * so text, getBuffer() and code taking an Adafruit_GFX& work as before;
+ * calls made on the renderer type itself are resolved at compile time.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFXRENDERER_H_
+#define _ADAFRUIT_GFXRENDERER_H_
+
+#include "Adafruit_GFX.h"
+#include "Adafruit_GFXShapes.h"
+
+/*!
+  @brief  Drawing front-end that calls the Device's raw pixel and span
+          routines directly. Device must be an Adafruit_GFX subclass that
+          provides getBuffer() (NULL if there is nothing to draw into) and,
+          public or protected, drawRawPixel(), drawFastRawHLine() and
+          drawFastRawVLine(), all taking unclipped rotation-0 coordinates.
+          GFXcanvas1, GFXcanvas8 and GFXcanvas16 qualify. Rotation and
+          the clip rect are applied here, once per span where possible.
+*/
+template <class Device> class GFXRenderer : public Device {
+public:
+  using Device::Device; ///< Same constructors as the Device
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a pixel, clipped
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (this->getBuffer())
+      pixel(x, y, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a pixel, clipped. Same as drawPixel() on a canvas.
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void writePixel(int16_t x, int16_t y, uint16_t color) {
+    if (this->getBuffer())
+      pixel(x, y, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a horizontal line, clipped
+    @param  x      Left-most x coordinate
+    @param  y      Row y coordinate
+    @param  w      Width in pixels, negative to extend left of x
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (this->getBuffer())
+      hline(x, y, w, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a horizontal line, clipped. Same as drawFastHLine().
+    @param  x      Left-most x coordinate
+    @param  y      Row y coordinate
+    @param  w      Width in pixels, negative to extend left of x
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (this->getBuffer())
+      hline(x, y, w, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a vertical line, clipped
+    @param  x      Column x coordinate
+    @param  y      Top-most y coordinate
+    @param  h      Height in pixels, negative to extend above y
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (this->getBuffer())
+      vline(x, y, h, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a vertical line, clipped. Same as drawFastVLine().
+    @param  x      Column x coordinate
+    @param  y      Top-most y coordinate
+    @param  h      Height in pixels, negative to extend above y
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (this->getBuffer())
+      vline(x, y, h, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a rectangle, clipped
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels, negative to extend left of x
+    @param  h      Height in pixels, negative to extend above y
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (this->getBuffer())
+      rect(x, y, w, h, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a rectangle, clipped. Same as fillRect().
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels, negative to extend left of x
+    @param  h      Height in pixels, negative to extend above y
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color) {
+    if (this->getBuffer())
+      rect(x, y, w, h, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a batch of horizontal spans, clipped
+    @param  spans  Array of spans, each with a positive width
+    @param  count  Number of spans in the array
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color) {
+    if (this->getBuffer()) {
+      while (count--) {
+        hline(spans->x, spans->y, spans->w, color);
+        spans++;
+      }
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a line. Same pixels as Adafruit_GFX::drawLine().
+    @param  x0     Start point x coordinate
+    @param  y0     Start point y coordinate
+    @param  x1     End point x coordinate
+    @param  y1     End point y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color) {
+    if (this->getBuffer())
+      line(x0, y0, x1, y1, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a line. Same as drawLine().
+    @param  x0     Start point x coordinate
+    @param  y0     Start point y coordinate
+    @param  x1     End point x coordinate
+    @param  y1     End point y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color) {
+    if (this->getBuffer())
+      line(x0, y0, x1, y1, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a rectangle outline
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (this->getBuffer()) {
+      hline(x, y, w, color);
+      hline(x, y + h - 1, w, color);
+      vline(x, y, h, color);
+      vline(x + w - 1, y, h, color);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a circle outline. Same pixels as Adafruit_GFX.
+    @param  x0     Center-point x coordinate
+    @param  y0     Center-point y coordinate
+    @param  r      Radius of circle
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (!this->getBuffer())
+      return;
+    if (inside((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+               (int32_t)y0 + r)) {
+      Sink<false> s(this, color);
+      gfxCircle(s, x0, y0, r);
+    } else {
+      Sink<true> s(this, color);
+      gfxCircle(s, x0, y0, r);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Quarter-circle outline, used for circles and round-rects
+    @param  x0          Center-point x coordinate
+    @param  y0          Center-point y coordinate
+    @param  r           Radius of circle
+    @param  cornername  Mask bits indicating which quarters we're doing
+    @param  color       Color to draw with
+  */
+  /**********************************************************************/
+  void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername,
+                        uint16_t color) {
+    if (!this->getBuffer())
+      return;
+    if (inside((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+               (int32_t)y0 + r)) {
+      Sink<false> s(this, color);
+      gfxCircleQuarters(s, x0, y0, r, cornername);
+    } else {
+      Sink<true> s(this, color);
+      gfxCircleQuarters(s, x0, y0, r, cornername);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a filled circle. Same pixels as Adafruit_GFX.
+    @param  x0     Center-point x coordinate
+    @param  y0     Center-point y coordinate
+    @param  r      Radius of circle
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (this->getBuffer()) {
+      Sink<true> s(this, color);
+      gfxFillCircle(s, x0, y0, r);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Quarter-circle fill, used for circles and round-rects
+    @param  x0       Center-point x coordinate
+    @param  y0       Center-point y coordinate
+    @param  r        Radius of circle
+    @param  corners  Mask bits indicating which quarters we're doing
+    @param  delta    Offset from center-point, used for round-rects
+    @param  color    Color to fill with
+  */
+  /**********************************************************************/
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                        int16_t delta, uint16_t color) {
+    if (this->getBuffer()) {
+      Sink<true> s(this, color);
+      gfxFillCircleQuarters(s, x0, y0, r, corners, delta);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a rounded rectangle outline
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  r      Radius of corner rounding
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color) {
+    if (!this->getBuffer())
+      return;
+    if (inside(x, y, (int32_t)x + w - 1, (int32_t)y + h - 1)) {
+      Sink<false> s(this, color);
+      gfxRoundRect(s, x, y, w, h, r);
+    } else {
+      Sink<true> s(this, color);
+      gfxRoundRect(s, x, y, w, h, r);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a filled rounded rectangle
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  r      Radius of corner rounding
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color) {
+    if (this->getBuffer()) {
+      Sink<true> s(this, color);
+      gfxFillRoundRect(s, x, y, w, h, r);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a triangle outline
+    @param  x0     Vertex #0 x coordinate
+    @param  y0     Vertex #0 y coordinate
+    @param  x1     Vertex #1 x coordinate
+    @param  y1     Vertex #1 y coordinate
+    @param  x2     Vertex #2 x coordinate
+    @param  y2     Vertex #2 y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color) {
+    if (this->getBuffer()) {
+      line(x0, y0, x1, y1, color);
+      line(x1, y1, x2, y2, color);
+      line(x2, y2, x0, y0, color);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a filled triangle. Same pixels as Adafruit_GFX.
+    @param  x0     Vertex #0 x coordinate
+    @param  y0     Vertex #0 y coordinate
+    @param  x1     Vertex #1 x coordinate
+    @param  y1     Vertex #1 y coordinate
+    @param  x2     Vertex #2 x coordinate
+    @param  y2     Vertex #2 y coordinate
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color) {
+    if (this->getBuffer()) {
+      Sink<true> s(this, color);
+      gfxFillTriangle(s, x0, y0, x1, y1, x2, y2);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a PROGMEM-resident 1-bit image, unset bits transparent
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with monochrome bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  color   Color to draw set bits with
+  */
+  /**********************************************************************/
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color) {
+    bits<true, false>(x, y, bitmap, w, h,
+                      [&](int16_t i, int16_t j, bool set) {
+                        if (set)
+                          put(x + i, y + j, color);
+                      });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a PROGMEM-resident 1-bit image with a background color
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with monochrome bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  color   Color to draw set bits with
+    @param  bg      Color to draw unset bits with
+  */
+  /**********************************************************************/
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t color, uint16_t bg) {
+    bits<true, false>(x, y, bitmap, w, h,
+                      [&](int16_t i, int16_t j, bool set) {
+                        put(x + i, y + j, set ? color : bg);
+                      });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a RAM-resident 1-bit image, unset bits transparent
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with monochrome bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  color   Color to draw set bits with
+  */
+  /**********************************************************************/
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color) {
+    bits<false, false>(x, y, bitmap, w, h,
+                       [&](int16_t i, int16_t j, bool set) {
+                         if (set)
+                           put(x + i, y + j, color);
+                       });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a RAM-resident 1-bit image with a background color
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with monochrome bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  color   Color to draw set bits with
+    @param  bg      Color to draw unset bits with
+  */
+  /**********************************************************************/
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h,
+                  uint16_t color, uint16_t bg) {
+    bits<false, false>(x, y, bitmap, w, h,
+                       [&](int16_t i, int16_t j, bool set) {
+                         put(x + i, y + j, set ? color : bg);
+                       });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a PROGMEM-resident XBitMap (*.xbm) image
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with monochrome bitmap, LSB first
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+    @param  color   Color to draw set bits with
+  */
+  /**********************************************************************/
+  void drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                   int16_t h, uint16_t color) {
+    bits<true, true>(x, y, bitmap, w, h, [&](int16_t i, int16_t j, bool set) {
+      if (set)
+        put(x + i, y + j, color);
+    });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a PROGMEM-resident 8-bit (grayscale) image.
+            The Device copies it straight into its buffer if it takes
+            the format (see drawImageFast()), else it goes pixel by pixel.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with grayscale bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                           int16_t w, int16_t h) {
+    int16_t i0, j0, i1, j1;
+    if (!this->getBuffer() ||
+        Device::drawImageFast(x, y, bitmap, true, GFX_IMAGE_GRAY8, w, h, 0,
+                              0) ||
+        !this->clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+      return;
+    for (int16_t j = j0; j < j1; j++)
+      for (int16_t i = i0; i < i1; i++)
+        put(x + i, y + j, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a RAM-resident 8-bit (grayscale) image.
+            The Device copies it straight into its buffer if it takes
+            the format (see drawImageFast()), else it goes pixel by pixel.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with grayscale bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                           int16_t h) {
+    int16_t i0, j0, i1, j1;
+    if (!this->getBuffer() ||
+        Device::drawImageFast(x, y, bitmap, false, GFX_IMAGE_GRAY8, w, h, 0,
+                              0) ||
+        !this->clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+      return;
+    for (int16_t j = j0; j < j1; j++)
+      for (int16_t i = i0; i < i1; i++)
+        put(x + i, y + j, bitmap[j * w + i]);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a PROGMEM-resident 8-bit (grayscale) image with a 1-bit
+            mask (set bits = opaque). Both buffers must be in PROGMEM.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with grayscale bitmap
+    @param  mask    Byte array with mask bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawGrayscaleBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                           const uint8_t mask[], int16_t w, int16_t h) {
+    bits<true, false>(x, y, mask, w, h, [&](int16_t i, int16_t j, bool set) {
+      if (set)
+        put(x + i, y + j, (uint8_t)pgm_read_byte(&bitmap[j * w + i]));
+    });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a RAM-resident 8-bit (grayscale) image with a 1-bit mask
+            (set bits = opaque). Both buffers must be in RAM.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Byte array with grayscale bitmap
+    @param  mask    Byte array with mask bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                           uint8_t *mask, int16_t w, int16_t h) {
+    bits<false, false>(x, y, mask, w, h, [&](int16_t i, int16_t j, bool set) {
+      if (set)
+        put(x + i, y + j, bitmap[j * w + i]);
+    });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a PROGMEM-resident 16-bit (RGB 5/6/5) image.
+            The Device copies it straight into its buffer if it takes
+            the format (see drawImageFast()), else it goes pixel by pixel.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Array with 16-bit color bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w,
+                     int16_t h) {
+    int16_t i0, j0, i1, j1;
+    if (!this->getBuffer() ||
+        Device::drawImageFast(x, y, bitmap, true, GFX_IMAGE_RGB565, w, h, 0,
+                              0) ||
+        !this->clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+      return;
+    for (int16_t j = j0; j < j1; j++)
+      for (int16_t i = i0; i < i1; i++)
+        put(x + i, y + j, pgm_read_word(&bitmap[j * w + i]));
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a RAM-resident 16-bit (RGB 5/6/5) image.
+            The Device copies it straight into its buffer if it takes
+            the format (see drawImageFast()), else it goes pixel by pixel.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Array with 16-bit color bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w,
+                     int16_t h) {
+    int16_t i0, j0, i1, j1;
+    if (!this->getBuffer() ||
+        Device::drawImageFast(x, y, bitmap, false, GFX_IMAGE_RGB565, w, h, 0,
+                              0) ||
+        !this->clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+      return;
+    for (int16_t j = j0; j < j1; j++)
+      for (int16_t i = i0; i < i1; i++)
+        put(x + i, y + j, bitmap[j * w + i]);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a PROGMEM-resident 16-bit (RGB 5/6/5) image with a 1-bit
+            mask (set bits = opaque). Both buffers must be in PROGMEM.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Array with 16-bit color bitmap
+    @param  mask    Byte array with mask bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
+                     const uint8_t mask[], int16_t w, int16_t h) {
+    bits<true, false>(x, y, mask, w, h, [&](int16_t i, int16_t j, bool set) {
+      if (set)
+        put(x + i, y + j, pgm_read_word(&bitmap[j * w + i]));
+    });
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a RAM-resident 16-bit (RGB 5/6/5) image with a 1-bit mask
+            (set bits = opaque). Both buffers must be in RAM.
+    @param  x       Top left corner x coordinate
+    @param  y       Top left corner y coordinate
+    @param  bitmap  Array with 16-bit color bitmap
+    @param  mask    Byte array with mask bitmap
+    @param  w       Width of bitmap in pixels
+    @param  h       Height of bitmap in pixels
+  */
+  /**********************************************************************/
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask,
+                     int16_t w, int16_t h) {
+    bits<false, false>(x, y, mask, w, h, [&](int16_t i, int16_t j, bool set) {
+      if (set)
+        put(x + i, y + j, bitmap[j * w + i]);
+    });
+  }
+
+private:
+  // Everything below takes logical (rotated) coordinates, calls nothing
+  // virtual and assumes the caller has checked getBuffer().
+
+  // One visible pixel, mapped to the device's raw coordinates
+  void put(int16_t x, int16_t y, uint16_t color) {
+    switch (this->getRotation()) {
+    case 0:
+      this->drawRawPixel(x, y, color);
+      break;
+    case 1:
+      this->drawRawPixel(this->WIDTH - 1 - y, x, color);
+      break;
+    case 2:
+      this->drawRawPixel(this->WIDTH - 1 - x, this->HEIGHT - 1 - y, color);
+      break;
+    default:
+      this->drawRawPixel(y, this->HEIGHT - 1 - x, color);
+      break;
+    }
+  }
+
+  // A visible, non-empty horizontal run; a raw column when rotated 90/270
+  void runH(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    switch (this->getRotation()) {
+    case 0:
+      this->drawFastRawHLine(x, y, w, color);
+      break;
+    case 1:
+      this->drawFastRawVLine(this->WIDTH - 1 - y, x, w, color);
+      break;
+    case 2:
+      this->drawFastRawHLine(this->WIDTH - x - w, this->HEIGHT - 1 - y, w,
+                             color);
+      break;
+    default:
+      this->drawFastRawVLine(y, this->HEIGHT - x - w, w, color);
+      break;
+    }
+  }
+
+  // A visible, non-empty vertical run; a raw row when rotated 90/270
+  void runV(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    switch (this->getRotation()) {
+    case 0:
+      this->drawFastRawVLine(x, y, h, color);
+      break;
+    case 1:
+      this->drawFastRawHLine(this->WIDTH - y - h, x, h, color);
+      break;
+    case 2:
+      this->drawFastRawVLine(this->WIDTH - 1 - x, this->HEIGHT - y - h, h,
+                             color);
+      break;
+    default:
+      this->drawFastRawHLine(y, this->HEIGHT - 1 - x, h, color);
+      break;
+    }
+  }
+
+  // True if the (inclusive) bounding box needs no per-pixel clipping
+  bool inside(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const {
+    return (x0 >= this->clipX0()) && (y0 >= this->clipY0()) &&
+           (x1 < this->clipX1()) && (y1 < this->clipY1());
+  }
+
+  void pixel(int16_t x, int16_t y, uint16_t color) {
+    if (!this->isClipped(x, y))
+      put(x, y, color);
+  }
+
+  void hline(int32_t x, int16_t y, int32_t w, uint16_t color) {
+    if ((y < this->clipY0()) || (y >= this->clipY1()))
+      return;
+    if (w < 0) {
+      x += w + 1;
+      w = -w;
+    }
+    int32_t x1 = x + w;
+    if (x < this->clipX0())
+      x = this->clipX0();
+    if (x1 > this->clipX1())
+      x1 = this->clipX1();
+    if (x1 > x)
+      runH(x, y, x1 - x, color);
+  }
+
+  void vline(int16_t x, int32_t y, int32_t h, uint16_t color) {
+    if ((x < this->clipX0()) || (x >= this->clipX1()))
+      return;
+    if (h < 0) {
+      y += h + 1;
+      h = -h;
+    }
+    int32_t y1 = y + h;
+    if (y < this->clipY0())
+      y = this->clipY0();
+    if (y1 > this->clipY1())
+      y1 = this->clipY1();
+    if (y1 > y)
+      runV(x, y, y1 - y, color);
+  }
+
+  // Filled rect as runs along raw rows: logical rows at 0/180 degrees,
+  // logical columns at 90/270
+  void rect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    if (w < 0) {
+      x += w + 1;
+      w = -w;
+    }
+    if (h < 0) {
+      y += h + 1;
+      h = -h;
+    }
+    int32_t x1 = x + w, y1 = y + h;
+    if (x < this->clipX0())
+      x = this->clipX0();
+    if (y < this->clipY0())
+      y = this->clipY0();
+    if (x1 > this->clipX1())
+      x1 = this->clipX1();
+    if (y1 > this->clipY1())
+      y1 = this->clipY1();
+    if ((x1 <= x) || (y1 <= y))
+      return;
+    if (this->getRotation() & 1) {
+      for (int16_t i = x; i < x1; i++)
+        runV(i, y, y1 - y, color);
+    } else {
+      for (int16_t j = y; j < y1; j++)
+        runH(x, j, x1 - x, color);
+    }
+  }
+
+  // Straight lines as one run, anything else through gfxLine()
+  void line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1) {
+      vline(x0, (y0 < y1) ? y0 : y1, abs(y1 - y0) + 1, color);
+    } else if (y0 == y1) {
+      hline((x0 < x1) ? x0 : x1, y0, abs(x1 - x0) + 1, color);
+    } else {
+      Sink<true> s(this, color);
+      gfxLine(s, x0, y0, x1, y1);
+    }
+  }
+
+  // Sink for the rasterizers in Adafruit_GFXShapes.h. CLIP is false when
+  // the whole shape is known to be inside the clip rect, so that single
+  // pixels skip the clip test; runs are always trimmed.
+  template <bool CLIP> class Sink {
+  public:
+    Sink(GFXRenderer *r, uint16_t color) : r(r), color(color) {}
+    bool isClipped(int32_t x0, int32_t y0, int32_t x1, int32_t y1) const {
+      return r->isClipped(x0, y0, x1, y1);
+    }
+    int16_t clipY0(void) const { return r->clipY0(); }
+    int16_t clipY1(void) const { return r->clipY1(); }
+    void pixel(int16_t x, int16_t y) {
+      if (!CLIP || !r->isClipped(x, y))
+        r->put(x, y, color);
+    }
+    void hline(int32_t x, int16_t y, int32_t w) { r->hline(x, y, w, color); }
+    void vline(int16_t x, int32_t y, int32_t h) { r->vline(x, y, h, color); }
+    void rect(int32_t x, int32_t y, int32_t w, int32_t h) {
+      r->rect(x, y, w, h, color);
+    }
+    void span(int32_t x, int16_t y, int32_t w) { r->hline(x, y, w, color); }
+
+  private:
+    GFXRenderer *r;
+    uint16_t color;
+  };
+
+  // Walk the visible part of a 1-bit image with gfxBits()
+  template <bool PGM, bool XBM, class Op>
+  void bits(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+            Op op) {
+    int16_t i0, j0, i1, j1;
+    if (this->getBuffer() && this->clipImage(x, y, w, h, &i0, &j0, &i1, &j1))
+      gfxBits<PGM, XBM>(bitmap, w, i0, j0, i1, j1, op);
+  }
+};
+
+#endif // _ADAFRUIT_GFXRENDERER_H_
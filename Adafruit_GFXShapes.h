@@ -0,0 +1,542 @@
+/*!
+ * @file Adafruit_GFXShapes.h
+ *
+ * Part of Adafruit's GFX graphics library. The line, circle, round-rect,
+ * triangle and 1-bit bitmap rasterizers, written once as templates over a
+ * "sink" that receives the pixels and runs they produce. Adafruit_GFX
+ * instantiates them with a sink that calls its virtual write*() functions;
+ * GFXRenderer instantiates them with one that goes straight to the canvas
+ * buffer, so both draw exactly the same pixels.
+ *
+ * A sink draws in a single color and provides:
+ *
+ *   bool isClipped(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+ *                                    true if none of the box can be seen
+ *   int16_t clipY0(), clipY1()       visible rows, as in Adafruit_GFX
+ *   void pixel(x, y)                 one pixel, clipped
+ *   void hline(x, y, w), vline(x, y, h), rect(x, y, w, h)
+ *                                    lines and rectangles, clipped
+ *   void span(x, y, w)               one row (w > 0) of a filled shape,
+ *                                    clipped, may be batched until end()
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFXSHAPES_H_
+#define _ADAFRUIT_GFXSHAPES_H_
+
+#include "Adafruit_GFX.h"
+
+/**************************************************************************/
+/*!
+    @brief  Bresenham line, with pixels collected into horizontal (or, for
+            steep lines, vertical) runs so that each run is one hline() or
+            vline() call
+    @param  s      Sink to draw into
+    @param  x0     Start point x coordinate
+    @param  y0     Start point y coordinate
+    @param  x1     End point x coordinate
+    @param  y1     End point y coordinate
+*/
+/**************************************************************************/
+template <class S>
+void gfxLine(S &s, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  int16_t t;
+#if defined(ESP8266)
+  yield();
+#endif
+  if (s.isClipped((x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1,
+                  (x0 < x1) ? x1 : x0, (y0 < y1) ? y1 : y0))
+    return;
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    t = x0, x0 = y0, y0 = t;
+    t = x1, x1 = y1, y1 = t;
+  }
+  if (x0 > x1) {
+    t = x0, x0 = x1, x1 = t;
+    t = y0, y0 = y1, y1 = t;
+  }
+
+  // 32 bits: a line from one end of the int16 range to the other is
+  // 65535 pixels long
+  int32_t dx = x1 - x0, dy = abs(y1 - y0);
+  int32_t err = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+
+  // Same steps as the per-pixel version, but a run only gets written out
+  // when the minor axis is about to step (or at the end of the line), so
+  // near-horizontal/vertical lines cost one call per run, not per pixel.
+  int32_t run = x0; // Start of the current run along the major axis
+  for (int32_t x = x0; x <= x1; x++) {
+    err -= dy;
+    if ((err < 0) || (x == x1)) {
+      int32_t len = x - run + 1;
+      if (len > 0x7FFF) { // Too long for the sink: cut off the part left
+        if (run < 0) {    // of 0 and the pixel at 0x7FFF, never drawn
+          len += run;
+          run = 0;
+        }
+        if (len > 0x7FFF)
+          len = 0x7FFF;
+      }
+      if (len == 1) {
+        if (steep)
+          s.pixel(y0, run);
+        else
+          s.pixel(run, y0);
+      } else if (len > 1) {
+        if (steep)
+          s.vline(y0, run, len);
+        else
+          s.hline(run, y0, len);
+      }
+      y0 += ystep;
+      err += dx;
+      run = x + 1;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Circle outline, one pixel() call per pixel
+    @param  s      Sink to draw into
+    @param  x0     Center-point x coordinate
+    @param  y0     Center-point y coordinate
+    @param  r      Radius of circle
+*/
+/**************************************************************************/
+template <class S> void gfxCircle(S &s, int16_t x0, int16_t y0, int16_t r) {
+#if defined(ESP8266)
+  yield();
+#endif
+  if (s.isClipped((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+                  (int32_t)y0 + r))
+    return;
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  s.pixel(x0, y0 + r);
+  s.pixel(x0, y0 - r);
+  s.pixel(x0 + r, y0);
+  s.pixel(x0 - r, y0);
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    s.pixel(x0 + x, y0 + y);
+    s.pixel(x0 - x, y0 + y);
+    s.pixel(x0 + x, y0 - y);
+    s.pixel(x0 - x, y0 - y);
+    s.pixel(x0 + y, y0 + x);
+    s.pixel(x0 - y, y0 + x);
+    s.pixel(x0 + y, y0 - x);
+    s.pixel(x0 - y, y0 - x);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Quarter-circle outlines, used for circles and round-rects
+    @param  s           Sink to draw into
+    @param  x0          Center-point x coordinate
+    @param  y0          Center-point y coordinate
+    @param  r           Radius of circle
+    @param  cornername  Mask bits indicating which quarters we're doing
+*/
+/**************************************************************************/
+template <class S>
+void gfxCircleQuarters(S &s, int16_t x0, int16_t y0, int16_t r,
+                       uint8_t cornername) {
+  if (s.isClipped((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+                  (int32_t)y0 + r))
+    return;
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (cornername & 0x4) {
+      s.pixel(x0 + x, y0 + y);
+      s.pixel(x0 + y, y0 + x);
+    }
+    if (cornername & 0x2) {
+      s.pixel(x0 + x, y0 - y);
+      s.pixel(x0 + y, y0 - x);
+    }
+    if (cornername & 0x8) {
+      s.pixel(x0 - y, y0 + x);
+      s.pixel(x0 - x, y0 + y);
+    }
+    if (cornername & 0x1) {
+      s.pixel(x0 - y, y0 - x);
+      s.pixel(x0 - x, y0 - y);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Filled quarter-circles, used for circles and round-rects
+    @param  s        Sink to draw into
+    @param  x0       Center-point x coordinate
+    @param  y0       Center-point y coordinate
+    @param  r        Radius of circle
+    @param  corners  Mask bits indicating which quarters we're doing
+    @param  delta    Offset from center-point, used for round-rects
+*/
+/**************************************************************************/
+template <class S>
+void gfxFillCircleQuarters(S &s, int16_t x0, int16_t y0, int16_t r,
+                           uint8_t corners, int16_t delta) {
+  if (s.isClipped((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+                  (int32_t)y0 + r + delta))
+    return;
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+
+  // The filled quarter is symmetric about its diagonal, so the classic
+  // column-by-column walk also gives the half-width of each row: column
+  // x0+x spanning rows y0-y..y0+y is the same shape as row y0-x spanning
+  // columns x0..x0+y. Rows make horizontal spans.
+  if ((r > 0) && (delta >= 0)) { // Rows level with the center(s)
+    if (corners & 1)
+      s.rect(x0 + 1, y0, r, delta + 1);
+    if (corners & 2)
+      s.rect(x0 - r, y0, r, delta + 1);
+  }
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    // These checks avoid double-drawing certain lines, important
+    // for the SSD1306 library which has an INVERT drawing mode.
+    if (x < (y + 1)) {
+      if (corners & 1) {
+        s.span(x0 + 1, y0 - x, y);
+        s.span(x0 + 1, y0 + x + delta, y);
+      }
+      if (corners & 2) {
+        s.span(x0 - y, y0 - x, y);
+        s.span(x0 - y, y0 + x + delta, y);
+      }
+    }
+    if (y != py) {
+      if (px > 0) { // Row of half-width 0 would be an empty span
+        if (corners & 1) {
+          s.span(x0 + 1, y0 - py, px);
+          s.span(x0 + 1, y0 + py + delta, px);
+        }
+        if (corners & 2) {
+          s.span(x0 - px, y0 - py, px);
+          s.span(x0 - px, y0 + py + delta, px);
+        }
+      }
+      py = y;
+    }
+    px = x;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the rounded top and bottom of a circle or round-rect whose
+            four corner arcs are centered on (x0,y0) to (x1,y1): the r rows
+            above y0 and the r rows below y1, as spans. Rows y0 to y1 are
+            left for the caller to fill.
+    @param  s      Sink to draw into
+    @param  x0     Left corner center x coordinate
+    @param  y0     Top corner center y coordinate
+    @param  x1     Right corner center x coordinate
+    @param  y1     Bottom corner center y coordinate
+    @param  r      Corner radius
+*/
+/**************************************************************************/
+template <class S>
+void gfxFillCaps(S &s, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 int16_t r) {
+  // Same walk as gfxFillCircleQuarters(), with both halves of each row and
+  // the gap between the corner centers merged into one span.
+  if (s.isClipped((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x1 + r,
+                  (int32_t)y1 + r))
+    return;
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+  int16_t gap = x1 - x0 + 1;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (x < (y + 1)) {
+      s.span(x0 - y, y0 - x, 2 * y + gap);
+      s.span(x0 - y, y1 + x, 2 * y + gap);
+    }
+    if (y != py) {
+      if ((2 * px + gap) > 0) {
+        s.span(x0 - px, y0 - py, 2 * px + gap);
+        s.span(x0 - px, y1 + py, 2 * px + gap);
+      }
+      py = y;
+    }
+    px = x;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Filled circle: the center row, then the caps above and below
+    @param  s      Sink to draw into
+    @param  x0     Center-point x coordinate
+    @param  y0     Center-point y coordinate
+    @param  r      Radius of circle
+*/
+/**************************************************************************/
+template <class S>
+void gfxFillCircle(S &s, int16_t x0, int16_t y0, int16_t r) {
+  if (s.isClipped((int32_t)x0 - r, (int32_t)y0 - r, (int32_t)x0 + r,
+                  (int32_t)y0 + r))
+    return;
+  s.hline(x0 - r, y0, 2 * r + 1);
+  gfxFillCaps(s, x0, y0, x0, y0, r);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Rounded rectangle outline
+    @param  s      Sink to draw into
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  r      Radius of corner rounding
+*/
+/**************************************************************************/
+template <class S>
+void gfxRoundRect(S &s, int16_t x, int16_t y, int16_t w, int16_t h,
+                  int16_t r) {
+  if (s.isClipped(x, y, (int32_t)x + w - 1, (int32_t)y + h - 1))
+    return;
+  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
+  if (r > max_radius)
+    r = max_radius;
+  s.hline(x + r, y, w - 2 * r);         // Top
+  s.hline(x + r, y + h - 1, w - 2 * r); // Bottom
+  s.vline(x, y + r, h - 2 * r);         // Left
+  s.vline(x + w - 1, y + r, h - 2 * r); // Right
+  gfxCircleQuarters(s, x + r, y + r, r, 1);
+  gfxCircleQuarters(s, x + w - r - 1, y + r, r, 2);
+  gfxCircleQuarters(s, x + w - r - 1, y + h - r - 1, r, 4);
+  gfxCircleQuarters(s, x + r, y + h - r - 1, r, 8);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Filled rounded rectangle: the straight-sided middle as one
+            rect(), then the rounded top and bottom as spans
+    @param  s      Sink to draw into
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  r      Radius of corner rounding
+*/
+/**************************************************************************/
+template <class S>
+void gfxFillRoundRect(S &s, int16_t x, int16_t y, int16_t w, int16_t h,
+                      int16_t r) {
+  if (s.isClipped(x, y, (int32_t)x + w - 1, (int32_t)y + h - 1))
+    return;
+  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
+  if (r > max_radius)
+    r = max_radius;
+  if (r > 0) {
+    if (h > 2 * r)
+      s.rect(x, y + r, w, h - 2 * r);
+    gfxFillCaps(s, x + r, y + r, x + w - r - 1, y + h - r - 1, r);
+  } else {
+    s.rect(x + r, y, w - 2 * r, h);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Filled triangle, one span per visible scanline
+    @param  s      Sink to draw into
+    @param  x0     Vertex #0 x coordinate
+    @param  y0     Vertex #0 y coordinate
+    @param  x1     Vertex #1 x coordinate
+    @param  y1     Vertex #1 y coordinate
+    @param  x2     Vertex #2 x coordinate
+    @param  y2     Vertex #2 y coordinate
+*/
+/**************************************************************************/
+template <class S>
+void gfxFillTriangle(S &s, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                     int16_t x2, int16_t y2) {
+  int16_t a, b, y, last, t;
+
+  // Sort coordinates by Y order (y2 >= y1 >= y0)
+  if (y0 > y1) {
+    t = y0, y0 = y1, y1 = t;
+    t = x0, x0 = x1, x1 = t;
+  }
+  if (y1 > y2) {
+    t = y2, y2 = y1, y1 = t;
+    t = x2, x2 = x1, x1 = t;
+  }
+  if (y0 > y1) {
+    t = y0, y0 = y1, y1 = t;
+    t = x0, x0 = x1, x1 = t;
+  }
+
+  int16_t cy0 = s.clipY0(), cy1 = s.clipY1();
+  a = (x0 < x1) ? x0 : x1;
+  b = (x0 < x1) ? x1 : x0;
+  if (s.isClipped((x2 < a) ? x2 : a, y0, (x2 > b) ? x2 : b, y2))
+    return;
+
+  if (y0 == y2) { // Handle awkward all-on-same-line case as its own thing
+    a = b = x0;
+    if (x1 < a)
+      a = x1;
+    else if (x1 > b)
+      b = x1;
+    if (x2 < a)
+      a = x2;
+    else if (x2 > b)
+      b = x2;
+    s.hline(a, y0, b - a + 1);
+    return;
+  }
+
+  int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+          dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa, sb;
+
+  // For upper part of triangle, find scanline crossings for segments
+  // 0-1 and 0-2.  If y1=y2 (flat-bottomed triangle), the scanline y1
+  // is included here (and second loop will be skipped, avoiding a /0
+  // error there), otherwise scanline y1 is skipped here and handled
+  // in the second loop...which also avoids a /0 error here if y0=y1
+  // (flat-topped triangle).
+  if (y1 == y2)
+    last = y1; // Include y1 scanline
+  else
+    last = y1 - 1; // Skip it
+
+  // Only scanlines inside the clip rect, starting the accumulators
+  // partway down if rows above it are skipped
+  y = (y0 < cy0) ? cy0 : y0;
+  if (last >= cy1)
+    last = cy1 - 1;
+  sa = (int32_t)dx01 * (y - y0);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= last; y++) {
+    a = x0 + sa / dy01;
+    b = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    /* longhand:
+    a = x0 + (x1 - x0) * (y - y0) / (y1 - y0);
+    b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
+    */
+    if (a > b)
+      t = a, a = b, b = t;
+    s.span(a, y, b - a + 1);
+  }
+
+  // For lower part of triangle, find scanline crossings for segments
+  // 0-2 and 1-2.  This loop is skipped if y1=y2.
+  if (y2 >= cy1)
+    y2 = cy1 - 1;
+  sa = (int32_t)dx12 * (y - y1);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= y2; y++) {
+    a = x1 + sa / dy12;
+    b = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    /* longhand:
+    a = x1 + (x2 - x1) * (y - y1) / (y2 - y1);
+    b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
+    */
+    if (a > b)
+      t = a, a = b, b = t;
+    s.span(a, y, b - a + 1);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Walk the visible part of a 1-bit image, as found by
+            Adafruit_GFX::clipImage(), calling op(i, j, set) per pixel
+    @param  bitmap  Byte array with the image: MSB-first rows padded to
+                    whole bytes, or LSB-first for XBM
+    @param  w       Width of the image in pixels
+    @param  i0      First visible column
+    @param  j0      First visible row
+    @param  i1      Column past the last visible one
+    @param  j1      Row past the last visible one
+    @param  op      Called with column, row and whether the bit is set
+*/
+/**************************************************************************/
+template <bool PGM, bool XBM, class Op>
+void gfxBits(const uint8_t *bitmap, int16_t w, int16_t i0, int16_t j0,
+             int16_t i1, int16_t j1, Op op) {
+  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+  uint8_t byte = 0;
+  for (int16_t j = j0; j < j1; j++) {
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i & 7) && (i > i0)) {
+        byte = XBM ? (byte >> 1) : (byte << 1);
+      } else {
+        byte = PGM ? pgm_read_byte(&bitmap[j * byteWidth + i / 8])
+                   : bitmap[j * byteWidth + i / 8];
+        byte = XBM ? (byte >> (i & 7)) : (byte << (i & 7));
+      }
+      op(i, j, XBM ? (byte & 0x01) : (byte & 0x80));
+    }
+  }
+}
+
+#endif // _ADAFRUIT_GFXSHAPES_H_
@@ -0,0 +1,764 @@
+/*!
+ * @file Adafruit_GFXcanvasT.h
+ *
+ * Part of Adafruit's GFX graphics library. GFXcanvasT is an offscreen
+ * canvas templated on its pixel format, so a canvas can match a panel's
+ * native format (and RAM footprint) instead of being limited to the
+ * 1-, 8- and 16-bit GFXcanvas classes. Clipping and rotation live in the
+ * template; each format only says how to pack a color, and how to store,
+ * read and fill pixels in one row of the buffer.
+ *
+ * Formats provided:
+ *   GFXformatGray2    2-bit gray, 4 pixels per byte
+ *   GFXformatGray4    4-bit gray, 2 pixels per byte (Adafruit_GrayOLED's
+ *                     4-bit layout: left pixel in the high nibble)
+ *   GFXformatRGB332   8-bit color
+ *   GFXformatRGB888   24-bit color, bytes R, G, B
+ *   GFXformatARGB8888 32-bit color, one native-endian word 0xAARRGGBB
+ *
+ * Colors passed to the drawing calls are gray levels for the gray formats
+ * (0 to 3, or 0 to 15) and RGB565 for the color formats, converted once
+ * per call rather than once per pixel.
+ *
+ * GFXcanvasIndexed<BITS> (GFXcanvasIndexed4, GFXcanvasIndexed8) stores
+ * 2-, 4- or 8-bit palette indices and turns them into RGB565 through a
+ * palette only as it sends them to a display: a quarter or half the RAM
+ * of a GFXcanvas16 for screens of few colors, and recoloring the whole
+ * canvas (palette animation) costs one setPaletteColor() call.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFXCANVAST_H_
+#define _ADAFRUIT_GFXCANVAST_H_
+
+#include "Adafruit_GFX.h"
+
+/*!
+  @brief  Packed gray, BITS (1, 2 or 4) per pixel, left-most pixel of
+          each byte in the most significant bits. Rows start on a byte.
+*/
+template <uint8_t BITS> struct GFXformatGray {
+  static const uint8_t bits = BITS; ///< Bits per pixel
+  typedef uint8_t value_t;          ///< Native pixel value
+
+  /*!
+    @brief  Convert a drawing color (gray level) to a pixel value
+    @param  color  Gray level, 0 to 2^BITS - 1
+    @returns  Pixel value
+  */
+  static value_t pack(uint16_t color) { return color & ((1 << BITS) - 1); }
+
+  /*!
+    @brief  Store one pixel
+    @param  row  Start of the pixel's row
+    @param  x    Raw x coordinate
+    @param  v    Pixel value
+  */
+  static void set(uint8_t *row, int16_t x, value_t v) {
+    uint8_t *p = &row[x / (8 / BITS)];
+    uint8_t shift = (8 / BITS - 1 - x % (8 / BITS)) * BITS;
+    *p = (*p & ~(((1 << BITS) - 1) << shift)) | (v << shift);
+  }
+
+  /*!
+    @brief  Read one pixel
+    @param  row  Start of the pixel's row
+    @param  x    Raw x coordinate
+    @returns  Pixel value
+  */
+  static value_t get(const uint8_t *row, int16_t x) {
+    uint8_t shift = (8 / BITS - 1 - x % (8 / BITS)) * BITS;
+    return (row[x / (8 / BITS)] >> shift) & ((1 << BITS) - 1);
+  }
+
+  /*!
+    @brief  Store a run of pixels in one row
+    @param  row  Start of the row
+    @param  x    Raw x coordinate of the first pixel
+    @param  w    Number of pixels, > 0
+    @param  v    Pixel value
+  */
+  static void fill(uint8_t *row, int16_t x, int16_t w, value_t v) {
+    for (; w && (x % (8 / BITS)); x++, w--) // Partial first byte
+      set(row, x, v);
+    int16_t bytes = w / (8 / BITS);
+    memset(&row[x / (8 / BITS)], v * (0xFF / ((1 << BITS) - 1)), bytes);
+    x += bytes * (8 / BITS);
+    for (w -= bytes * (8 / BITS); w; x++, w--) // Partial last byte
+      set(row, x, v);
+  }
+};
+
+typedef GFXformatGray<2> GFXformatGray2; ///< 2-bit gray
+typedef GFXformatGray<4> GFXformatGray4; ///< 4-bit gray, GrayOLED layout
+
+/*!
+  @brief  Palette indices, BITS (2, 4 or 8) per pixel, packed as in
+          GFXformatGray. Drawing colors are the indices themselves.
+*/
+template <uint8_t BITS> struct GFXformatIndex : public GFXformatGray<BITS> {};
+
+/*!
+  @brief  8-bit color, RRRGGGBB
+*/
+struct GFXformatRGB332 {
+  static const uint8_t bits = 8; ///< Bits per pixel
+  typedef uint8_t value_t;       ///< Native pixel value
+
+  /*!
+    @brief  Convert a drawing color to a pixel value
+    @param  color  16-bit 5-6-5 color
+    @returns  Pixel value, the top 3, 3 and 2 bits of R, G and B
+  */
+  static value_t pack(uint16_t color) {
+    return ((color >> 8) & 0xE0) | ((color >> 6) & 0x1C) |
+           ((color >> 3) & 0x03);
+  }
+  /*!
+    @brief  Store one pixel
+    @param  row  Start of the pixel's row
+    @param  x    Raw x coordinate
+    @param  v    Pixel value
+  */
+  static void set(uint8_t *row, int16_t x, value_t v) { row[x] = v; }
+  /*!
+    @brief  Read one pixel
+    @param  row  Start of the pixel's row
+    @param  x    Raw x coordinate
+    @returns  Pixel value
+  */
+  static value_t get(const uint8_t *row, int16_t x) { return row[x]; }
+  /*!
+    @brief  Store a run of pixels in one row
+    @param  row  Start of the row
+    @param  x    Raw x coordinate of the first pixel
+    @param  w    Number of pixels, > 0
+    @param  v    Pixel value
+  */
+  static void fill(uint8_t *row, int16_t x, int16_t w, value_t v) {
+    memset(&row[x], v, w);
+  }
+};
+
+// RGB565 to 0xRRGGBB, replicating the top bits into the low ones so that
+// full scale stays full scale
+static inline uint32_t gfxExpand565(uint16_t color) {
+  uint8_t r = (color >> 11) & 0x1F, g = (color >> 5) & 0x3F, b = color & 0x1F;
+  return ((uint32_t)((r << 3) | (r >> 2)) << 16) |
+         ((uint16_t)((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+}
+
+/*!
+  @brief  24-bit color, three bytes per pixel in R, G, B order
+*/
+struct GFXformatRGB888 {
+  static const uint8_t bits = 24; ///< Bits per pixel
+  typedef uint32_t value_t;       ///< Native pixel value, 0xRRGGBB
+
+  /*!
+    @brief  Convert a drawing color to a pixel value
+    @param  color  16-bit 5-6-5 color
+    @returns  Pixel value
+  */
+  static value_t pack(uint16_t color) { return gfxExpand565(color); }
+  /*!
+    @brief  Store one pixel
+    @param  row  Start of the pixel's row
+    @param  x    Raw x coordinate
+    @param  v    Pixel value
+  */
+  static void set(uint8_t *row, int16_t x, value_t v) {
+    uint8_t *p = &row[(size_t)x * 3];
+    p[0] = v >> 16;
+    p[1] = v >> 8;
+    p[2] = v;
+  }
+  /*!
+    @brief  Read one pixel
+    @param  row  Start of the pixel's row
+    @param  x    Raw x coordinate
+    @returns  Pixel value
+  */
+  static value_t get(const uint8_t *row, int16_t x) {
+    const uint8_t *p = &row[(size_t)x * 3];
+    return ((uint32_t)p[0] << 16) | ((uint16_t)p[1] << 8) | p[2];
+  }
+  /*!
+    @brief  Store a run of pixels in one row
+    @param  row  Start of the row
+    @param  x    Raw x coordinate of the first pixel
+    @param  w    Number of pixels, > 0
+    @param  v    Pixel value
+  */
+  static void fill(uint8_t *row, int16_t x, int16_t w, value_t v) {
+    uint8_t r = v >> 16, g = v >> 8, b = v;
+    uint8_t *p = &row[(size_t)x * 3];
+    if ((r == g) && (g == b)) { // Gray, including black and white
+      memset(p, r, (size_t)w * 3);
+      return;
+    }
+    while (w--) {
+      *p++ = r;
+      *p++ = g;
+      *p++ = b;
+    }
+  }
+};
+
+/*!
+  @brief  32-bit color, one 0xAARRGGBB word per pixel in native byte
+          order. Drawing calls write opaque pixels (alpha 0xFF). The
+          buffer must be word aligned.
+*/
+struct GFXformatARGB8888 {
+  static const uint8_t bits = 32; ///< Bits per pixel
+  typedef uint32_t value_t;       ///< Native pixel value, 0xAARRGGBB
+
+  /*!
+    @brief  Convert a drawing color to a pixel value
+    @param  color  16-bit 5-6-5 color
+    @returns  Opaque pixel value
+  */
+  static value_t pack(uint16_t color) {
+    return 0xFF000000UL | gfxExpand565(color);
+  }
+  /*!
+    @brief  Store one pixel
+    @param  row  Start of the pixel's row (word aligned)
+    @param  x    Raw x coordinate
+    @param  v    Pixel value
+  */
+  static void set(uint8_t *row, int16_t x, value_t v) {
+    ((uint32_t *)row)[x] = v;
+  }
+  /*!
+    @brief  Read one pixel
+    @param  row  Start of the pixel's row (word aligned)
+    @param  x    Raw x coordinate
+    @returns  Pixel value
+  */
+  static value_t get(const uint8_t *row, int16_t x) {
+    return ((const uint32_t *)row)[x];
+  }
+  /*!
+    @brief  Store a run of pixels in one row
+    @param  row  Start of the row (word aligned)
+    @param  x    Raw x coordinate of the first pixel
+    @param  w    Number of pixels, > 0
+    @param  v    Pixel value
+  */
+  static void fill(uint8_t *row, int16_t x, int16_t w, value_t v) {
+    uint32_t *p = &((uint32_t *)row)[x];
+    while (w--)
+      *p++ = v;
+  }
+};
+
+/// A GFX canvas whose pixel format is a template parameter (one of the
+/// GFXformat structs above, or any struct with the same members)
+template <class Format> class GFXcanvasT : public Adafruit_GFX {
+public:
+  typedef typename Format::value_t value_t; ///< Native pixel value type
+
+  /**********************************************************************/
+  /*!
+    @brief  Instantiate a canvas, allocating its buffer
+    @param  w  Canvas width, in pixels
+    @param  h  Canvas height, in pixels
+  */
+  /**********************************************************************/
+  GFXcanvasT(uint16_t w, uint16_t h)
+      : Adafruit_GFX(w, h), rowBytes(((uint32_t)w * Format::bits + 7) / 8),
+        owned(true) {
+    uint32_t bytes = (uint32_t)rowBytes * h;
+    if ((buffer = (uint8_t *)malloc(bytes)))
+      memset(buffer, 0, bytes);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Instantiate a canvas drawing into a caller-supplied buffer,
+            whose contents are kept. It is not freed with the canvas.
+    @param  w       Canvas width, in pixels
+    @param  h       Canvas height, in pixels
+    @param  buffer  (w * Format::bits + 7) / 8 * h bytes, rows padded to
+                    whole bytes. A format that stores one value_t per
+                    pixel (GFXformatARGB8888) needs it aligned for
+                    value_t, e.g. a uint32_t array; a misaligned buffer
+                    is not used and getBuffer() returns NULL.
+  */
+  /**********************************************************************/
+  GFXcanvasT(uint16_t w, uint16_t h, uint8_t *buffer)
+      : Adafruit_GFX(w, h), buffer(buffer),
+        rowBytes(((uint32_t)w * Format::bits + 7) / 8), owned(false) {
+    if ((Format::bits == 8 * sizeof(value_t)) &&
+        ((uintptr_t)buffer % sizeof(value_t)))
+      this->buffer = NULL; // Pixels are read and written as value_t
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Move a canvas: take over its buffer, leaving it with none
+    @param  canvas  Canvas to move from
+  */
+  /**********************************************************************/
+  GFXcanvasT(GFXcanvasT &&canvas)
+      : Adafruit_GFX(canvas), buffer(canvas.buffer), rowBytes(canvas.rowBytes),
+        owned(canvas.owned) {
+    canvas.buffer = NULL;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Delete the canvas, free memory
+  */
+  /**********************************************************************/
+  ~GFXcanvasT(void) {
+    if (buffer && owned)
+      free(buffer);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Move a canvas into this one, freeing this one's buffer first
+            if it owns it
+    @param  canvas  Canvas to move from, left with no buffer
+    @returns  This canvas
+  */
+  /**********************************************************************/
+  GFXcanvasT &operator=(GFXcanvasT &&canvas) {
+    if (this != &canvas) {
+      if (buffer && owned)
+        free(buffer);
+      Adafruit_GFX::operator=(canvas);
+      buffer = canvas.buffer;
+      rowBytes = canvas.rowBytes;
+      owned = canvas.owned;
+      canvas.buffer = NULL;
+    }
+    return *this;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a pixel to the canvas framebuffer
+    @param  x      x coordinate
+    @param  y      y coordinate
+    @param  color  Color to draw with, see Format::pack()
+  */
+  /**********************************************************************/
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (buffer && !isClipped(x, y)) {
+      toRaw(x, y);
+      Format::set(row(y), x, Format::pack(color));
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Get the pixel value at a given coordinate
+    @param  x  x coordinate
+    @param  y  y coordinate
+    @returns  The pixel's native value, 0 if outside the canvas
+  */
+  /**********************************************************************/
+  value_t getPixel(int16_t x, int16_t y) const {
+    toRaw(x, y);
+    return getRawPixel(x, y);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill the framebuffer completely with one color (or just the
+            clip rect, if one is pushed)
+    @param  color  Color to fill with, see Format::pack()
+  */
+  /**********************************************************************/
+  void fillScreen(uint16_t color) {
+    if (clipDepth) {
+      fillRect(0, 0, _width, _height, color);
+    } else if (buffer) { // Fill one row, copy it to the rest
+      Format::fill(buffer, 0, WIDTH, Format::pack(color));
+      for (int16_t y = 1; y < HEIGHT; y++)
+        memcpy(row(y), buffer, rowBytes);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Speed optimized vertical line drawing
+    @param  x      Line horizontal start point
+    @param  y      Line vertical start point
+    @param  h      Length of vertical line, negative to extend above y
+    @param  color  Color to draw with, see Format::pack()
+  */
+  /**********************************************************************/
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    int32_t y0 = y, y1;
+    if (!buffer || (x < clipX0()) || (x >= clipX1()))
+      return;
+    if (h < 0) {
+      y0 += h + 1;
+      h = -h;
+    }
+    y1 = y0 + h;
+    if (y0 < clipY0())
+      y0 = clipY0();
+    if (y1 > clipY1())
+      y1 = clipY1();
+    if (y1 <= y0)
+      return;
+    h = y1 - y0;
+    switch (rotation) {
+    case 0:
+      drawFastRawVLine(x, y0, h, color);
+      break;
+    case 1:
+      drawFastRawHLine(WIDTH - y0 - h, x, h, color);
+      break;
+    case 2:
+      drawFastRawVLine(WIDTH - 1 - x, HEIGHT - y0 - h, h, color);
+      break;
+    default:
+      drawFastRawHLine(y0, HEIGHT - 1 - x, h, color);
+      break;
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Speed optimized horizontal line drawing
+    @param  x      Line horizontal start point
+    @param  y      Line vertical start point
+    @param  w      Length of horizontal line, negative to extend left of x
+    @param  color  Color to draw with, see Format::pack()
+  */
+  /**********************************************************************/
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (buffer)
+      hline(x, y, w, Format::pack(color));
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a rectangle straight into the buffer, one Format::fill()
+            per buffer row whatever the rotation
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels, negative to extend left of x
+    @param  h      Height in pixels, negative to extend above y
+    @param  color  Color to fill with, see Format::pack()
+  */
+  /**********************************************************************/
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!buffer || !clipRawRect(&x, &y, &w, &h))
+      return;
+    value_t v = Format::pack(color);
+    for (int16_t y1 = y + h; y < y1; y++)
+      Format::fill(row(y), x, w, v);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a rectangle, same as fillRect() on a canvas
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  color  Color to fill with, see Format::pack()
+  */
+  /**********************************************************************/
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                     uint16_t color) {
+    fillRect(x, y, w, h, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a batch of horizontal spans, clipped, packing the color
+            once for the whole batch
+    @param  spans  Array of spans, each with a positive width
+    @param  count  Number of spans in the array
+    @param  color  Color to fill with, see Format::pack()
+  */
+  /**********************************************************************/
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color) {
+    if (buffer) {
+      value_t v = Format::pack(color);
+      for (; count--; spans++)
+        hline(spans->x, spans->y, spans->w, v);
+    }
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Get a pointer to the internal buffer memory
+    @returns  A pointer to the allocated buffer, rows of bytesPerRow()
+              bytes each at rotation 0
+  */
+  /**********************************************************************/
+  uint8_t *getBuffer(void) const { return buffer; }
+
+  /**********************************************************************/
+  /*!
+    @brief  Get the buffer's row pitch
+    @returns  Bytes per (unrotated) row, rows start on a byte boundary
+  */
+  /**********************************************************************/
+  uint16_t bytesPerRow(void) const { return rowBytes; }
+
+protected:
+  /**********************************************************************/
+  /*!
+    @brief  Get the pixel value at a given, unrotated coordinate
+    @param  x  x coordinate
+    @param  y  y coordinate
+    @returns  The pixel's native value, 0 if outside the canvas
+  */
+  /**********************************************************************/
+  value_t getRawPixel(int16_t x, int16_t y) const {
+    if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT) || !buffer)
+      return 0;
+    return Format::get(row(y), x);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Set one pixel in raw (rotation 0) coordinates, no clipping
+    @param  x      Raw x coordinate, 0 to WIDTH-1
+    @param  y      Raw y coordinate, 0 to HEIGHT-1
+    @param  color  Color to draw with, see Format::pack()
+  */
+  /**********************************************************************/
+  void drawRawPixel(int16_t x, int16_t y, uint16_t color) {
+    Format::set(row(y), x, Format::pack(color));
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Vertical line into the raw canvas buffer, no clipping
+    @param  x      Raw x coordinate
+    @param  y      Raw y coordinate of the top pixel
+    @param  h      Length of the line, > 0
+    @param  color  Color to draw with, see Format::pack()
+  */
+  /**********************************************************************/
+  void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    value_t v = Format::pack(color);
+    for (uint8_t *p = row(y); h--; p += rowBytes)
+      Format::set(p, x, v);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Horizontal line into the raw canvas buffer, no clipping
+    @param  x      Raw x coordinate of the left pixel
+    @param  y      Raw y coordinate
+    @param  w      Length of the line, > 0
+    @param  color  Color to draw with, see Format::pack()
+  */
+  /**********************************************************************/
+  void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    Format::fill(row(y), x, w, Format::pack(color));
+  }
+
+private:
+  uint8_t *row(int16_t y) const { return buffer + (uint32_t)y * rowBytes; }
+
+  void toRaw(int16_t &x, int16_t &y) const {
+    int16_t t = x;
+    switch (rotation) {
+    case 1:
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+    }
+  }
+
+  // Clipped horizontal line of an already packed value
+  void hline(int16_t x, int16_t y, int16_t w, value_t v) {
+    int32_t x0 = x, x1;
+    if ((y < clipY0()) || (y >= clipY1()))
+      return;
+    if (w < 0) {
+      x0 += w + 1;
+      w = -w;
+    }
+    x1 = x0 + w;
+    if (x0 < clipX0())
+      x0 = clipX0();
+    if (x1 > clipX1())
+      x1 = clipX1();
+    if (x1 <= x0)
+      return;
+    w = x1 - x0;
+    uint8_t *p;
+    switch (rotation) {
+    case 0:
+      Format::fill(row(y), x0, w, v);
+      break;
+    case 2:
+      Format::fill(row(HEIGHT - 1 - y), WIDTH - x0 - w, w, v);
+      break;
+    case 1: // Raw column
+      for (p = row(x0); w--; p += rowBytes)
+        Format::set(p, WIDTH - 1 - y, v);
+      break;
+    default:
+      for (p = row(HEIGHT - x0 - w); w--; p += rowBytes)
+        Format::set(p, y, v);
+      break;
+    }
+  }
+
+  uint8_t *buffer;
+  uint16_t rowBytes;
+  bool owned; ///< buffer was allocated here and is freed on destruction
+};
+
+// GFXcanvasIndexed::flush() expands this many pixels at a time into each
+// of its two line buffers, which live on the stack at 2 bytes per pixel
+#if !defined(GFX_PALETTE_LINE)
+#if defined(__AVR__)
+#define GFX_PALETTE_LINE 32 ///< Pixels per line buffer on AVR
+#else
+#define GFX_PALETTE_LINE 160 ///< Pixels per line buffer
+#endif
+#endif
+
+/// A GFXcanvasT of palette indices, BITS (2, 4 or 8) per pixel, with an
+/// RGB565 palette that is applied when the canvas is sent to a display
+template <uint8_t BITS>
+class GFXcanvasIndexed : public GFXcanvasT<GFXformatIndex<BITS> > {
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Instantiate a canvas, allocating its buffer. The palette
+            starts as RGB332 colors for 8-bit indices (index RRRGGGBB),
+            else as a ramp of grays from black (index 0) to white.
+    @param  w  Canvas width, in pixels
+    @param  h  Canvas height, in pixels
+  */
+  /**********************************************************************/
+  GFXcanvasIndexed(uint16_t w, uint16_t h)
+      : GFXcanvasT<GFXformatIndex<BITS> >(w, h) {
+    defaultPalette();
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Instantiate a canvas drawing into a caller-supplied buffer, as
+            for GFXcanvasT, with the same default palette
+    @param  w       Canvas width, in pixels
+    @param  h       Canvas height, in pixels
+    @param  buffer  (w * BITS + 7) / 8 * h bytes, not freed with the canvas
+  */
+  /**********************************************************************/
+  GFXcanvasIndexed(uint16_t w, uint16_t h, uint8_t *buffer)
+      : GFXcanvasT<GFXformatIndex<BITS> >(w, h, buffer) {
+    defaultPalette();
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Set one palette entry. Takes effect on the next flush().
+    @param  index  Palette index, 0 to 2^BITS - 1
+    @param  color  16-bit 5-6-5 color shown for that index
+  */
+  /**********************************************************************/
+  void setPaletteColor(uint8_t index, uint16_t color) {
+    // Kept in the display's byte order, whatever the CPU's, so flush()
+    // can hand lines to writePixels() without swapping them
+    uint8_t *p = (uint8_t *)&palette[index & ((1 << BITS) - 1)];
+    p[0] = color >> 8;
+    p[1] = color;
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Get one palette entry
+    @param  index  Palette index, 0 to 2^BITS - 1
+    @returns  16-bit 5-6-5 color shown for that index
+  */
+  /**********************************************************************/
+  uint16_t getPaletteColor(uint8_t index) const {
+    const uint8_t *p = (const uint8_t *)&palette[index & ((1 << BITS) - 1)];
+    return (p[0] << 8) | p[1];
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Set a run of palette entries
+    @param  colors  16-bit 5-6-5 colors, in RAM
+    @param  count   Number of colors
+    @param  first   Index of the first entry to set
+  */
+  /**********************************************************************/
+  void setPalette(const uint16_t *colors, uint16_t count, uint8_t first = 0) {
+    for (uint16_t i = 0; (i < count) && (first + i < (1 << BITS)); i++)
+      setPaletteColor(first + i, colors[i]);
+  }
+
+  void flush(Adafruit_SPITFT &tft, int16_t x = 0, int16_t y = 0);
+
+  /**********************************************************************/
+  /*!
+    @brief  Look up a run of pixels of one buffer row in the palette
+    @param  row  Start of the (unrotated) row
+    @param  x    Raw x coordinate of the first pixel
+    @param  n    Number of pixels
+    @param  out  n colors, big-endian, as writePixels() takes with its
+                 bigEndian argument set
+  */
+  /**********************************************************************/
+  void expand(const uint8_t *row, int16_t x, int16_t n, uint16_t *out) const {
+    const uint8_t mask = (1 << BITS) - 1;
+    if (BITS == 8) {
+      for (row += x; n--;)
+        *out++ = palette[*row++ & mask];
+    } else if ((BITS == 4) && !(x & 1)) { // Two pixels per byte
+      for (row += x / 2; n >= 2; n -= 2) {
+        uint8_t b = *row++;
+        *out++ = palette[(b >> 4) & mask];
+        *out++ = palette[b & mask];
+      }
+      if (n)
+        *out = palette[(*row >> 4) & mask];
+    } else {
+      for (; n--; x++)
+        *out++ = palette[GFXformatIndex<BITS>::get(row, x)];
+    }
+  }
+
+private:
+  // RGB332 colors for 8-bit indices (index RRRGGGBB), else a ramp of grays
+  void defaultPalette(void) {
+    for (uint16_t i = 0; i < (1 << BITS); i++) {
+      uint8_t r, g, b;
+      if (BITS == 8) {
+        r = (i >> 5) * 255 / 7;
+        g = ((i >> 2) & 7) * 255 / 7;
+        b = (i & 3) * 255 / 3;
+      } else {
+        r = g = b = i * 255 / ((1 << BITS) - 1);
+      }
+      setPaletteColor(i, ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+  }
+
+  uint16_t palette[1 << BITS]; ///< Colors, in the display's byte order
+};
+
+typedef GFXcanvasIndexed<4> GFXcanvasIndexed4; ///< 16 colors, 4 bits/pixel
+typedef GFXcanvasIndexed<8> GFXcanvasIndexed8; ///< 256 colors, 1 byte/pixel
+
+#endif // _ADAFRUIT_GFXCANVAST_H_
@@ -147,7 +147,7 @@ Adafruit_GrayOLED::Adafruit_GrayOLED(uint8_t bpp, uint16_t w, uint16_t h,
     @brief  Destructor for Adafruit_GrayOLED object.
 */
 Adafruit_GrayOLED::~Adafruit_GrayOLED(void) {
-  if (buffer) {
+  if (buffer && _ownBuffer) {
     free(buffer);
     buffer = NULL;
   }
@@ -223,9 +223,10 @@ bool Adafruit_GrayOLED::oled_commandList(const uint8_t *c, uint8_t n) {
 bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
 
   // attempt to malloc the bitmap framebuffer
-  if ((!buffer) &&
-      !(buffer = (uint8_t *)malloc(_bpp * WIDTH * ((HEIGHT + 7) / 8)))) {
-    return false;
+  if (!buffer) {
+    if (!(buffer = (uint8_t *)malloc(_bpp * WIDTH * ((HEIGHT + 7) / 8))))
+      return false;
+    _ownBuffer = true;
   }
 
   // Reset OLED if requested and reset pin specified in constructor
@@ -264,6 +265,25 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
   return true; // Success
 }
 
+/*!
+    @brief  As _init(addr, reset), but the display draws into a
+            caller-supplied framebuffer instead of a malloc'd one. See
+            setBuffer().
+    @param  addr
+            I2C address of corresponding oled display, as for
+            _init(addr, reset).
+    @param  reset
+            If true, perform a hard reset first, as for _init(addr, reset).
+    @param  buf
+            Framebuffer of _bpp * WIDTH * ((HEIGHT + 7) / 8) bytes, or
+            NULL to allocate one as _init(addr, reset) does.
+    @return true on successful init, false otherwise.
+*/
+bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset, uint8_t *buf) {
+  setBuffer(buf);
+  return _init(addr, reset);
+}
+
 // DRAWING FUNCTIONS -------------------------------------------------------
 
 /*!
@@ -282,7 +302,7 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
             commands as needed by one's own application.
 */
 void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height())) {
+  if (!isClipped(x, y)) {
     // Pixel is in-bounds. Rotate coordinates if needed.
     switch (getRotation()) {
     case 1:
@@ -389,6 +409,25 @@ bool Adafruit_GrayOLED::getPixel(int16_t x, int16_t y) {
 */
 uint8_t *Adafruit_GrayOLED::getBuffer(void) { return buffer; }
 
+/*!
+    @brief  Have the display draw into a caller-supplied framebuffer (a
+            static array, a GFXbufferPool block...) instead of allocating
+            one, so running out of heap cannot make begin() fail. Call it
+            before begin(); the buffer is not freed by the destructor.
+    @param  buf
+            Framebuffer of _bpp * WIDTH * ((HEIGHT + 7) / 8) bytes, laid
+            out as getBuffer() describes, or NULL to go back to a malloc'd
+            one on the next begin().
+*/
+void Adafruit_GrayOLED::setBuffer(uint8_t *buf) {
+  if (buf == buffer)
+    return;
+  if (buffer && _ownBuffer)
+    free(buffer);
+  buffer = buf;
+  _ownBuffer = false;
+}
+
 // OTHER HARDWARE SETTINGS -------------------------------------------------
 
 /*!
@@ -69,12 +69,14 @@ public:
   void drawPixel(int16_t x, int16_t y, uint16_t color);
   bool getPixel(int16_t x, int16_t y);
   uint8_t *getBuffer(void);
+  void setBuffer(uint8_t *buf);
 
   void oled_command(uint8_t c);
   bool oled_commandList(const uint8_t *c, uint8_t n);
 
 protected:
   bool _init(uint8_t i2caddr = 0x3C, bool reset = true);
+  bool _init(uint8_t i2caddr, bool reset, uint8_t *buf);
 
   Adafruit_SPIDevice *spi_dev = NULL; ///< The SPI interface BusIO device
   Adafruit_I2CDevice *i2c_dev = NULL; ///< The I2C interface BusIO device
@@ -94,6 +96,7 @@ protected:
   uint8_t _bpp = 1; ///< Bits per pixel color for this display
 private:
   TwoWire *_theWire = NULL; ///< The underlying hardware I2C
+  bool _ownBuffer = false;  ///< buffer was malloc'd here, freed on deletion
 };
 
 #endif // end __AVR_ATtiny85__
@@ -943,7 +943,7 @@ void Adafruit_SPITFT::endWrite(void) {
     @param  color  16-bit pixel color in '565' RGB format.
 */
 void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+  if (!isClipped(x, y)) {
     setAddrWindow(x, y, 1, 1);
     SPI_WRITE16(color);
   }
@@ -1493,30 +1493,30 @@ void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
       x += w + 1; //   Move X to left edge
       w = -w;     //   Use positive width
     }
-    if (x < _width) { // Not off right
-      if (h < 0) {    // If negative height...
-        y += h + 1;   //   Move Y to top edge
-        h = -h;       //   Use positive height
+    if (x < clipX1()) { // Not off right
+      if (h < 0) {      // If negative height...
+        y += h + 1;     //   Move Y to top edge
+        h = -h;         //   Use positive height
       }
-      if (y < _height) { // Not off bottom
+      if (y < clipY1()) { // Not off bottom
         int16_t x2 = x + w - 1;
-        if (x2 >= 0) { // Not off left
+        if (x2 >= clipX0()) { // Not off left
           int16_t y2 = y + h - 1;
-          if (y2 >= 0) { // Not off top
+          if (y2 >= clipY0()) { // Not off top
             // Rectangle partly or fully overlaps screen
-            if (x < 0) {
-              x = 0;
-              w = x2 + 1;
+            if (x < clipX0()) {
+              x = clipX0();
+              w = x2 - x + 1;
             } // Clip left
-            if (y < 0) {
-              y = 0;
-              h = y2 + 1;
+            if (y < clipY0()) {
+              y = clipY0();
+              h = y2 - y + 1;
             } // Clip top
-            if (x2 >= _width) {
-              w = _width - x;
+            if (x2 >= clipX1()) {
+              w = clipX1() - x;
             } // Clip right
-            if (y2 >= _height) {
-              h = _height - y;
+            if (y2 >= clipY1()) {
+              h = clipY1() - y;
             } // Clip bottom
             writeFillRectPreclipped(x, y, w, h, color);
           }
@@ -1540,21 +1540,21 @@ void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
                                             uint16_t color) {
-  if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
-    if (w < 0) {                        // If negative width...
-      x += w + 1;                       //   Move X to left edge
-      w = -w;                           //   Use positive width
+  if ((y >= clipY0()) && (y < clipY1()) && w) { // Y visible, nonzero width
+    if (w < 0) {                                // If negative width...
+      x += w + 1;                               //   Move X to left edge
+      w = -w;                                   //   Use positive width
     }
-    if (x < _width) { // Not off right
+    if (x < clipX1()) { // Not off right
       int16_t x2 = x + w - 1;
-      if (x2 >= 0) { // Not off left
+      if (x2 >= clipX0()) { // Not off left
         // Line partly or fully overlaps screen
-        if (x < 0) {
-          x = 0;
-          w = x2 + 1;
+        if (x < clipX0()) {
+          x = clipX0();
+          w = x2 - x + 1;
         } // Clip left
-        if (x2 >= _width) {
-          w = _width - x;
+        if (x2 >= clipX1()) {
+          w = clipX1() - x;
         } // Clip right
         writeFillRectPreclipped(x, y, w, 1, color);
       }
@@ -1576,21 +1576,21 @@ void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
 */
 void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
                                             uint16_t color) {
-  if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
-    if (h < 0) {                       // If negative height...
-      y += h + 1;                      //   Move Y to top edge
-      h = -h;                          //   Use positive height
+  if ((x >= clipX0()) && (x < clipX1()) && h) { // X visible, nonzero h
+    if (h < 0) {                                // If negative height...
+      y += h + 1;                               //   Move Y to top edge
+      h = -h;                                   //   Use positive height
     }
-    if (y < _height) { // Not off bottom
+    if (y < clipY1()) { // Not off bottom
       int16_t y2 = y + h - 1;
-      if (y2 >= 0) { // Not off top
+      if (y2 >= clipY0()) { // Not off top
         // Line partly or fully overlaps screen
-        if (y < 0) {
-          y = 0;
-          h = y2 + 1;
+        if (y < clipY0()) {
+          y = clipY0();
+          h = y2 - y + 1;
         } // Clip top
-        if (y2 >= _height) {
-          h = _height - y;
+        if (y2 >= clipY1()) {
+          h = clipY1() - y;
         } // Clip bottom
         writeFillRectPreclipped(x, y, 1, h, color);
       }
@@ -1598,6 +1598,33 @@ void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
   }
 }
 
+/*!
+    @brief  Draw a batch of horizontal spans, as generated by the filled
+            graphics primitives. Not self-contained; should follow
+            startWrite(). Runs of spans stacked directly on top of one
+            another with the same x and width (the flat sides of triangles
+            and round-rects) are merged into a single rectangle, so they
+            cost one address window instead of one per scanline.
+    @param  spans  Array of spans, each with a positive width.
+    @param  count  Number of spans in the array.
+    @param  color  16-bit fill color in '565' RGB format.
+*/
+void Adafruit_SPITFT::writeSpans(const GFXspan *spans, uint16_t count,
+                                 uint16_t color) {
+  while (count) {
+    int16_t x = spans->x, y = spans->y, w = spans->w, h = 1;
+    spans++;
+    count--;
+    while (count && (spans->x == x) && (spans->w == w) &&
+           (spans->y == y + h)) {
+      h++;
+      spans++;
+      count--;
+    }
+    writeFillRect(x, y, w, h, color);
+  }
+}
+
 /*!
     @brief  A lower-level version of writeFillRect(). This version requires
             all inputs are in-bounds, that width and height are positive,
@@ -1644,7 +1671,7 @@ inline void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y,
 */
 void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
   // Clip first...
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+  if (!isClipped(x, y)) {
     // THEN set up transaction (if needed) and draw...
     startWrite();
     setAddrWindow(x, y, 1, 1);
@@ -1679,30 +1706,30 @@ void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
       x += w + 1; //   Move X to left edge
       w = -w;     //   Use positive width
     }
-    if (x < _width) { // Not off right
-      if (h < 0) {    // If negative height...
-        y += h + 1;   //   Move Y to top edge
-        h = -h;       //   Use positive height
+    if (x < clipX1()) { // Not off right
+      if (h < 0) {      // If negative height...
+        y += h + 1;     //   Move Y to top edge
+        h = -h;         //   Use positive height
       }
-      if (y < _height) { // Not off bottom
+      if (y < clipY1()) { // Not off bottom
         int16_t x2 = x + w - 1;
-        if (x2 >= 0) { // Not off left
+        if (x2 >= clipX0()) { // Not off left
           int16_t y2 = y + h - 1;
-          if (y2 >= 0) { // Not off top
+          if (y2 >= clipY0()) { // Not off top
             // Rectangle partly or fully overlaps screen
-            if (x < 0) {
-              x = 0;
-              w = x2 + 1;
+            if (x < clipX0()) {
+              x = clipX0();
+              w = x2 - x + 1;
             } // Clip left
-            if (y < 0) {
-              y = 0;
-              h = y2 + 1;
+            if (y < clipY0()) {
+              y = clipY0();
+              h = y2 - y + 1;
             } // Clip top
-            if (x2 >= _width) {
-              w = _width - x;
+            if (x2 >= clipX1()) {
+              w = clipX1() - x;
             } // Clip right
-            if (y2 >= _height) {
-              h = _height - y;
+            if (y2 >= clipY1()) {
+              h = clipY1() - y;
             } // Clip bottom
             startWrite();
             writeFillRectPreclipped(x, y, w, h, color);
@@ -1732,21 +1759,21 @@ void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                     uint16_t color) {
-  if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
-    if (w < 0) {                        // If negative width...
-      x += w + 1;                       //   Move X to left edge
-      w = -w;                           //   Use positive width
+  if ((y >= clipY0()) && (y < clipY1()) && w) { // Y visible, nonzero width
+    if (w < 0) {                                // If negative width...
+      x += w + 1;                               //   Move X to left edge
+      w = -w;                                   //   Use positive width
     }
-    if (x < _width) { // Not off right
+    if (x < clipX1()) { // Not off right
       int16_t x2 = x + w - 1;
-      if (x2 >= 0) { // Not off left
+      if (x2 >= clipX0()) { // Not off left
         // Line partly or fully overlaps screen
-        if (x < 0) {
-          x = 0;
-          w = x2 + 1;
+        if (x < clipX0()) {
+          x = clipX0();
+          w = x2 - x + 1;
         } // Clip left
-        if (x2 >= _width) {
-          w = _width - x;
+        if (x2 >= clipX1()) {
+          w = clipX1() - x;
         } // Clip right
         startWrite();
         writeFillRectPreclipped(x, y, w, 1, color);
@@ -1773,21 +1800,21 @@ void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
 */
 void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                     uint16_t color) {
-  if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
-    if (h < 0) {                       // If negative height...
-      y += h + 1;                      //   Move Y to top edge
-      h = -h;                          //   Use positive height
+  if ((x >= clipX0()) && (x < clipX1()) && h) { // X visible, nonzero h
+    if (h < 0) {                                // If negative height...
+      y += h + 1;                               //   Move Y to top edge
+      h = -h;                                   //   Use positive height
     }
-    if (y < _height) { // Not off bottom
+    if (y < clipY1()) { // Not off bottom
       int16_t y2 = y + h - 1;
-      if (y2 >= 0) { // Not off top
+      if (y2 >= clipY0()) { // Not off top
         // Line partly or fully overlaps screen
-        if (y < 0) {
-          y = 0;
-          h = y2 + 1;
+        if (y < clipY0()) {
+          y = clipY0();
+          h = y2 - y + 1;
         } // Clip top
-        if (y2 >= _height) {
-          h = _height - y;
+        if (y2 >= clipY1()) {
+          h = clipY1() - y;
         } // Clip bottom
         startWrite();
         writeFillRectPreclipped(x, y, 1, h, color);
@@ -1829,29 +1856,29 @@ void Adafruit_SPITFT::pushColor(uint16_t color) {
 void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
                                     int16_t w, int16_t h) {
 
-  int16_t x2, y2;                 // Lower-right coord
-  if ((x >= _width) ||            // Off-edge right
-      (y >= _height) ||           // " top
-      ((x2 = (x + w - 1)) < 0) || // " left
-      ((y2 = (y + h - 1)) < 0))
+  int16_t x2, y2;                        // Lower-right coord
+  if ((x >= clipX1()) ||                 // Off-edge right
+      (y >= clipY1()) ||                 // " top
+      ((x2 = (x + w - 1)) < clipX0()) || // " left
+      ((y2 = (y + h - 1)) < clipY0()))
     return; // " bottom
 
   int16_t bx1 = 0, by1 = 0, // Clipped top-left within bitmap
       saveW = w;            // Save original bitmap width value
-  if (x < 0) {              // Clip left
-    w += x;
-    bx1 = -x;
-    x = 0;
+  if (x < clipX0()) {       // Clip left
+    bx1 = clipX0() - x;
+    w -= bx1;
+    x = clipX0();
   }
-  if (y < 0) { // Clip top
-    h += y;
-    by1 = -y;
-    y = 0;
+  if (y < clipY0()) { // Clip top
+    by1 = clipY0() - y;
+    h -= by1;
+    y = clipY0();
   }
-  if (x2 >= _width)
-    w = _width - x; // Clip right
-  if (y2 >= _height)
-    h = _height - y; // Clip bottom
+  if (x2 >= clipX1())
+    w = clipX1() - x; // Clip right
+  if (y2 >= clipY1())
+    h = clipY1() - y; // Clip bottom
 
   pcolors += by1 * saveW + bx1; // Offset bitmap ptr to clipped top-left
   startWrite();
@@ -1863,6 +1890,117 @@ void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
   endWrite();
 }
 
+/*!
+    @brief  Draw one line of text with its background, replacing whatever
+            was under it without the blink of erasing first. Custom fonts
+            have no background in print(); here each scanline of the
+            text's bounding box is composited (glyphs in textcolor over
+            textbgcolor) into a small buffer and the box is sent through a
+            single setAddrWindow(). Uses the current font(s) and text size,
+            without wrapping. The cursor is not moved. If textbgcolor is
+            textcolor (setTextColor() with one color), the text is drawn
+            transparently, as print() would, and nothing else is painted.
+    @param  x    Cursor X, as for setCursor()
+    @param  y    Cursor Y, as for setCursor() (the baseline, for custom
+                 fonts)
+    @param  str  The text, up to the end of the string or the first
+                 newline. UTF-8 if the font calls for it (see utf8()).
+    @note   The box is the text's own bounds (see getTextBounds()), which
+            may not cover longer or taller text drawn there before: pass
+            a box that does to the other drawTextLine().
+*/
+void Adafruit_SPITFT::drawTextLine(int16_t x, int16_t y, const char *str) {
+  int16_t bx, by;
+  uint16_t bw, bh;
+  textLineBounds(str, x, y, &bx, &by, &bw, &bh);
+  drawTextLine(x, y, str, bx, by, bw, bh);
+}
+
+/*!
+    @brief  Draw one line of text in a box, filling the rest of the box
+            with the text background, in a single address window (see the
+            other drawTextLine()). Suits fields that are redrawn as their
+            text changes: parts of the text outside the box are not drawn.
+            With textbgcolor the same as textcolor only the text is drawn
+            (clipped to the box), as print() would, not a filled box.
+    @param  x    Cursor X, as for setCursor()
+    @param  y    Cursor Y, as for setCursor() (the baseline, for custom
+                 fonts)
+    @param  str  The text, up to the end of the string or the first
+                 newline
+    @param  bx   Left edge of the box
+    @param  by   Top edge of the box
+    @param  bw   Width of the box in pixels
+    @param  bh   Height of the box in pixels
+*/
+void Adafruit_SPITFT::drawTextLine(int16_t x, int16_t y, const char *str,
+                                   int16_t bx, int16_t by, int16_t bw,
+                                   int16_t bh) {
+  int32_t x0 = bx, y0 = by, x1 = x0 + bw, y1 = y0 + bh; // Clip the box
+  if (x0 < clipX0())
+    x0 = clipX0();
+  if (y0 < clipY0())
+    y0 = clipY0();
+  if (x1 > clipX1())
+    x1 = clipX1();
+  if (y1 > clipY1())
+    y1 = clipY1();
+  if ((x0 >= x1) || (y0 >= y1))
+    return;
+
+  if (textbgcolor == textcolor) { // Transparent text: no box to fill
+    int16_t saveX = cursor_x, saveY = cursor_y;
+    bool saveWrap = wrap;
+    uint8_t saveLeft = utf8Left;
+    uint32_t saveCode = utf8Code;
+    bool boxed = pushClipRect(bx, by, bw, bh);
+    wrap = false;
+    cursor_x = x;
+    cursor_y = y;
+    utf8Left = 0;
+    while (*str && (*str != '\n'))
+      write((uint8_t)*str++);
+    if (boxed)
+      popClipRect();
+    cursor_x = saveX;
+    cursor_y = saveY;
+    wrap = saveWrap;
+    utf8Left = saveLeft;
+    utf8Code = saveCode;
+    return;
+  }
+
+  // Lay the text out once; only text too long for the glyph list is laid
+  // out again, a list at a time, for each chunk of each scanline
+  GFXtextglyph glyphs[SPITFT_TEXT_GLYPHS];
+  const char *rest = str;
+  int16_t gx = x;
+  uint8_t count = textLineGlyphs(&rest, &gx, y, glyphs, SPITFT_TEXT_GLYPHS);
+  bool once = !*rest || (*rest == '\n');
+
+  uint16_t buf[SPITFT_TEXT_CHUNK];
+  startWrite();
+  setAddrWindow(x0, y0, x1 - x0, y1 - y0);
+  for (int16_t row = y0; row < y1; row++) {
+    for (int16_t cx = x0; cx < x1; cx += SPITFT_TEXT_CHUNK) {
+      int16_t n = (x1 - cx < SPITFT_TEXT_CHUNK) ? x1 - cx : SPITFT_TEXT_CHUNK;
+      for (int16_t i = 0; i < n; i++)
+        buf[i] = textbgcolor;
+      if (once) {
+        textLineRow(glyphs, count, row, cx, buf, n);
+      } else {
+        gx = x;
+        for (rest = str; *rest && (*rest != '\n');) {
+          count = textLineGlyphs(&rest, &gx, y, glyphs, SPITFT_TEXT_GLYPHS);
+          textLineRow(glyphs, count, row, cx, buf, n);
+        }
+      }
+      writePixels(buf, n);
+    }
+  }
+  endWrite();
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
@@ -1877,6 +2015,124 @@ void Adafruit_SPITFT::invertDisplay(bool i) {
   endWrite();
 }
 
+/*!
+    @brief  Set up hardware vertical scrolling, which moves what the panel
+            shows without sending any pixels: rows y to y + h - 1 then
+            scroll(), the rest stay put (e.g. a title bar and a status
+            line). Rows are the panel's own, as at rotation 0; at rotation
+            1 and 3 they are columns on screen. What the area shows is
+            left as it is.
+    @param  y  First row of the scroll area
+    @param  h  Rows in the scroll area, 0 to turn scrolling off, showing
+               the frame memory as it is laid out again
+    @return true on success, false if the area is off the panel or the
+            panel can't scroll.
+*/
+bool Adafruit_SPITFT::setScrollArea(uint16_t y, uint16_t h) {
+  if ((int32_t)y + h > HEIGHT)
+    return false;
+  if (!h) { // Whole frame memory, unscrolled
+    if (!sendScrollArea(0, HEIGHT, 0))
+      return false;
+    sendScrollStart(0);
+  } else {
+    if (!sendScrollArea(y, h, HEIGHT - y - h))
+      return false;
+    sendScrollStart(y);
+  }
+  scrollTop = y;
+  scrollRows = h;
+  scrollOffset = 0;
+  return true;
+}
+
+/*!
+    @brief  Move the contents of the setScrollArea() area by dy rows in
+            hardware, and fill the rows it uncovers, so a terminal or log
+            only has to draw its new line. Rows pushed out of the area
+            wrap around to the rows it uncovers, which is why those get
+            filled.
+    @param  dy     Rows to move down (negative: up), in the panel's own
+                   rows as for setScrollArea()
+    @param  color  16-bit 5-6-5 color to fill uncovered rows with
+    @return The frame memory row (as at rotation 0) where the uncovered
+            rows start, to draw the new content there. They continue
+            down, wrapping from the end of the area to its start. -1 if
+            no scroll area is set.
+*/
+int16_t Adafruit_SPITFT::scroll(int16_t dy, uint16_t color) {
+  if (!scrollRows)
+    return -1;
+  // Screen row scrollTop + i shows frame memory row
+  // scrollTop + (scrollOffset + i) % scrollRows
+  int32_t offset = ((int32_t)scrollOffset - dy) % scrollRows;
+  if (offset < 0)
+    offset += scrollRows;
+  uint16_t n = min((uint16_t)abs(dy), scrollRows);
+  uint16_t first = (dy < 0) ? (offset + scrollRows - n) % scrollRows : offset;
+  uint16_t k = min(n, (uint16_t)(scrollRows - first));
+  fillScrollRows(scrollTop + first, k, color);
+  fillScrollRows(scrollTop, n - k, color);
+  scrollOffset = offset;
+  sendScrollStart(scrollTop + offset);
+  return scrollTop + first;
+}
+
+/*!
+    @brief  Fill frame memory rows (as at rotation 0) for scroll()
+    @param  row    First row
+    @param  n      Number of rows, may be 0
+    @param  color  16-bit 5-6-5 color to fill with
+*/
+void Adafruit_SPITFT::fillScrollRows(uint16_t row, uint16_t n,
+                                     uint16_t color) {
+  if (!n)
+    return;
+  switch (rotation) {
+  case 0:
+    fillRect(0, row, _width, n, color);
+    break;
+  case 1:
+    fillRect(row, 0, n, _height, color);
+    break;
+  case 2:
+    fillRect(0, HEIGHT - row - n, _width, n, color);
+    break;
+  case 3:
+    fillRect(HEIGHT - row - n, 0, n, _height, color);
+    break;
+  }
+}
+
+/*!
+    @brief  Send a scroll area to the display, for setScrollArea(). The
+            default sends MIPI DCS set_scroll_area (0x33), which most
+            controllers (ILI9341, ST7735, ST7789, HX8357...) understand.
+    @param  top     Rows fixed above the scroll area
+    @param  rows    Rows in the scroll area
+    @param  bottom  Rows fixed below the scroll area
+    @return true if the panel can scroll.
+*/
+bool Adafruit_SPITFT::sendScrollArea(uint16_t top, uint16_t rows,
+                                     uint16_t bottom) {
+  uint8_t data[] = {(uint8_t)(top >> 8),    (uint8_t)top,
+                    (uint8_t)(rows >> 8),   (uint8_t)rows,
+                    (uint8_t)(bottom >> 8), (uint8_t)bottom};
+  sendCommand(0x33, data, sizeof(data));
+  return true;
+}
+
+/*!
+    @brief  Send the frame memory row to show at the top of the scroll
+            area, for scroll(). The default sends MIPI DCS
+            set_scroll_start (0x37).
+    @param  row  Frame memory row, as at rotation 0
+*/
+void Adafruit_SPITFT::sendScrollStart(uint16_t row) {
+  uint8_t data[] = {(uint8_t)(row >> 8), (uint8_t)row};
+  sendCommand(0x37, data, sizeof(data));
+}
+
 /*!
     @brief   Given 8-bit red, green and blue values, return a 'packed'
              16-bit color value in '565' RGB format (5 bits red, 6 bits
@@ -71,6 +71,25 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 #define DEFAULT_SPI_FREQ 16000000L ///< Hardware SPI default speed
 #endif
 
+// Pixels of a drawTextLine() scanline composited on the stack at a time
+#if !defined(SPITFT_TEXT_CHUNK)
+#if defined(__AVR__)
+#define SPITFT_TEXT_CHUNK 32 ///< drawTextLine() buffer (small: AVR stack)
+#else
+#define SPITFT_TEXT_CHUNK 160 ///< drawTextLine() buffer, in pixels
+#endif
+#endif
+
+// Glyphs drawTextLine() lays out once per call; longer text is laid out
+// again for every scanline
+#if !defined(SPITFT_TEXT_GLYPHS)
+#if defined(__AVR__)
+#define SPITFT_TEXT_GLYPHS 8 ///< drawTextLine() glyph list (small: AVR stack)
+#else
+#define SPITFT_TEXT_GLYPHS 32 ///< drawTextLine() glyph list
+#endif
+#endif
+
 #if defined(ADAFRUIT_PYPORTAL) || defined(ADAFRUIT_PYPORTAL_M4_TITANO) ||      \
     defined(ADAFRUIT_PYBADGE_M4_EXPRESS) ||                                    \
     defined(ADAFRUIT_PYGAMER_M4_EXPRESS) ||                                    \
@@ -222,6 +241,7 @@ public:
                      uint16_t color);
   void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void writeSpans(const GFXspan *spans, uint16_t count, uint16_t color);
   // This is a new function, similar to writeFillRect() except that
   // all arguments MUST be onscreen, sorted and clipped. If higher-level
   // primitives can handle their own sorting/clipping, it avoids repeating
@@ -253,9 +273,16 @@ public:
   using Adafruit_GFX::drawRGBBitmap; // Check base class first
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
+  // Opaque text (custom fonts too), sent as one address window per line:
+  void drawTextLine(int16_t x, int16_t y, const char *str);
+  void drawTextLine(int16_t x, int16_t y, const char *str, int16_t bx,
+                    int16_t by, int16_t bw, int16_t bh);
 
   void invertDisplay(bool i);
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
+  // Hardware vertical scrolling, in the panel's native (rotation 0) rows:
+  bool setScrollArea(uint16_t y, uint16_t h);
+  int16_t scroll(int16_t dy, uint16_t color = 0);
 
   // Despite parallel additions, function names kept for compatibility:
   void spiWrite(uint8_t b);          // Write single byte as DATA
@@ -380,6 +407,13 @@ protected:
   inline void TFT_WR_STROBE(void); // Parallel interface write strobe
   inline void TFT_RD_HIGH(void);   // Parallel interface read high
   inline void TFT_RD_LOW(void);    // Parallel interface read low
+  // Hardware scrolling commands. The defaults send the MIPI DCS
+  // set_scroll_area and set_scroll_start commands most controllers have,
+  // for a frame memory HEIGHT rows tall; subclasses override them for
+  // other controllers, or return false if the panel can't scroll.
+  virtual bool sendScrollArea(uint16_t top, uint16_t rows, uint16_t bottom);
+  virtual void sendScrollStart(uint16_t row);
+  void fillScrollRows(uint16_t row, uint16_t n, uint16_t color);
 
   // CLASS INSTANCE VARIABLES --------------------------------------------
 
@@ -522,6 +556,9 @@ protected:
   int16_t _ystart = 0;          ///< Internal framebuffer Y offset
   uint8_t invertOnCommand = 0;  ///< Command to enable invert mode
   uint8_t invertOffCommand = 0; ///< Command to disable invert mode
+  uint16_t scrollTop = 0;       ///< First row of hardware scroll area
+  uint16_t scrollRows = 0;      ///< Rows in scroll area, 0 if not scrolling
+  uint16_t scrollOffset = 0;    ///< Area row shown at the top of the area
 
   uint32_t _freq = 0; ///< Dummy var to keep subclasses happy
 };
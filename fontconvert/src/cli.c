@@ -71,7 +71,7 @@ int range_count(const ch_range *range) {
 void print_usage(char *argv[]) {
 	fprintf(stderr,
 	        "usage: %s -f FONTFILE [-s SIZE] [-p PIXELS] [-v VARIANT] [-g] [-r H] [-Y YADV] [-X DX] [-W W] [-w WGHT] [-H HINT]\n"
-	        "       %*s [-N] [-I] [-E] [-D MODE] [-e EXPOSURE] [-c CONTRAST] [-o OFFSET|-n OFFSET] [-b BITS]\n"
+	        "       %*s [-N] [-I] [-E] [-D MODE] [-e EXPOSURE] [-c CONTRAST] [-o OFFSET|-n OFFSET] [-b BITS] [-R]\n"
 	        "       %*s [-S \"G[,G]...\" [-F CP] [-C] | RANGES]\n"
 	        "       where G = space-separated hex codepoints for one glyph\n",
 	        argv[0], (int)strlen(argv[0]), "", (int)strlen(argv[0]), "");
@@ -269,6 +269,13 @@ void print_usage(char *argv[]) {
 	        "              stay crisp instead of dissolving into dither.  Edges are\n"
 	        "              kept clear of the alpha boundary so -O remains a clean\n"
 	        "              1px outline.  Applied after -I, before -O.\n");
+	fprintf(stderr,
+	        "    -R        Sparse output for several RANGES: emit a GFXfontSparse\n"
+	        "              with a range table instead of padding the glyph array\n"
+	        "              with an empty 7-byte glyph per codepoint between ranges.\n"
+	        "              RANGES must be ascending and must not overlap.  Needs a\n"
+	        "              library with GFXfontSparse; pass &NAME.font to setFont().\n"
+	        "              Ignored when -S is given.\n");
 	fprintf(stderr,
 	        "    -d        Dump all codepoints (and variant selectors) present in\n"
 	        "              the font to stderr, then exit without generating output.\n");
@@ -309,7 +316,7 @@ int parse_args(int argc, char *argv[], char **fontFileName,
 	if (argc <= 1)
 		return -1;
 
-	while ((opt = getopt(argc, argv, "dgCNIEs:f:v:r:o:n:S:W:w:D:e:c:G:B:U:O:b:F:Y:X:H:p:")) != -1) {
+	while ((opt = getopt(argc, argv, "dgCNIERs:f:v:r:o:n:S:W:w:D:e:c:G:B:U:O:b:F:Y:X:H:p:")) != -1) {
 		switch (opt) {
 		case 's':
 			if (!optarg) { printf("Missing value for argument s!\n"); return -1; }
@@ -379,6 +386,10 @@ int parse_args(int argc, char *argv[], char **fontFileName,
 			s.dump_codepoints = 1;
 			break;
 
+		case 'R':
+			s.sparse = 1;
+			break;
+
 		case 'S':
 			if (!optarg) { printf("Missing value for argument S!\n"); return -1; }
 			s.sequence = strdup(optarg);
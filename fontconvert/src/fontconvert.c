@@ -59,6 +59,7 @@ FontSettings s = {
 	.bits = 16,
 	.render_mode = 0,
 	.dump_codepoints = 0,
+	.sparse = 0,
 	.sequence = NULL,
 	.seq_first = 0,
 	.dither_mode = DITHER_FLOYD_STEINBERG,
@@ -124,6 +125,27 @@ int main(int argc, char *argv[]) {
 	}
 	int last_range = s.num_ranges - 1;
 
+	// -R looks glyphs up by binary search over the ranges, with a 16-bit glyph
+	// index per range, so they must be ascending and disjoint.
+	if (s.sparse && !s.sequence) {
+		for (i = 1; i < s.num_ranges; ++i) {
+			if (ranges[i].first <= ranges[i - 1].last) {
+				fprintf(stderr, "Error: -R needs ascending, non-overlapping ranges "
+				        "(0x%lX - 0x%lX follows 0x%lX - 0x%lX).\n",
+				        ranges[i].first, ranges[i].last,
+				        ranges[i - 1].first, ranges[i - 1].last);
+				free(ranges);
+				return 1;
+			}
+		}
+		if (total_num > 0xFFFF) {
+			fprintf(stderr, "Error: -R supports at most 65535 glyphs (got %d).\n",
+			        total_num);
+			free(ranges);
+			return 1;
+		}
+	}
+
 	// Codepoint-range guard.  The GFXfont first/last fields hold the real Unicode
 	// codepoint.  An -o/-n offset that drives an emitted codepoint below 0 would
 	// wrap when stored in the unsigned fields, and in the default 16-bit mode a
@@ -371,7 +393,7 @@ int main(int argc, char *argv[]) {
 				}
 				j++;
 			}
-			if (r != last_range) {
+			if (r != last_range && !s.sparse) {
 				for (codepoint = ranges[r].last + 1;
 				     codepoint < ranges[r + 1].first; ++codepoint) {
 					printf("  { %5d, %3d, %3d, %3d, %4d, %4d },   // 0x%02lX (skip)\n",
@@ -385,9 +407,6 @@ int main(int argc, char *argv[]) {
 			printf(" '%c'", (int)ranges[last_range].last);
 		printf(" (#%d)\n\n", j - 1);
 
-		printf("const GFXfont %s PROGMEM = {\n", fontName);
-		printf("  (uint8_t  *)%sBitmaps,\n", fontName);
-		printf("  (GFXglyph *)%sGlyphs,\n", fontName);
 		if (s.height != 0)
 			face->size->metrics.height = s.height;
 		else if (face->size->metrics.height == 0)
@@ -396,11 +415,40 @@ int main(int argc, char *argv[]) {
 			face->size->metrics.height = (uint8_t)(face->size->metrics.height >> 6);
 		long emit_yadv = s.yadvance != 0 ? (long)s.yadvance
 		                                 : (long)face->size->metrics.height;
-		printf("  0x%02lX, // first\n  0x%02lX, // last\n  %ld   //height\n };\n\n",
-		       ranges[0].first + s.offset, ranges[last_range].last + s.offset,
-		       emit_yadv);
-		printf("// Approx. %d bytes\n",
-		       bitmapOffset + (total_num + skipped) * 7 + 7);
+
+		if (s.sparse) {
+			// One GFXrange per range.  total_num <= 0xFFFF was checked up
+			// front, so every count and glyphBase fits the 16-bit fields.
+			printf("const GFXrange %sRanges[] PROGMEM = {\n", fontName);
+			printf("//    start, count, glyphBase\n");
+			j = 0;
+			for (r = 0; r < s.num_ranges; ++r) {
+				printf("%s  { 0x%06lX, %5d, %5d }", r ? ",\n" : "",
+				       ranges[r].first + s.offset, range_count(&ranges[r]), j);
+				j += range_count(&ranges[r]);
+			}
+			printf(" };\n\n");
+
+			printf("const GFXfontSparse %s PROGMEM = {\n", fontName);
+			printf("  { (uint8_t  *)%sBitmaps,\n", fontName);
+			printf("    (GFXglyph *)%sGlyphs,\n", fontName);
+			printf("    GFX_FONT_SPARSE, // first\n    0x%02lX, // last\n"
+			       "    %ld }, //height\n", ranges[last_range].last + s.offset,
+			       emit_yadv);
+			printf("  (GFXrange *)%sRanges,\n  %d // ranges\n };\n\n",
+			       fontName, s.num_ranges);
+			printf("// Approx. %d bytes\n",
+			       bitmapOffset + total_num * 7 + s.num_ranges * 8 + 7 + 6);
+		} else {
+			printf("const GFXfont %s PROGMEM = {\n", fontName);
+			printf("  (uint8_t  *)%sBitmaps,\n", fontName);
+			printf("  (GFXglyph *)%sGlyphs,\n", fontName);
+			printf("  0x%02lX, // first\n  0x%02lX, // last\n  %ld   //height\n };\n\n",
+			       ranges[0].first + s.offset, ranges[last_range].last + s.offset,
+			       emit_yadv);
+			printf("// Approx. %d bytes\n",
+			       bitmapOffset + (total_num + skipped) * 7 + 7);
+		}
 	}
 
 	FT_Done_FreeType(library);
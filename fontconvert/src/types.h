@@ -52,6 +52,10 @@ typedef struct settings {
 	                   to be written directly, with no -n PUA shift. */
 	int render_mode;
 	int dump_codepoints;
+	int sparse;     /* -R: emit the RANGES as a GFXfontSparse with a range table
+	                   (start, count, glyphBase) rather than a dense GFXfont
+	                   whose glyph array is padded with an empty 7-byte glyph
+	                   for every codepoint in the gaps between ranges. */
 	char *sequence;
 	int seq_first;  /* base codepoint for the emitted GFXfont in sequence (-S)
 	                   mode: `first` is set to this value (default 0) and `last`
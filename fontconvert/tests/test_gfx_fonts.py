@@ -51,6 +51,7 @@ font_test_output/.  All verified passing as of 2026-04-27.
 """
 
 import itertools
+import re
 import subprocess
 import tempfile
 from pathlib import Path
@@ -481,6 +482,91 @@ class TestCommaSequence:
                 f"Glyph {i} offset+size overflows bitmap"
 
 
+# ---------------------------------------------------------------------------
+# Test: sparse multi-range output (-R flag)
+# ---------------------------------------------------------------------------
+
+def parse_ranges(text: str) -> list:
+    """(start, count, glyphBase) tuples from a -R header's *Ranges[] table."""
+    m = re.search(r'const GFXrange \w+Ranges\[\].*?=\s*\{(.*?)\};',
+                  text, re.DOTALL)
+    assert m, "No *Ranges[] table in -R output"
+    return [(int(rm.group(1), 16), int(rm.group(2)), int(rm.group(3)))
+            for rm in re.finditer(r'\{\s*0x([0-9A-Fa-f]+),\s*(\d+),\s*(\d+)\s*\}',
+                                  m.group(1))]
+
+
+def sparse_lookup(ranges: list, cp: int):
+    """Glyph index for cp, as the library's binary search finds it, or None."""
+    lo, hi = 0, len(ranges)
+    while lo < hi:
+        mid = (lo + hi) // 2
+        start, count, base = ranges[mid]
+        if cp < start:
+            hi = mid
+        elif cp >= start + count:
+            lo = mid + 1
+        else:
+            return base + cp - start
+    return None
+
+
+@pytest.mark.skipif(not DEJAVU.exists(), reason="DejaVuSans not installed")
+class TestSparseRanges:
+    """
+    -R emits a GFXfontSparse: glyphs for the listed ranges only, plus a
+    (start, count, glyphBase) table the library binary-searches, instead of
+    an empty glyph for every codepoint in the gaps.
+    """
+    RANGES = ('0x41', '0x43', '0xe0', '0xe1', '0x2190', '0x2193')
+
+    def _text(self):
+        return run_fontconvert(f'-f{DEJAVU}', '-s14', '-v_Sparse_', '-R',
+                               *self.RANGES)
+
+    def test_range_table(self):
+        assert parse_ranges(self._text()) == [
+            (0x41, 3, 0), (0xe0, 2, 3), (0x2190, 4, 5)]
+
+    def test_no_gap_padding(self):
+        assert len(h_to_font(self._text())['glyphs']) == 3 + 2 + 4
+
+    def test_font_struct(self):
+        text = self._text()
+        assert re.search(r'GFX_FONT_SPARSE, // first\s*\n\s*0x2193, // last',
+                         text)
+        assert re.search(r'\(GFXrange \*\)\w+Ranges,\s*3 // ranges', text)
+
+    def test_lookups_match_dense_output(self):
+        """Each codepoint finds the glyph a dense conversion of its own
+        range gives it; codepoints in the gaps find none."""
+        text = self._text()
+        ranges = parse_ranges(text)
+        glyphs = h_to_font(text)['glyphs']
+        for first, last in ((0x41, 0x43), (0xe0, 0xe1), (0x2190, 0x2193)):
+            dense = h_to_font(run_fontconvert(f'-f{DEJAVU}', '-s14',
+                                              '-v_Dense_', hex(first),
+                                              hex(last)))['glyphs']
+            for cp in range(first, last + 1):
+                i = sparse_lookup(ranges, cp)
+                assert i is not None, f"U+{cp:04X} not found"
+                got = {k: v for k, v in glyphs[i].items() if k != 'bitmapOffset'}
+                want = {k: v for k, v in dense[cp - first].items()
+                        if k != 'bitmapOffset'}
+                assert got == want, f"U+{cp:04X} maps to the wrong glyph"
+        for cp in (0x20, 0x40, 0x44, 0xdf, 0xe2, 0x218f, 0x2194, 0x10ffff):
+            assert sparse_lookup(ranges, cp) is None, f"U+{cp:04X} found"
+
+    def test_overlapping_ranges_rejected(self):
+        if not FONTCONVERT.exists():
+            pytest.skip(f"fontconvert binary not found at {FONTCONVERT}")
+        result = subprocess.run([str(FONTCONVERT), f'-f{DEJAVU}', '-s14', '-R',
+                                 '0x41', '0x50', '0x48', '0x5a'],
+                                capture_output=True, text=True)
+        assert result.returncode != 0
+        assert 'non-overlapping' in result.stderr
+
+
 # ---------------------------------------------------------------------------
 # Test: BGRA color-emoji path (NotoColorEmoji) — skipped until font present
 # ---------------------------------------------------------------------------
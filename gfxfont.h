@@ -28,4 +28,26 @@ typedef struct {
   uint8_t yAdvance; ///< Newline distance (y axis)
 } GFXfont;
 
+/// GFXfont::first value that marks the font as the head of a GFXfontSparse
+#define GFX_FONT_SPARSE 0xFFFFFFFFUL
+
+/// A run of consecutive codepoints in a GFXfontSparse
+typedef struct {
+  uint32_t start;     ///< First codepoint of the run
+  uint16_t count;     ///< Number of codepoints in the run
+  uint16_t glyphBase; ///< Index in GFXfont->glyph of the glyph for start
+} GFXrange;
+
+/// A font covering several disjoint codepoint ranges (e.g. Latin plus a
+/// few symbols) without padding the glyph array over the gaps between them.
+/// font.first is GFX_FONT_SPARSE and font.last the highest codepoint; the
+/// library looks glyphs up in the range table instead. Pass &name.font to
+/// setFont(). Older versions of the library find no glyphs in it rather
+/// than drawing the wrong ones.
+typedef struct {
+  GFXfont font;        ///< Bitmaps, glyphs and yAdvance, as in any GFXfont
+  GFXrange *range;     ///< Codepoint runs, sorted by start, not overlapping
+  uint16_t rangeCount; ///< Number of entries in range
+} GFXfontSparse;
+
 #endif // _GFXFONT_H_
@@ -0,0 +1,344 @@
+/*!
+ * @file gfx_bench.cpp
+ *
+ * Host-side micro-benchmark for the core GFX primitives. Each primitive is
+ * timed on GFXcanvas1, GFXcanvas8 and GFXcanvas16, a GFXRenderer, two
+ * GFXcanvasT formats, plus a mock SPI TFT (Adafruit_SPITFT subclass on a
+ * byte-counting SPI bus) so that changes in bus traffic show up alongside
+ * changes in CPU time.
+ *
+ * Output columns:
+ *   calls/s  primitive calls per second
+ *   Mpix/s   nominal pixels covered per second (area of the shape, not
+ *            necessarily the number of writePixel() calls made)
+ *   bus B    bytes sent over SPI per call (TFT target only)
+ *   hash     FNV-1a hash of the canvas after a fixed, seeded sequence of
+ *            calls. Rendering changes that should be pixel-exact must not
+ *            change this value; it is checked against the golden tables
+ *            below and the bench exits nonzero on any mismatch.
+ *
+ * Usage: gfx_bench [--quick] [--seconds S] [filter]
+ *   --quick    run each case only briefly (smoke test)
+ *   --seconds  minimum measuring time per case (default 0.25)
+ *   filter     only run cases whose "target/op" name contains this string
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_GFXRenderer.h>
+#include <Adafruit_GFXcanvasT.h>
+#include <Adafruit_SPITFT.h>
+#include <Fonts/FreeSans9pt7b.h>
+
+#include <chrono>
+
+#define BENCH_W 320   ///< Target width in pixels
+#define BENCH_H 240   ///< Target height in pixels
+#define ICON_W 32     ///< drawRGBBitmap() source width
+#define ICON_H 32     ///< drawRGBBitmap() source height
+#define HASH_CALLS 64 ///< Calls made before hashing a canvas
+
+/*!
+  @brief  Mock ILI9341-style display. setAddrWindow() issues the usual
+          CASET/PASET/RAMWR sequence so bus byte counts are realistic.
+*/
+class HostTFT : public Adafruit_SPITFT {
+public:
+  HostTFT(uint16_t w, uint16_t h) : Adafruit_SPITFT(w, h, &SPI, 10, 9) {}
+  void begin(uint32_t freq = 0) { initSPI(freq); }
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    writeCommand(0x2A); // CASET
+    SPI_WRITE16(x);
+    SPI_WRITE16(x + w - 1);
+    writeCommand(0x2B); // PASET
+    SPI_WRITE16(y);
+    SPI_WRITE16(y + h - 1);
+    writeCommand(0x2C); // RAMWR
+  }
+};
+
+/*!
+  @brief  Small deterministic PRNG so every run draws the same shapes.
+*/
+class Rng {
+public:
+  explicit Rng(uint32_t seed) : state(seed) {}
+  uint32_t next(void) {
+    state = state * 1664525UL + 1013904223UL;
+    return state >> 8;
+  }
+  int16_t range(int16_t lo, int16_t hi) { // Inclusive
+    return lo + (int16_t)(next() % (uint32_t)(hi - lo + 1));
+  }
+
+private:
+  uint32_t state;
+};
+
+static uint16_t icon[ICON_W * ICON_H];
+
+// Each op makes one primitive call and returns the nominal pixel count.
+// Ops are templates so that the GFXRenderer target calls its statically
+// dispatched methods rather than going through Adafruit_GFX.
+typedef uint32_t (*BenchOp)(Adafruit_GFX &gfx, Rng &rng);
+
+template <class G> static uint32_t opFillScreen(G &gfx, Rng &rng) {
+  gfx.fillScreen(rng.next());
+  return (uint32_t)gfx.width() * gfx.height();
+}
+
+template <class G> static uint32_t opDrawLine(G &gfx, Rng &rng) {
+  int16_t x0 = rng.range(0, gfx.width() - 1);
+  int16_t y0 = rng.range(0, gfx.height() - 1);
+  int16_t x1 = rng.range(0, gfx.width() - 1);
+  int16_t y1 = rng.range(0, gfx.height() - 1);
+  gfx.drawLine(x0, y0, x1, y1, rng.next());
+  int16_t dx = abs(x1 - x0), dy = abs(y1 - y0);
+  return ((dx > dy) ? dx : dy) + 1;
+}
+
+template <class G> static uint32_t opFillTriangle(G &gfx, Rng &rng) {
+  int16_t cx = rng.range(0, gfx.width() - 1);
+  int16_t cy = rng.range(0, gfx.height() - 1);
+  int16_t x0 = cx + rng.range(-50, 50), y0 = cy + rng.range(-50, 50),
+          x1 = cx + rng.range(-50, 50), y1 = cy + rng.range(-50, 50),
+          x2 = cx + rng.range(-50, 50), y2 = cy + rng.range(-50, 50);
+  gfx.fillTriangle(x0, y0, x1, y1, x2, y2, rng.next());
+  int32_t area2 =
+      (int32_t)(x1 - x0) * (y2 - y0) - (int32_t)(x2 - x0) * (y1 - y0);
+  return (uint32_t)(abs(area2) / 2) + 1;
+}
+
+template <class G> static uint32_t opFillCircle(G &gfx, Rng &rng) {
+  int16_t x = rng.range(0, gfx.width() - 1);
+  int16_t y = rng.range(0, gfx.height() - 1);
+  int16_t r = rng.range(2, 40);
+  gfx.fillCircle(x, y, r, rng.next());
+  return (uint32_t)(3.14159f * r * r) + 1;
+}
+
+template <class G> static uint32_t opFillRoundRect(G &gfx, Rng &rng) {
+  int16_t x = rng.range(-20, gfx.width() - 20);
+  int16_t y = rng.range(-20, gfx.height() - 20);
+  int16_t w = rng.range(4, 80), h = rng.range(4, 80), r = rng.range(1, 20);
+  gfx.fillRoundRect(x, y, w, h, r, rng.next());
+  return (uint32_t)w * h;
+}
+
+template <class G> static uint32_t opFillPolygon(G &gfx, Rng &rng) {
+  int16_t cx = rng.range(0, gfx.width() - 1);
+  int16_t cy = rng.range(0, gfx.height() - 1);
+  int16_t xy[2 * 8];
+  for (int i = 0; i < 8; i++) { // Random, usually self-intersecting, octagon
+    xy[i * 2] = cx + rng.range(-50, 50);
+    xy[i * 2 + 1] = cy + rng.range(-50, 50);
+  }
+  gfx.fillPolygon(xy, 8, rng.next(),
+                  (rng.next() & 1) ? GFX_FILL_NONZERO : GFX_FILL_EVEN_ODD);
+  return 50 * 50;
+}
+
+template <class G> static uint32_t opDrawChar(G &gfx, Rng &rng) {
+  int16_t x = rng.range(0, gfx.width() - 12);
+  int16_t y = rng.range(0, gfx.height() - 16);
+  uint8_t size = 1 + (rng.next() & 1);
+  gfx.drawChar(x, y, (unsigned char)rng.range(0x21, 0x7E), rng.next(),
+               rng.next(), size);
+  return 6 * 8 * size * size;
+}
+
+template <class G> static uint32_t opDrawCharFont(G &gfx, Rng &rng) {
+  int16_t x = rng.range(0, gfx.width() - 24);
+  int16_t y = rng.range(16, gfx.height() - 8);
+  uint8_t size = 1 + (rng.next() & 1);
+  unsigned char c = (unsigned char)rng.range(0x21, 0x7E);
+  gfx.setFont(&FreeSans9pt7b);
+  gfx.drawChar(x, y, c, rng.next(), rng.next(), size);
+  gfx.setFont();
+  const GFXglyph *glyph = &FreeSans9pt7b.glyph[c - FreeSans9pt7b.first];
+  return (uint32_t)glyph->width * glyph->height * size * size;
+}
+
+template <class G> static uint32_t opDrawRGBBitmap(G &gfx, Rng &rng) {
+  int16_t x = rng.range(-ICON_W / 2, gfx.width() - ICON_W / 2),
+          y = rng.range(-ICON_H / 2, gfx.height() - ICON_H / 2);
+  gfx.drawRGBBitmap(x, y, icon, ICON_W, ICON_H);
+  return ICON_W * ICON_H;
+}
+
+// Call op OP on a target whose real type is G
+template <class G, uint32_t (*OP)(G &, Rng &)>
+static uint32_t as(Adafruit_GFX &gfx, Rng &rng) {
+  return OP(static_cast<G &>(gfx), rng);
+}
+
+/*!
+  @brief  One named benchmark case
+*/
+struct BenchCase {
+  const char *name;
+  BenchOp op;
+};
+
+#define BENCH_OPS(G)                                                           \
+  {                                                                            \
+    {"fillScreen", as<G, opFillScreen<G>>},                                    \
+        {"drawLine", as<G, opDrawLine<G>>},                                    \
+        {"fillTriangle", as<G, opFillTriangle<G>>},                            \
+        {"fillCircle", as<G, opFillCircle<G>>},                                \
+        {"fillRoundRect", as<G, opFillRoundRect<G>>},                          \
+        {"fillPolygon", as<G, opFillPolygon<G>>},                              \
+        {"drawChar", as<G, opDrawChar<G>>},                                    \
+        {"drawChar/gfxfont", as<G, opDrawCharFont<G>>},                        \
+        {"drawRGBBitmap", as<G, opDrawRGBBitmap<G>>},                          \
+  }
+
+typedef GFXRenderer<GFXcanvas16> Renderer16; ///< Statically dispatched canvas
+
+static const BenchCase ops[] = BENCH_OPS(Adafruit_GFX);
+static const BenchCase canvas16Ops[] = BENCH_OPS(GFXcanvas16);
+static const BenchCase rendererOps[] = BENCH_OPS(Renderer16);
+
+static uint32_t fnv1a(const void *data, size_t len) {
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t h = 2166136261UL;
+  while (len--) {
+    h ^= *p++;
+    h *= 16777619UL;
+  }
+  return h;
+}
+
+static double now(void) {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Golden hashes, one per case in BENCH_OPS order. Update these only for
+// intentional rendering changes. The GFXRenderer must match GFXcanvas16.
+static const uint32_t canvas1Hashes[] = {
+    0xd4a9b445, 0x44049111, 0xd0216ace, 0x7d4d7bde, 0x11f76881,
+    0x47b2f09c, 0xb4fc574d, 0xcaaa9f16, 0x89d40706};
+static const uint32_t canvas8Hashes[] = {
+    0xcd37b9c5, 0xef4f81b7, 0x9970d48e, 0xce8290d8, 0x2c6054c0,
+    0x5335f65c, 0x47f2dc92, 0xcd26d385, 0x346ea116};
+static const uint32_t canvas16Hashes[] = {
+    0xf3d9fdc5, 0x5766db87, 0x80ef332a, 0x32337836, 0x1615e458,
+    0x031bd68d, 0x180df1dd, 0xa1487aba, 0xf16797cf};
+static const uint32_t gray4Hashes[] = {
+    0xbab92bc5, 0x0f3e7150, 0x5dc0db94, 0xe88d478e, 0x2e3857f2,
+    0x2394dc7f, 0xf9038941, 0x16088fd2, 0xf21358e7};
+static const uint32_t rgb888Hashes[] = {
+    0x694145c5, 0xa3fe1c45, 0x4d6bdc38, 0xfce46997, 0x4fcc4f93,
+    0x97316bcb, 0xe5dd7bc5, 0x22106dc0, 0x25b60a1f};
+
+/*!
+  @brief  One drawing target: a GFX object plus access to its pixels.
+*/
+struct Target {
+  const char *name;
+  Adafruit_GFX *gfx;
+  const void *buffer;     ///< NULL if pixels can't be read back (TFT)
+  size_t bytes;           ///< Size of buffer
+  const BenchCase *ops;   ///< Cases to run, in the table order above
+  const uint32_t *hashes; ///< Expected hash per case, NULL if no buffer
+};
+
+int main(int argc, char **argv) {
+  bool quick = false;
+  double minSeconds = 0.25;
+  const char *filter = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--quick")) {
+      quick = true;
+    } else if (!strcmp(argv[i], "--seconds") && (i + 1 < argc)) {
+      minSeconds = atof(argv[++i]);
+    } else {
+      filter = argv[i];
+    }
+  }
+  if (quick)
+    minSeconds = 0.0;
+
+  for (int i = 0; i < ICON_W * ICON_H; i++)
+    icon[i] = (uint16_t)(i * 2654435761UL >> 16);
+
+  GFXcanvas1 canvas1(BENCH_W, BENCH_H);
+  GFXcanvas8 canvas8(BENCH_W, BENCH_H);
+  GFXcanvas16 canvas16(BENCH_W, BENCH_H);
+  Renderer16 renderer16(BENCH_W, BENCH_H);
+  GFXcanvasT<GFXformatGray4> gray4(BENCH_W, BENCH_H);
+  GFXcanvasT<GFXformatRGB888> rgb888(BENCH_W, BENCH_H);
+  HostTFT tft(BENCH_W, BENCH_H);
+  tft.begin();
+
+  Target targets[] = {
+      {"canvas1", &canvas1, canvas1.getBuffer(),
+       (size_t)((BENCH_W + 7) / 8) * BENCH_H, ops, canvas1Hashes},
+      {"canvas8", &canvas8, canvas8.getBuffer(), (size_t)BENCH_W * BENCH_H,
+       ops, canvas8Hashes},
+      {"canvas16", &canvas16, canvas16.getBuffer(),
+       (size_t)BENCH_W * BENCH_H * 2, canvas16Ops, canvas16Hashes},
+      {"renderer16", &renderer16, renderer16.getBuffer(),
+       (size_t)BENCH_W * BENCH_H * 2, rendererOps, canvas16Hashes},
+      {"gray4", &gray4, gray4.getBuffer(),
+       (size_t)gray4.bytesPerRow() * BENCH_H, ops, gray4Hashes},
+      {"rgb888", &rgb888, rgb888.getBuffer(),
+       (size_t)rgb888.bytesPerRow() * BENCH_H, ops, rgb888Hashes},
+      {"tft", &tft, NULL, 0, ops, NULL},
+  };
+  int failures = 0;
+
+  printf("%-28s %10s %12s %10s %10s  %s\n", "case", "calls", "calls/s",
+         "Mpix/s", "bus B", "hash");
+
+  for (const Target &t : targets) {
+    for (size_t n = 0; n < sizeof(ops) / sizeof(ops[0]); n++) {
+      const BenchCase &o = t.ops[n];
+      char name[64];
+      snprintf(name, sizeof(name), "%s/%s", t.name, o.name);
+      if (filter && !strstr(name, filter))
+        continue;
+
+      // Fixed, seeded sequence for the hash (independent of timing)
+      Rng rng(0xADAF);
+      t.gfx->fillScreen(0);
+      for (int i = 0; i < HASH_CALLS; i++)
+        o.op(*t.gfx, rng);
+      uint32_t hash = t.buffer ? fnv1a(t.buffer, t.bytes) : 0;
+
+      // Timed run, in batches until the minimum time has elapsed
+      uint32_t batch = quick ? 4 : 64;
+      uint64_t calls = 0, pixels = 0;
+      SPI.resetCounters();
+      double start = now(), elapsed;
+      do {
+        for (uint32_t i = 0; i < batch; i++)
+          pixels += o.op(*t.gfx, rng);
+        calls += batch;
+        elapsed = now() - start;
+      } while (elapsed < minSeconds);
+      if (elapsed <= 0.0)
+        elapsed = 1e-9;
+
+      printf("%-28s %10llu %12.0f %10.2f ", name, (unsigned long long)calls,
+             calls / elapsed, pixels / elapsed / 1e6);
+      if (!t.buffer) {
+        printf("%10.1f  %8s\n", (double)SPI.bytesOut / calls, "-");
+      } else if (hash == t.hashes[n]) {
+        printf("%10s  %08lx\n", "-", (unsigned long)hash);
+      } else {
+        printf("%10s  %08lx MISMATCH (expected %08lx)\n", "-",
+               (unsigned long)hash, (unsigned long)t.hashes[n]);
+        failures++;
+      }
+    }
+  }
+
+  if (failures)
+    printf("%d case(s) did not match their golden hash\n", failures);
+  return failures ? 1 : 0;
+}
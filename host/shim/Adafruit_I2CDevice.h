@@ -0,0 +1,42 @@
+/*!
+ * @file Adafruit_I2CDevice.h
+ *
+ * Stand-in for the BusIO I2C device class on a desktop host. Writes
+ * succeed and go nowhere.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_I2CDEVICE_H_
+#define _GFX_HOST_I2CDEVICE_H_
+
+#include <Wire.h>
+
+/*!
+  @brief  No-op I2C device.
+*/
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire)
+      : _addr(addr), _wire(theWire) {}
+  bool begin(bool addr_detect = true) {
+    (void)addr_detect;
+    return true;
+  }
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0) {
+    (void)buffer;
+    (void)len;
+    (void)stop;
+    (void)prefix_buffer;
+    (void)prefix_len;
+    return true;
+  }
+  uint8_t address(void) { return _addr; }
+
+private:
+  uint8_t _addr;
+  TwoWire *_wire;
+};
+
+#endif // _GFX_HOST_I2CDEVICE_H_
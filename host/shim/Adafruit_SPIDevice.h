@@ -0,0 +1,63 @@
+/*!
+ * @file Adafruit_SPIDevice.h
+ *
+ * Stand-in for the BusIO SPI device class on a desktop host. Writes are
+ * counted on the underlying SPIClass and otherwise discarded.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_SPIDEVICE_H_
+#define _GFX_HOST_SPIDEVICE_H_
+
+#include <SPI.h>
+
+/*! Bit order for SPI devices */
+typedef enum _BitOrder {
+  SPI_BITORDER_MSBFIRST = MSBFIRST,
+  SPI_BITORDER_LSBFIRST = LSBFIRST,
+} BusIOBitOrder;
+
+/*!
+  @brief  Counting SPI device.
+*/
+class Adafruit_SPIDevice {
+public:
+  Adafruit_SPIDevice(int8_t cspin, uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0, SPIClass *theSPI = &SPI)
+      : _spi(theSPI) {
+    (void)cspin;
+    (void)freq;
+    (void)dataOrder;
+    (void)dataMode;
+  }
+  Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso, int8_t mosi,
+                     uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0)
+      : _spi(&SPI) {
+    (void)cspin;
+    (void)sck;
+    (void)miso;
+    (void)mosi;
+    (void)freq;
+    (void)dataOrder;
+    (void)dataMode;
+  }
+  bool begin(void) { return true; }
+  bool write(const uint8_t *buffer, size_t len,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0) {
+    (void)buffer;
+    (void)prefix_buffer;
+    _spi->bytesOut += len + prefix_len;
+    return true;
+  }
+  void beginTransaction(void) { _spi->transactions++; }
+  void endTransaction(void) {}
+
+private:
+  SPIClass *_spi;
+};
+
+#endif // _GFX_HOST_SPIDEVICE_H_
@@ -0,0 +1,82 @@
+/*!
+ * @file Arduino.h
+ *
+ * Minimal stand-in for the Arduino core, just enough to compile the GFX
+ * library on a desktop host (Linux/macOS) for benchmarking and debugging.
+ * This is NOT an Arduino emulator: pins do nothing, delay() returns right
+ * away, and PROGMEM is ordinary memory.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_ARDUINO_H_
+#define _GFX_HOST_ARDUINO_H_
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <type_traits>
+
+#ifndef ARDUINO
+#define ARDUINO 100 ///< Pretend to be a 1.0+ core (Print::write returns size_t)
+#endif
+
+#define PROGMEM ///< Flash and RAM are the same thing on the host
+
+#define HIGH 0x1   ///< Digital pin level
+#define LOW 0x0    ///< Digital pin level
+#define INPUT 0x0  ///< Pin mode
+#define OUTPUT 0x1 ///< Pin mode
+
+#define LSBFIRST 0 ///< SPI bit order
+#define MSBFIRST 1 ///< SPI bit order
+
+typedef bool boolean; ///< Arduino's legacy boolean type
+typedef uint8_t byte; ///< Arduino's byte type
+
+class __FlashStringHelper;
+#define F(string_literal)                                                      \
+  (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+/*!
+  @brief  Tiny subset of the Arduino String class, backed by std::string.
+*/
+class String {
+public:
+  String(const char *s = "") : str(s ? s : "") {}
+  const char *c_str(void) const { return str.c_str(); }
+  unsigned int length(void) const { return (unsigned int)str.length(); }
+
+private:
+  std::string str;
+};
+
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr)) ///< Flash read
+#define pgm_read_word(addr) (*(const unsigned short *)(addr)) ///< Flash read
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr)) ///< Flash read
+
+template <class T, class U>
+static inline typename std::common_type<T, U>::type min(T a, U b) {
+  return (a < b) ? a : b;
+}
+template <class T, class U>
+static inline typename std::common_type<T, U>::type max(T a, U b) {
+  return (a > b) ? a : b;
+}
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void delay(unsigned long ms);
+void yield(void);
+unsigned long millis(void);
+unsigned long micros(void);
+
+#include "Print.h"
+
+#endif // _GFX_HOST_ARDUINO_H_
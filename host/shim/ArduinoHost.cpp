@@ -0,0 +1,51 @@
+/*!
+ * @file ArduinoHost.cpp
+ *
+ * Definitions backing the desktop-host Arduino shim: global bus objects
+ * and the handful of core functions the GFX library calls.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+
+#include <chrono>
+
+SPIClass SPI;
+TwoWire Wire;
+
+static const std::chrono::steady_clock::time_point hostStart =
+    std::chrono::steady_clock::now();
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  (void)pin;
+  (void)val;
+}
+
+int digitalRead(uint8_t pin) {
+  (void)pin;
+  return LOW;
+}
+
+void delay(unsigned long ms) { (void)ms; }
+
+void yield(void) {}
+
+unsigned long millis(void) {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - hostStart)
+      .count();
+}
+
+unsigned long micros(void) {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - hostStart)
+      .count();
+}
@@ -0,0 +1,71 @@
+/*!
+ * @file Print.h
+ *
+ * Minimal stand-in for the Arduino Print class, enough for Adafruit_GFX's
+ * print()/println() text path on a desktop host.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_PRINT_H_
+#define _GFX_HOST_PRINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+class String;
+class __FlashStringHelper;
+
+/*!
+  @brief  Byte sink with Arduino-style print() helpers on top of write().
+*/
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--)
+      n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char *str) {
+    return str ? write((const uint8_t *)str, strlen(str)) : 0;
+  }
+  size_t write(const char *buffer, size_t size) {
+    return write((const uint8_t *)buffer, size);
+  }
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const __FlashStringHelper *s) {
+    return write(reinterpret_cast<const char *>(s));
+  }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(long n) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", n);
+    return write(buf);
+  }
+  size_t print(int n) { return print((long)n); }
+  size_t print(unsigned long n) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%lu", n);
+    return write(buf);
+  }
+  size_t print(unsigned int n) { return print((unsigned long)n); }
+  size_t print(double n, int digits = 2) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+  }
+
+  size_t println(void) { return write("\r\n"); }
+  template <typename T> size_t println(T v) {
+    size_t n = print(v);
+    return n + println();
+  }
+};
+
+#endif // _GFX_HOST_PRINT_H_
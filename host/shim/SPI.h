@@ -0,0 +1,78 @@
+/*!
+ * @file SPI.h
+ *
+ * Stand-in for the Arduino SPI library on a desktop host. Nothing is
+ * transmitted; the class only counts bytes and transactions so that
+ * benchmarks can report how much bus traffic a drawing operation costs.
+ * Tests can also hook a receiver to decode the bytes "sent".
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_SPI_H_
+#define _GFX_HOST_SPI_H_
+
+#include <Arduino.h>
+
+#define SPI_HAS_TRANSACTION 1 ///< This SPI class supports transactions
+
+#define SPI_MODE0 0x00 ///< CPOL=0, CPHA=0
+#define SPI_MODE1 0x04 ///< CPOL=0, CPHA=1
+#define SPI_MODE2 0x08 ///< CPOL=1, CPHA=0
+#define SPI_MODE3 0x0C ///< CPOL=1, CPHA=1
+
+/*!
+  @brief  SPI clock/bit order/mode bundle, as passed to beginTransaction().
+*/
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 4000000, uint8_t bitOrder = MSBFIRST,
+              uint8_t dataMode = SPI_MODE0)
+      : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+  uint32_t clock;   ///< Bit rate in Hz
+  uint8_t bitOrder; ///< MSBFIRST or LSBFIRST
+  uint8_t dataMode; ///< One of the SPI_MODEn values
+};
+
+/*!
+  @brief  Counting SPI bus. Every byte 'sent' increments bytesOut, and is
+          passed to receiver if one is set.
+*/
+class SPIClass {
+public:
+  void begin(void) {}
+  void end(void) {}
+  void beginTransaction(SPISettings) { transactions++; }
+  void endTransaction(void) {}
+  uint8_t transfer(uint8_t b) {
+    bytesOut++;
+    if (receiver)
+      receiver(b);
+    return 0;
+  }
+  uint16_t transfer16(uint16_t w) {
+    transfer(w >> 8);
+    transfer(w);
+    return 0;
+  }
+  void transfer(void *buf, size_t count) {
+    for (size_t i = 0; i < count; i++)
+      transfer(((uint8_t *)buf)[i]);
+  }
+  void setBitOrder(uint8_t) {}
+  void setDataMode(uint8_t) {}
+  void setClockDivider(uint8_t) {}
+
+  /*!
+    @brief  Zero the traffic counters.
+  */
+  void resetCounters(void) { bytesOut = transactions = 0; }
+
+  uint64_t bytesOut = 0;     ///< Bytes clocked out since last reset
+  uint64_t transactions = 0; ///< beginTransaction() calls since last reset
+  void (*receiver)(uint8_t) = NULL; ///< Called with each byte, if set
+};
+
+extern SPIClass SPI; ///< The default SPI bus
+
+#endif // _GFX_HOST_SPI_H_
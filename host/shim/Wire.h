@@ -0,0 +1,25 @@
+/*!
+ * @file Wire.h
+ *
+ * Stand-in for the Arduino Wire (I2C) library on a desktop host.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_WIRE_H_
+#define _GFX_HOST_WIRE_H_
+
+#include <Arduino.h>
+
+/*!
+  @brief  Placeholder I2C bus; only its address is ever used by GFX.
+*/
+class TwoWire {
+public:
+  void begin(void) {}
+  void setClock(uint32_t) {}
+};
+
+extern TwoWire Wire; ///< The default I2C bus
+
+#endif // _GFX_HOST_WIRE_H_
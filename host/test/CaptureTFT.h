@@ -0,0 +1,189 @@
+/*!
+ * @file CaptureTFT.h
+ *
+ * Mock SPI display for host tests. It keeps a frame memory, as a panel
+ * controller does, and decodes the pixels Adafruit_SPITFT sends over the
+ * shim SPI bus into it, so what a drawing call put on the "screen" can be
+ * compared with a canvas. Address windows and the hardware scroll
+ * commands are recorded rather than sent.
+ *
+ * Like a real controller, the window is given in the display's current
+ * rotation and mapped onto the frame memory, which is laid out as at
+ * rotation 0.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef _GFX_HOST_CAPTURETFT_H_
+#define _GFX_HOST_CAPTURETFT_H_
+
+#include <Adafruit_SPITFT.h>
+
+#include <vector>
+
+/*!
+  @brief  An address window set by setAddrWindow()
+*/
+struct CaptureWindow {
+  int16_t x; ///< Left edge, in the rotation it was set in
+  int16_t y; ///< Top edge
+  int16_t w; ///< Width in pixels
+  int16_t h; ///< Height in pixels
+};
+
+/*!
+  @brief  Adafruit_SPITFT whose pixels land in a frame memory on the host.
+          Only one can receive SPI traffic at a time: the last one begun.
+*/
+class CaptureTFT : public Adafruit_SPITFT {
+public:
+  /*!
+    @brief  Make a display of the given size at rotation 0, frame memory
+            cleared to 0
+    @param  w  Width in pixels
+    @param  h  Height in pixels
+  */
+  CaptureTFT(uint16_t w, uint16_t h)
+      : Adafruit_SPITFT(w, h, &SPI, 10, 9), memory(w * h, 0) {}
+  ~CaptureTFT(void) {
+    if (active == this)
+      SPI.receiver = NULL;
+  }
+
+  /*!
+    @brief  Start receiving pixels
+    @param  freq  SPI frequency, ignored
+  */
+  void begin(uint32_t freq = 0) {
+    initSPI(freq);
+    active = this;
+    SPI.receiver = receive;
+  }
+
+  /*!
+    @brief  Record an address window and start filling it
+    @param  x  Left edge
+    @param  y  Top edge
+    @param  w  Width in pixels
+    @param  h  Height in pixels
+  */
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    CaptureWindow win = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+    windows.push_back(win);
+    at = 0;
+    odd = false;
+  }
+
+  /*!
+    @brief  Get a pixel of the frame memory, in the current rotation
+    @param  x  X coordinate
+    @param  y  Y coordinate
+    @return The pixel's color
+  */
+  uint16_t getPixel(int16_t x, int16_t y) const {
+    toRaw(&x, &y);
+    return memory[y * WIDTH + x];
+  }
+
+  /*!
+    @brief  Get the pixel the panel shows, at rotation 0, once hardware
+            scrolling has moved the rows of the scroll area
+    @param  x  X coordinate, as at rotation 0
+    @param  y  Y coordinate (the panel row), as at rotation 0
+    @return The pixel's color
+  */
+  uint16_t getShownPixel(int16_t x, int16_t y) const {
+    if (areaRows && (y >= areaTop) && (y < areaTop + areaRows))
+      y = areaTop + (y - areaTop + startRow - areaTop) % areaRows;
+    return memory[y * WIDTH + x];
+  }
+
+  /*!
+    @brief  Forget the windows recorded so far
+  */
+  void clearWindows(void) { windows.clear(); }
+
+  std::vector<CaptureWindow> windows; ///< Every setAddrWindow(), in order
+  uint32_t pixelsOut = 0;             ///< Pixels received so far
+  uint16_t areaTop = 0;   ///< Top row of the sendScrollArea() area
+  uint16_t areaRows = 0;  ///< Rows in the area, 0 for no scrolling
+  uint16_t startRow = 0;  ///< Last sendScrollStart() row
+
+protected:
+  /*!
+    @brief  Record a scroll area instead of sending it
+    @param  top     Rows fixed above the area
+    @param  rows    Rows in the area
+    @param  bottom  Rows fixed below the area
+    @return true: this panel can scroll
+  */
+  bool sendScrollArea(uint16_t top, uint16_t rows, uint16_t bottom) {
+    (void)bottom;
+    areaTop = top;
+    areaRows = (rows == HEIGHT) ? 0 : rows;
+    return true;
+  }
+
+  /*!
+    @brief  Record a scroll start instead of sending it
+    @param  row  Frame memory row to show at the top of the area
+  */
+  void sendScrollStart(uint16_t row) { startRow = row; }
+
+private:
+  // Current rotation to frame memory coordinates
+  void toRaw(int16_t *x, int16_t *y) const {
+    int16_t t = *x;
+    switch (rotation) {
+    case 1:
+      *x = WIDTH - 1 - *y;
+      *y = t;
+      break;
+    case 2:
+      *x = WIDTH - 1 - *x;
+      *y = HEIGHT - 1 - *y;
+      break;
+    case 3:
+      *x = *y;
+      *y = HEIGHT - 1 - t;
+      break;
+    }
+  }
+
+  // Two bytes, high first, make a pixel; it goes to the next spot in the
+  // window, which starts over when full as controllers do
+  void pixelByte(uint8_t b) {
+    if (!odd) {
+      high = b;
+      odd = true;
+      return;
+    }
+    odd = false;
+    pixelsOut++;
+    if (windows.empty())
+      return;
+    const CaptureWindow &win = windows.back();
+    int16_t x = win.x + at % win.w, y = win.y + at / win.w;
+    if (++at == (uint32_t)win.w * win.h)
+      at = 0;
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+      return;
+    toRaw(&x, &y);
+    memory[y * WIDTH + x] = (high << 8) | b;
+  }
+
+  static void receive(uint8_t b) {
+    if (active)
+      active->pixelByte(b);
+  }
+
+  static CaptureTFT *active;
+  std::vector<uint16_t> memory;
+  uint32_t at = 0;
+  uint8_t high = 0;
+  bool odd = false;
+};
+
+CaptureTFT *CaptureTFT::active = NULL; ///< Display receiving SPI traffic
+
+#endif // _GFX_HOST_CAPTURETFT_H_
@@ -0,0 +1,174 @@
+/*!
+ * @file bitblt_test.cpp
+ *
+ * Host-side checks of GFXcanvas1::bitBlt(), from a bitmap and from another
+ * canvas. Every raster op is compared with a pixel-by-pixel reference at
+ * every rotation of source and destination, for blocks that start and end
+ * at every bit alignment, span several machine words, hang off either
+ * canvas or are cut by a clip rect.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <Adafruit_GFX.h>
+
+#define DST_W 93 ///< Destination width in pixels: rows end mid-byte
+#define DST_H 21 ///< Destination height in pixels
+#define SRC_W 77 ///< Source canvas width in pixels
+#define SRC_H 19 ///< Source canvas height in pixels
+
+static int failures = 0;
+static uint32_t seed = 12345;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint8_t random8(void) {
+  seed = seed * 1664525UL + 1013904223UL;
+  return seed >> 24;
+}
+
+static void noise(GFXcanvas1 &canvas) {
+  for (int16_t y = 0; y < canvas.height(); y++)
+    for (int16_t x = 0; x < canvas.width(); x++)
+      canvas.drawPixel(x, y, random8() & 1);
+}
+
+// What raster op rop makes of destination bit d and source bit s
+static bool rop(bool d, bool s, uint8_t op) {
+  switch (op) {
+  case GFX_ROP_COPY:
+    return s;
+  case GFX_ROP_AND:
+    return d && s;
+  case GFX_ROP_OR:
+    return d || s;
+  case GFX_ROP_XOR:
+    return d != s;
+  default:
+    return d && !s;
+  }
+}
+
+static bool same(const GFXcanvas1 &a, const GFXcanvas1 &b) {
+  for (int16_t y = 0; y < a.height(); y++)
+    for (int16_t x = 0; x < a.width(); x++)
+      if (a.getPixel(x, y) != b.getPixel(x, y))
+        return false;
+  return true;
+}
+
+// Blocks: x, y, w, h. Negative and far-right positions hang off the canvas.
+// Rows of 64 or more bits from a byte boundary take the whole-word path.
+static const int16_t blocks[][4] = {
+    {0, 0, 8, 4},   {3, 2, 1, 1},    {5, 1, 3, 7},     {7, 3, 9, 5},
+    {1, 0, 64, 6},  {9, 4, 70, 11},  {0, 2, 93, 5},    {8, 1, 80, 9},
+    {-3, 6, 90, 4}, {-5, -3, 17, 9}, {-11, 6, 40, 30}, {85, 15, 20, 9},
+    {40, -7, 33, 40}};
+
+static void testBitmap(void) {
+  GFXcanvas1 dst(DST_W, DST_H), ref(DST_W, DST_H);
+  uint8_t bitmap[(93 + 7) / 8 * 40];
+  char what[80];
+
+  for (uint8_t r = 0; r < 4; r++) {
+    dst.setRotation(r);
+    ref.setRotation(r);
+    for (uint8_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+      for (uint8_t op = GFX_ROP_COPY; op <= GFX_ROP_ANDNOT; op++) {
+        for (uint8_t clipped = 0; clipped < 2; clipped++) {
+          int16_t x = blocks[b][0], y = blocks[b][1], w = blocks[b][2],
+                  h = blocks[b][3], bw = (w + 7) / 8;
+          for (uint16_t i = 0; i < sizeof(bitmap); i++)
+            bitmap[i] = random8();
+          noise(dst);
+          for (int16_t j = 0; j < dst.height(); j++)
+            for (int16_t i = 0; i < dst.width(); i++)
+              ref.drawPixel(i, j, dst.getPixel(i, j));
+
+          // The clip rect, if any, starts and ends mid-byte
+          int16_t cx0 = 0, cy0 = 0, cx1 = dst.width(), cy1 = dst.height();
+          if (clipped) {
+            cx0 = 6;
+            cy0 = 2;
+            cx1 = 87;
+            cy1 = 15;
+            dst.pushClipRect(cx0, cy0, cx1 - cx0, cy1 - cy0);
+          }
+          dst.bitBlt(x, y, bitmap, w, h, op);
+          if (clipped)
+            dst.popClipRect();
+
+          for (int16_t j = 0; j < h; j++)
+            for (int16_t i = 0; i < w; i++) {
+              int16_t tx = x + i, ty = y + j;
+              if ((tx < cx0) || (ty < cy0) || (tx >= cx1) || (ty >= cy1))
+                continue;
+              bool s = (bitmap[j * bw + i / 8] >> (7 - (i & 7))) & 1;
+              ref.drawPixel(tx, ty, rop(ref.getPixel(tx, ty), s, op));
+            }
+          snprintf(what, sizeof(what),
+                   "bitmap: rotation %d block %d rop %d clip %d", r, b, op,
+                   clipped);
+          check(same(dst, ref), what);
+        }
+      }
+    }
+  }
+}
+
+static void testCanvas(void) {
+  GFXcanvas1 dst(DST_W, DST_H), ref(DST_W, DST_H), src(SRC_W, SRC_H);
+  char what[80];
+  // Source corners: misaligned against every block, and off the source
+  static const int16_t from[][2] = {{0, 0}, {5, 3}, {13, 1}, {-6, -2},
+                                    {70, 12}};
+
+  for (uint8_t r = 0; r < 16; r++) {
+    dst.setRotation(r & 3);
+    ref.setRotation(r & 3);
+    src.setRotation(r >> 2);
+    for (uint8_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+      for (uint8_t f = 0; f < sizeof(from) / sizeof(from[0]); f++) {
+        for (uint8_t op = GFX_ROP_COPY; op <= GFX_ROP_ANDNOT; op++) {
+          int16_t x = blocks[b][0], y = blocks[b][1], w = blocks[b][2],
+                  h = blocks[b][3], sx = from[f][0], sy = from[f][1];
+          noise(src);
+          noise(dst);
+          for (int16_t j = 0; j < dst.height(); j++)
+            for (int16_t i = 0; i < dst.width(); i++)
+              ref.drawPixel(i, j, dst.getPixel(i, j));
+
+          dst.bitBlt(x, y, src, sx, sy, w, h, op);
+
+          for (int16_t j = 0; j < h; j++)
+            for (int16_t i = 0; i < w; i++) {
+              int16_t tx = x + i, ty = y + j, fx = sx + i, fy = sy + j;
+              if ((fx < 0) || (fy < 0) || (fx >= src.width()) ||
+                  (fy >= src.height()) || (tx < 0) || (ty < 0) ||
+                  (tx >= ref.width()) || (ty >= ref.height()))
+                continue;
+              ref.drawPixel(
+                  tx, ty, rop(ref.getPixel(tx, ty), src.getPixel(fx, fy), op));
+            }
+          snprintf(what, sizeof(what),
+                   "canvas: rotation %d/%d block %d from %d rop %d", r & 3,
+                   r >> 2, b, f, op);
+          check(same(dst, ref), what);
+        }
+      }
+    }
+  }
+}
+
+int main(void) {
+  testBitmap();
+  testCanvas();
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
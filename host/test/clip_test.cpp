@@ -0,0 +1,193 @@
+/*!
+ * @file clip_test.cpp
+ *
+ * Host-side checks of the clip rect stack. Nested pushClipRect() calls
+ * must intersect and pop back in order, and a push past GFX_CLIP_DEPTH
+ * must be refused. Every primitive drawn through a clip rect, at every
+ * rotation, must match the same primitive drawn unclipped inside the rect
+ * and leave every pixel outside it untouched.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <Adafruit_GFX.h>
+#include <Adafruit_GFXRenderer.h>
+#include <Fonts/FreeSans9pt7b.h>
+
+#define TEST_W 48 ///< Canvas width in pixels, at rotation 0
+#define TEST_H 36 ///< Canvas height in pixels, at rotation 0
+#define OPS 9     ///< Number of cases in draw()
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint16_t icon[20 * 20];
+static uint8_t gray[20 * 20], mask[(20 + 7) / 8 * 20], bits[(20 + 7) / 8 * 20];
+
+// Draw case op, reaching well past the clip rect on every side
+template <class G> static void draw(G &gfx, uint8_t op) {
+  static const int16_t star[] = {20, -6, 30, 40, -8, 10, 50, 10, 8, 40};
+  switch (op) {
+  case 0:
+    gfx.fillRect(-5, -5, 80, 60, 0xF81F);
+    break;
+  case 1:
+    gfx.drawLine(-10, -3, 50, 35, 0x07E0);
+    gfx.drawLine(40, -2, 2, 50, 0x001F);
+    gfx.drawFastHLine(-4, 12, 70, 0xFFFF);
+    gfx.drawFastVLine(11, -4, 70, 0xFFFF);
+    break;
+  case 2:
+    gfx.drawChar(2, 1, 'Q', 0xFFE0, 0x0841, 3);
+    break;
+  case 3:
+    gfx.setFont(&FreeSans9pt7b);
+    gfx.drawChar(3, 22, 'W', 0x07FF, 0x07FF, 2);
+    gfx.setFont();
+    break;
+  case 4:
+    gfx.drawRGBBitmap(1, 3, icon, 20, 20);
+    break;
+  case 5:
+    gfx.drawRGBBitmap(8, 6, icon, mask, 20, 20);
+    break;
+  case 6:
+    gfx.drawBitmap(4, 2, bits, 20, 20, 0xFFFF, 0x0000);
+    gfx.drawBitmap(12, 9, bits, 20, 20, 0x8410);
+    break;
+  case 7:
+    gfx.drawGrayscaleBitmap(6, 5, gray, 20, 20);
+    break;
+  default:
+    gfx.fillCircle(14, 14, 16, 0xA514);
+    gfx.fillPolygon(star, 5, 0x5555);
+    break;
+  }
+}
+
+// Fill with a pattern every canvas format keeps some of
+template <class G> static void pattern(G &gfx) {
+  for (int16_t y = 0; y < gfx.height(); y++)
+    for (int16_t x = 0; x < gfx.width(); x++)
+      gfx.drawPixel(x, y, (x * 37 + y * 101) ^ (((x ^ y) & 1) ? 0xFFFF : 0));
+}
+
+template <class G> static void testStack(const char *name) {
+  G gfx(TEST_W, TEST_H);
+  int16_t x, y, w, h;
+  char what[80];
+
+  check(gfx.pushClipRect(5, 4, 30, 20), "first push refused");
+  check(gfx.pushClipRect(-10, 8, 28, 100), "second push refused");
+  gfx.getClipRect(&x, &y, &w, &h);
+  snprintf(what, sizeof(what), "%s: nested clip rects do not intersect",
+           name);
+  check((x == 5) && (y == 8) && (w == 13) && (h == 16), what);
+  gfx.popClipRect();
+  gfx.getClipRect(&x, &y, &w, &h);
+  snprintf(what, sizeof(what), "%s: pop does not restore the outer rect",
+           name);
+  check((x == 5) && (y == 4) && (w == 30) && (h == 20), what);
+  gfx.popClipRect();
+  gfx.popClipRect(); // One too many: harmless
+  gfx.getClipRect(&x, &y, &w, &h);
+  snprintf(what, sizeof(what), "%s: last pop does not restore the screen",
+           name);
+  check((x == 0) && (y == 0) && (w == TEST_W) && (h == TEST_H), what);
+
+  for (uint8_t i = 0; i < GFX_CLIP_DEPTH; i++)
+    check(gfx.pushClipRect(i, i, TEST_W, TEST_H), "push within depth");
+  snprintf(what, sizeof(what), "%s: push past GFX_CLIP_DEPTH accepted", name);
+  check(!gfx.pushClipRect(20, 20, 2, 2), what);
+  gfx.getClipRect(&x, &y, &w, &h);
+  snprintf(what, sizeof(what), "%s: refused push changed the clip", name);
+  check((x == GFX_CLIP_DEPTH - 1) && (y == GFX_CLIP_DEPTH - 1) &&
+            (w == TEST_W - x) && (h == TEST_H - y),
+        what);
+  gfx.setRotation(1);
+  gfx.getClipRect(&x, &y, &w, &h);
+  snprintf(what, sizeof(what), "%s: setRotation() kept the clip stack", name);
+  check((x == 0) && (y == 0) && (w == TEST_H) && (h == TEST_W), what);
+
+  // Disjoint rects leave nothing to draw into
+  gfx.setRotation(0);
+  gfx.fillScreen(0);
+  gfx.pushClipRect(0, 0, 10, 10);
+  gfx.pushClipRect(20, 20, 10, 10);
+  gfx.fillRect(0, 0, TEST_W, TEST_H, 0xFFFF);
+  gfx.popClipRect();
+  gfx.popClipRect();
+  bool drawn = false;
+  for (y = 0; y < TEST_H; y++)
+    for (x = 0; x < TEST_W; x++)
+      drawn |= gfx.getPixel(x, y) != 0;
+  snprintf(what, sizeof(what), "%s: empty clip rect drew pixels", name);
+  check(!drawn, what);
+}
+
+template <class G> static void testDraw(const char *name) {
+  G clipped(TEST_W, TEST_H), whole(TEST_W, TEST_H), before(TEST_W, TEST_H);
+  char what[80];
+
+  for (uint8_t r = 0; r < 4; r++) {
+    for (uint8_t op = 0; op < OPS; op++) {
+      clipped.setRotation(r);
+      whole.setRotation(r);
+      before.setRotation(r);
+      pattern(clipped);
+      pattern(whole);
+      pattern(before);
+
+      // Intersects to x 5-17, y 8-23
+      clipped.pushClipRect(5, 4, 30, 20);
+      clipped.pushClipRect(-10, 8, 13 + 10 + 5, 100);
+      draw(clipped, op);
+      clipped.popClipRect();
+      clipped.popClipRect();
+      draw(whole, op);
+
+      bool outside = true, inside = true;
+      for (int16_t y = 0; y < clipped.height(); y++)
+        for (int16_t x = 0; x < clipped.width(); x++) {
+          if ((x >= 5) && (x < 18) && (y >= 8) && (y < 24))
+            inside &= clipped.getPixel(x, y) == whole.getPixel(x, y);
+          else
+            outside &= clipped.getPixel(x, y) == before.getPixel(x, y);
+        }
+      snprintf(what, sizeof(what), "%s rotation %d case %d: outside changed",
+               name, r, op);
+      check(outside, what);
+      snprintf(what, sizeof(what), "%s rotation %d case %d: inside differs",
+               name, r, op);
+      check(inside, what);
+    }
+  }
+}
+
+int main(void) {
+  for (uint16_t i = 0; i < 20 * 20; i++) {
+    icon[i] = i * 2654435761u >> 16;
+    gray[i] = i * 7 + 3;
+  }
+  for (uint16_t i = 0; i < sizeof(mask); i++) {
+    mask[i] = (i * 0x9E) ^ 0x5A;
+    bits[i] = (i * 0x3B) ^ 0xC3;
+  }
+
+  testStack<GFXcanvas1>("canvas1");
+  testStack<GFXcanvas16>("canvas16");
+  testDraw<GFXcanvas1>("canvas1");
+  testDraw<GFXcanvas8>("canvas8");
+  testDraw<GFXcanvas16>("canvas16");
+  testDraw<GFXRenderer<GFXcanvas16>>("renderer16");
+
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,302 @@
+/*!
+ * @file displaylist_test.cpp
+ *
+ * Host-side checks of GFXDisplayList. A scene of shapes, text, bitmaps
+ * and nested clip rects is recorded and also drawn straight onto a
+ * GFXcanvas16; replay() onto a canvas or a CaptureTFT, redraw() of part
+ * of it and renderBands() must all give the same pixels. redraw() must
+ * skip the commands that miss its rect, a list whose clip rects don't fit
+ * the target's stack must leave that stack as it was, and a list that
+ * ran out of buffer must replay just the commands before the first one
+ * that did not fit. Replaying text must leave the target's own font,
+ * font chain and cursor as they were.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "CaptureTFT.h"
+#include <Adafruit_GFXDisplayList.h>
+#include <Fonts/FreeMono9pt7b.h>
+#include <Fonts/FreeSans9pt7b.h>
+
+#define LIST_W 120 ///< List width in pixels
+#define LIST_H 90  ///< List height in pixels
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint16_t icon[16 * 12];
+static uint8_t mask[2 * 12], bits[2 * 12];
+
+// Everything the list records as its own commands, plus nested clip rects
+template <class G> static void scene(G &gfx) {
+  gfx.fillScreen(0x18E3);
+  gfx.fillRect(-10, 5, 50, 20, 0xF800);
+  gfx.drawLine(0, 0, LIST_W + 20, LIST_H - 1, 0x07E0);
+  gfx.drawPixel(60, 3, 0xFFFF);
+  gfx.drawCircle(90, 30, 25, 0x001F);
+  gfx.fillCircle(20, 70, 12, 0xFFE0);
+  gfx.drawTriangle(50, 50, 110, 60, 70, 88, 0xF81F);
+  gfx.fillTriangle(5, 40, 40, 35, 25, 60, 0x07FF);
+  gfx.drawRoundRect(60, 5, 50, 30, 8, 0x8410);
+  gfx.fillRoundRect(75, 60, 40, 25, 6, 0x4208);
+  gfx.drawBitmap(3, 28, bits, 16, 12, 0xFFFF, 0x0000);
+  gfx.drawBitmap(100, 40, bits, 16, 12, 0xF800);
+  gfx.drawRGBBitmap(40, 20, icon, 16, 12);
+  gfx.drawRGBBitmap(110, 80, icon, mask, 16, 12); // Runs off the edges
+  gfx.setCursor(2, 80);
+  gfx.setTextColor(0xFFFF, 0x0010);
+  gfx.print("Hi!");
+  gfx.pushClipRect(30, 30, 60, 40);
+  gfx.fillCircle(60, 50, 30, 0xFD20);
+  gfx.pushClipRect(50, 0, 100, 55);
+  gfx.fillRect(0, 0, LIST_W, LIST_H, 0x2945);
+  gfx.popClipRect();
+  gfx.setFont(&FreeSans9pt7b);
+  gfx.setCursor(32, 60);
+  gfx.setTextColor(0x07E0);
+  gfx.print("Clip");
+  gfx.setFont();
+  gfx.popClipRect();
+  gfx.setCursor(70, 72);
+  gfx.print("wraps at the edge");
+}
+
+static bool same(const GFXcanvas16 &a, const GFXcanvas16 &b, int16_t x = 0,
+                 int16_t y = 0) {
+  for (int16_t j = 0; j < LIST_H; j++)
+    for (int16_t i = 0; i < LIST_W; i++)
+      if (a.getPixel(x + i, y + j) != b.getPixel(i, j))
+        return false;
+  return true;
+}
+
+/// A canvas that counts the rects it is asked to fill
+class CountingCanvas : public GFXcanvas16 {
+public:
+  CountingCanvas(uint16_t w, uint16_t h) : GFXcanvas16(w, h) {}
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    rects++;
+    GFXcanvas16::fillRect(x, y, w, h, color);
+  }
+  uint16_t rects = 0; ///< fillRect() calls so far
+};
+
+static void testReplay(const GFXDisplayList &list, const GFXcanvas16 &ref) {
+  GFXcanvas16 canvas(LIST_W, LIST_H), big(LIST_W + 30, LIST_H + 20);
+
+  check(canvas.getBuffer() && big.getBuffer(), "canvas allocation");
+  canvas.fillScreen(0x1234);
+  list.replay(canvas);
+  check(same(canvas, ref), "replay onto GFXcanvas16 differs");
+
+  canvas.fillScreen(0x1234);
+  list.replay((Adafruit_GFX &)canvas);
+  check(same(canvas, ref), "replay onto Adafruit_GFX differs");
+
+  // Offset: the list's edges bound what it draws
+  big.fillScreen(0x1234);
+  list.replay(big, 20, 10);
+  check(same(big, ref, 20, 10), "offset replay differs");
+  bool outside = true;
+  for (int16_t y = 0; y < big.height(); y++)
+    for (int16_t x = 0; x < big.width(); x++)
+      if ((x < 20) || (y < 10) || (x >= 20 + LIST_W) || (y >= 10 + LIST_H))
+        outside &= big.getPixel(x, y) == 0x1234;
+  check(outside, "offset replay drew outside the list");
+
+  // Part of it, over other content
+  canvas.fillScreen(0x1234);
+  list.redraw(canvas, 25, 15, 40, 50);
+  bool redrawn = true;
+  for (int16_t y = 0; y < LIST_H; y++)
+    for (int16_t x = 0; x < LIST_W; x++) {
+      bool in = (x >= 25) && (y >= 15) && (x < 65) && (y < 65);
+      redrawn &= canvas.getPixel(x, y) == (in ? ref.getPixel(x, y) : 0x1234);
+    }
+  check(redrawn, "redraw() differs");
+  int16_t x, y, w, h;
+  canvas.getClipRect(&x, &y, &w, &h);
+  check(!x && !y && (w == LIST_W) && (h == LIST_H),
+        "redraw() left a clip rect pushed");
+
+  // A target whose clip stack is full: the list's own clip rects can't be
+  // pushed, but replay must leave the stack as it found it
+  canvas.fillScreen(0x1234);
+  for (uint8_t i = 0; i < GFX_CLIP_DEPTH; i++)
+    canvas.pushClipRect(i, i, LIST_W, LIST_H);
+  list.replay(canvas);
+  canvas.getClipRect(&x, &y, &w, &h);
+  check((x == GFX_CLIP_DEPTH - 1) && (y == x) && (w == LIST_W - x) &&
+            (h == LIST_H - y),
+        "replay onto a full clip stack changed it");
+  for (uint8_t i = 0; i < GFX_CLIP_DEPTH; i++)
+    canvas.popClipRect();
+
+  // A display, and a display drawn a band at a time
+  CaptureTFT tft(LIST_W + 8, LIST_H + 8);
+  tft.begin();
+  list.replay(tft);
+  bool shown = true;
+  for (y = 0; y < LIST_H; y++)
+    for (x = 0; x < LIST_W; x++)
+      shown &= tft.getPixel(x, y) == ref.getPixel(x, y);
+  check(shown, "replay onto a display differs");
+
+  CaptureTFT banded(LIST_W + 8, LIST_H + 8);
+  GFXcanvas16 band(LIST_W, 16), wrong(LIST_W - 1, 16);
+  banded.begin();
+  check(!list.renderBands(banded, wrong), "renderBands() took a narrow band");
+  check(banded.windows.empty(), "refused renderBands() sent something");
+  check(list.renderBands(banded, band, 0x1234), "renderBands() failed");
+  shown = banded.windows.size() == (LIST_H + 15) / 16;
+  for (size_t i = 0; shown && (i < banded.windows.size()); i++)
+    shown = (banded.windows[i].x == 0) && (banded.windows[i].y == i * 16) &&
+            (banded.windows[i].w == LIST_W) &&
+            (banded.windows[i].h == ((i * 16 + 16 <= LIST_H) ? 16 : 10));
+  check(shown, "renderBands() windows");
+  shown = true;
+  for (y = 0; y < LIST_H; y++)
+    for (x = 0; x < LIST_W; x++)
+      shown &= banded.getPixel(x, y) == ref.getPixel(x, y);
+  check(shown, "renderBands() differs");
+}
+
+static void testCulling(void) {
+  GFXDisplayList grid(LIST_W, LIST_H);
+  CountingCanvas canvas(LIST_W, LIST_H);
+
+  // A 4 x 3 grid of 30 x 30 cells
+  for (int16_t y = 0; y < LIST_H; y += 30)
+    for (int16_t x = 0; x < LIST_W; x += 30)
+      grid.fillRect(x, y, 30, 30, x * 7 + y * 131);
+  grid.replay(canvas);
+  check(canvas.rects == 12, "replay skipped visible rects");
+  canvas.rects = 0;
+  grid.redraw(canvas, 35, 35, 20, 20); // Inside one cell
+  check(canvas.rects == 1, "redraw() of one cell drew other cells");
+  canvas.rects = 0;
+  grid.redraw(canvas, 25, 55, 10, 10); // Across four
+  check(canvas.rects == 4, "redraw() across four cells");
+  canvas.rects = 0;
+  canvas.pushClipRect(200, 0, 10, 10); // Off the canvas altogether
+  grid.replay(canvas);
+  canvas.popClipRect();
+  check(canvas.rects == 0, "replay into an empty clip rect drew");
+}
+
+static void testOverflow(void) {
+  uint8_t buffer[100];
+  GFXDisplayList list(LIST_W, LIST_H, buffer, sizeof(buffer));
+  GFXcanvas16 ref(LIST_W, LIST_H), canvas(LIST_W, LIST_H);
+  uint32_t length = 0;
+  uint8_t fitted = 0;
+
+  for (uint8_t i = 0; i < 10; i++) {
+    list.fillRect(i * 10, i * 5, 30, 30, 0x1111 * i);
+    if (!list.overflowed()) {
+      ref.fillRect(i * 10, i * 5, 30, 30, 0x1111 * i);
+      fitted++;
+      check(list.length() > length, "recorded command took no room");
+      length = list.length();
+    } else {
+      check(list.length() == length, "command that did not fit took room");
+    }
+  }
+  check(list.overflowed() && (fitted > 0) && (fitted < 10),
+        "100 bytes fitted none or all of the rects");
+  list.drawPixel(0, 0, 0xFFFF); // Small enough, but after the first miss
+  check(list.length() == length, "list took a command after overflowing");
+  list.replay(canvas);
+  check(same(canvas, ref), "overflowed list replay differs");
+
+  list.clear();
+  check(!list.overflowed() && !list.length(), "clear() kept the overflow");
+  list.drawPixel(0, 0, 0xFFFF);
+  check(list.length() && !list.overflowed(), "record after clear() failed");
+}
+
+// Print on a canvas after replaying onto it, as on one the scene was drawn
+// on directly, set up by setup(): font and cursor must carry on
+static void testTargetState(const GFXDisplayList &list,
+                            const GFXcanvas16 &ref,
+                            void (*setup)(Adafruit_GFX &), const char *what) {
+  GFXcanvas16 canvas(LIST_W, LIST_H), expect(LIST_W, LIST_H);
+  const GFXfont *font;
+  const GFXfont *const *chain;
+  uint8_t n, expectN;
+  char msg[80];
+
+  expect.drawRGBBitmap(0, 0, ref.getBuffer(), LIST_W, LIST_H);
+  setup(expect);
+  setup(canvas);
+  font = canvas.getFont();
+  chain = canvas.getFontChain(&n);
+  list.replay(canvas);
+  snprintf(msg, sizeof(msg), "%s: replay changed the font", what);
+  check(canvas.getFont() == font, msg);
+  snprintf(msg, sizeof(msg), "%s: replay changed the font chain", what);
+  check((canvas.getFontChain(&expectN) == chain) && (expectN == n), msg);
+  snprintf(msg, sizeof(msg), "%s: replay moved the cursor", what);
+  check((canvas.getCursorX() == expect.getCursorX()) &&
+            (canvas.getCursorY() == expect.getCursorY()),
+        msg);
+  canvas.print("Ag");
+  expect.print("Ag");
+  snprintf(msg, sizeof(msg), "%s: text printed after replay differs", what);
+  check(same(canvas, expect), msg);
+}
+
+static const GFXfont *const chain[] = {&FreeMono9pt7b, &FreeSans9pt7b};
+
+static void classicSetup(Adafruit_GFX &gfx) {
+  gfx.setCursor(7, 30);
+  gfx.setTextColor(0xF800);
+}
+
+static void fontSetup(Adafruit_GFX &gfx) {
+  gfx.setFont(&FreeMono9pt7b);
+  gfx.setCursor(7, 30);
+  gfx.setTextColor(0xF800);
+}
+
+static void chainSetup(Adafruit_GFX &gfx) {
+  gfx.setFontChain(chain, 2);
+  gfx.setCursor(7, 30);
+  gfx.setTextColor(0xF800);
+}
+
+int main(void) {
+  for (uint16_t i = 0; i < 16 * 12; i++)
+    icon[i] = i * 2654435761u >> 16;
+  for (uint8_t i = 0; i < sizeof(mask); i++) {
+    mask[i] = (i * 0x9E) ^ 0x5A;
+    bits[i] = (i * 0x3B) ^ 0xC3;
+  }
+
+  GFXDisplayList list(LIST_W, LIST_H);
+  GFXcanvas16 ref(LIST_W, LIST_H);
+  if (!list.getBuffer() || !ref.getBuffer()) {
+    printf("FAIL: allocation\n");
+    return 1;
+  }
+  scene(list);
+  scene(ref);
+  check(!list.overflowed(), "scene overflowed the default list");
+  testReplay(list, ref);
+  testTargetState(list, ref, classicSetup, "classic font");
+  testTargetState(list, ref, fontSetup, "custom font");
+  testTargetState(list, ref, chainSetup, "font chain");
+  testCulling();
+  testOverflow();
+
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
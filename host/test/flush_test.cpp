@@ -0,0 +1,232 @@
+/*!
+ * @file flush_test.cpp
+ *
+ * Host-side checks of GFXcanvas16::flushDirty(): the areas drawing marks
+ * dirty, the rects nextDirtyRect() merges them into, and the windows and
+ * pixels a CaptureTFT receives for them; and of flushDiff(): the spans it
+ * finds against the kept frame and how it joins them across short gaps.
+ * A flush with nothing changed must send nothing.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "CaptureTFT.h"
+
+#define TFT_W 80    ///< Display width in pixels
+#define TFT_H 60    ///< Display height in pixels
+#define CANVAS_W 50 ///< Canvas width: 4 tiles, the last one partly used
+#define CANVAS_H 40 ///< Canvas height: 3 tiles, the last one partly used
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// The windows the display got since the last call, against a list of
+// x, y, w, h
+static bool sent(CaptureTFT &tft, const int16_t (*expect)[4], size_t n) {
+  bool ok = tft.windows.size() == n;
+  for (size_t i = 0; ok && (i < n); i++)
+    ok = (tft.windows[i].x == expect[i][0]) &&
+         (tft.windows[i].y == expect[i][1]) &&
+         (tft.windows[i].w == expect[i][2]) &&
+         (tft.windows[i].h == expect[i][3]);
+  if (!ok)
+    for (size_t i = 0; i < tft.windows.size(); i++)
+      printf("  window %d,%d %dx%d\n", tft.windows[i].x, tft.windows[i].y,
+             tft.windows[i].w, tft.windows[i].h);
+  tft.clearWindows();
+  return ok;
+}
+
+// Whether the display shows the raw canvas buffer at x,y, where visible
+static bool shows(const CaptureTFT &tft, const GFXcanvas16 &canvas, int16_t x,
+                  int16_t y) {
+  const uint16_t *buffer = canvas.getBuffer();
+  for (int16_t j = 0; j < CANVAS_H; j++)
+    for (int16_t i = 0; i < CANVAS_W; i++)
+      if ((x + i >= 0) && (y + j >= 0) && (x + i < TFT_W) &&
+          (y + j < TFT_H) &&
+          (tft.getPixel(x + i, y + j) != buffer[j * CANVAS_W + i]))
+        return false;
+  return true;
+}
+
+static void noise(GFXcanvas16 &canvas, uint16_t seed) {
+  for (int16_t y = 0; y < CANVAS_H; y++)
+    for (int16_t x = 0; x < CANVAS_W; x++)
+      canvas.drawPixel(x, y, (x * 31 + y * 1009) ^ seed);
+}
+
+static void testDirty(void) {
+  CaptureTFT tft(TFT_W, TFT_H);
+  GFXcanvas16 canvas(CANVAS_W, CANVAS_H);
+  tft.begin();
+
+  // Not tracking: the whole canvas, every time
+  noise(canvas, 0x1234);
+  canvas.flushDirty(tft, 5, 7);
+  static const int16_t whole[][4] = {{5, 7, CANVAS_W, CANVAS_H}};
+  check(sent(tft, whole, 1), "untracked flush is not one full window");
+  check(shows(tft, canvas, 5, 7), "untracked flush pixels differ");
+
+  // Turning tracking on marks everything, as one merged rect
+  check(canvas.trackDirty(true), "trackDirty() failed");
+  canvas.flushDirty(tft, 5, 7);
+  check(sent(tft, whole, 1), "first tracked flush is not one full window");
+
+  uint32_t pixels = tft.pixelsOut;
+  canvas.flushDirty(tft, 5, 7);
+  check(sent(tft, NULL, 0) && (tft.pixelsOut == pixels),
+        "flush with nothing drawn sent something");
+
+  // A pixel in tile (1,0) and a rect over tiles (1,1)-(2,2): the run at
+  // tile column 1 grows down all three rows, then column 2 from row 1
+  canvas.drawPixel(20, 3, 0xF800);
+  canvas.fillRect(30, 18, 10, 20, 0x07E0);
+  canvas.flushDirty(tft, 5, 7);
+  static const int16_t two[][4] = {{21, 7, 16, 40}, {37, 23, 16, 24}};
+  check(sent(tft, two, 2), "pixel and rect flush windows");
+  check(shows(tft, canvas, 5, 7), "pixel and rect flush pixels differ");
+
+  // Partial right-hand tile, at rotation 1: logical (0,0) is raw
+  // (WIDTH-1,0)
+  canvas.setRotation(1);
+  canvas.drawPixel(0, 0, 0x001F);
+  canvas.setRotation(0);
+  canvas.flushDirty(tft, 5, 7);
+  static const int16_t corner[][4] = {{53, 7, 2, 16}};
+  check(sent(tft, corner, 1), "rotated pixel flush window");
+  check(shows(tft, canvas, 5, 7), "rotated pixel flush pixels differ");
+
+  // Clipped drawing marks nothing outside the clip rect
+  canvas.pushClipRect(0, 0, 8, 8);
+  canvas.fillRect(0, 0, CANVAS_W, CANVAS_H, 0xFFFF);
+  canvas.popClipRect();
+  canvas.flushDirty(tft, 5, 7);
+  static const int16_t clipped[][4] = {{5, 7, 16, 16}};
+  check(sent(tft, clipped, 1), "clipped fill flush window");
+  check(shows(tft, canvas, 5, 7), "clipped fill flush pixels differ");
+
+  // Forgotten changes are not sent
+  canvas.fillRect(10, 10, 5, 5, 0x1234);
+  canvas.clearDirty();
+  canvas.flushDirty(tft, 5, 7);
+  check(sent(tft, NULL, 0), "flush after clearDirty() sent something");
+  canvas.markDirty(10, 10, 5, 5); // Now send them after all
+  canvas.flushDirty(tft, 5, 7);
+  check(sent(tft, clipped, 1), "markDirty() over a cleared fill window");
+  check(shows(tft, canvas, 5, 7), "markDirty() over a cleared fill differs");
+
+  // markDirty() for writes straight into the buffer
+  canvas.getBuffer()[35 * CANVAS_W + 49] = 0xABCD;
+  canvas.markDirty(49, 35, 1, 1);
+  canvas.flushDirty(tft, 5, 7);
+  static const int16_t marked[][4] = {{53, 39, 2, 8}};
+  check(sent(tft, marked, 1), "markDirty() corner flush window");
+  check(shows(tft, canvas, 5, 7), "markDirty() corner flush pixels differ");
+
+  // Areas hanging off the display are trimmed to it
+  canvas.fillScreen(0x5555);
+  canvas.flushDirty(tft, 40, -10);
+  static const int16_t trimmed[][4] = {{40, 0, 40, 30}};
+  check(sent(tft, trimmed, 1), "off-display flush window");
+  check(shows(tft, canvas, 40, -10), "off-display flush pixels differ");
+}
+
+static void testDiff(void) {
+  CaptureTFT tft(TFT_W, TFT_H);
+  GFXcanvas16 canvas(CANVAS_W, CANVAS_H);
+  tft.begin();
+
+  // No frame kept: the whole canvas, every time
+  noise(canvas, 0x4321);
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    canvas.flushDiff(tft, 5, 7);
+    static const int16_t whole[][4] = {{5, 7, CANVAS_W, CANVAS_H}};
+    check(sent(tft, whole, 1), "diff flush without a frame is not whole");
+  }
+
+  // The first flush after keepFrame() sends everything, the next nothing
+  check(canvas.keepFrame(true), "keepFrame() failed");
+  canvas.flushDiff(tft, 5, 7);
+  static const int16_t whole[][4] = {{5, 7, CANVAS_W, CANVAS_H}};
+  check(sent(tft, whole, 1), "first kept-frame flush is not whole");
+  check(shows(tft, canvas, 5, 7), "first kept-frame flush pixels differ");
+  uint32_t pixels = tft.pixelsOut;
+  canvas.flushDiff(tft, 5, 7);
+  check(sent(tft, NULL, 0) && (tft.pixelsOut == pixels),
+        "unchanged frame sent something");
+
+  // Redrawing the same pixels is no change either
+  noise(canvas, 0x4321);
+  canvas.flushDiff(tft, 5, 7);
+  check(sent(tft, NULL, 0) && (tft.pixelsOut == pixels),
+        "redrawn identical frame sent something");
+
+  // Changed pixels split by GFX_DIFF_GAP - 1 unchanged ones are joined,
+  // by GFX_DIFF_GAP they are not. Rows 3 and 4 end on the last column.
+  canvas.drawPixel(3, 1, ~canvas.getPixel(3, 1));
+  canvas.drawPixel(3 + GFX_DIFF_GAP, 1, ~canvas.getPixel(3 + GFX_DIFF_GAP, 1));
+  canvas.drawPixel(3, 2, ~canvas.getPixel(3, 2));
+  canvas.drawPixel(4 + GFX_DIFF_GAP, 2, ~canvas.getPixel(4 + GFX_DIFF_GAP, 2));
+  canvas.fillRect(40, 3, 10, 2, 0);
+  canvas.drawPixel(CANVAS_W - 1, 5, ~canvas.getPixel(CANVAS_W - 1, 5));
+  canvas.flushDiff(tft, 5, 7);
+  static const int16_t spans[][4] = {{8, 8, GFX_DIFF_GAP + 1, 1},
+                                     {8, 9, 1, 1},
+                                     {9 + GFX_DIFF_GAP, 9, 1, 1},
+                                     {45, 10, 10, 1},
+                                     {45, 11, 10, 1},
+                                     {54, 12, 1, 1}};
+  check(sent(tft, spans, 6), "diff spans");
+  check(shows(tft, canvas, 5, 7), "diff span pixels differ");
+  pixels = tft.pixelsOut;
+  canvas.flushDiff(tft, 5, 7);
+  check(sent(tft, NULL, 0) && (tft.pixelsOut == pixels),
+        "frame unchanged since the diff flush sent something");
+
+  // A wider gap argument joins more
+  canvas.drawPixel(0, 20, ~canvas.getPixel(0, 20));
+  canvas.drawPixel(30, 20, ~canvas.getPixel(30, 20));
+  canvas.flushDiff(tft, 5, 7, 31);
+  static const int16_t joined[][4] = {{5, 27, 31, 1}};
+  check(sent(tft, joined, 1), "diff with a wide gap");
+
+  // Random changes, sent partly off the display; keepFrame() again as
+  // the canvas moved
+  check(canvas.keepFrame(true), "keepFrame() again failed");
+  canvas.flushDiff(tft, 40, 30);
+  static const int16_t visible[][4] = {{40, 30, 40, 30}};
+  check(sent(tft, visible, 1), "resend after keepFrame() window");
+  uint32_t seed = 1;
+  for (uint8_t pass = 0; pass < 20; pass++) {
+    for (uint8_t k = 0; k < 30; k++) {
+      seed = seed * 1664525UL + 1013904223UL;
+      canvas.drawPixel((seed >> 8) % CANVAS_W, (seed >> 20) % CANVAS_H,
+                       seed >> 16);
+    }
+    canvas.flushDiff(tft, 40, 30);
+    bool inside = true;
+    for (size_t i = 0; i < tft.windows.size(); i++)
+      inside &= (tft.windows[i].h == 1) && (tft.windows[i].x >= 40) &&
+                (tft.windows[i].y >= 30) &&
+                (tft.windows[i].x + tft.windows[i].w <= TFT_W) &&
+                (tft.windows[i].y < TFT_H);
+    tft.clearWindows();
+    check(inside, "random diff window off the display");
+    check(shows(tft, canvas, 40, 30), "random diff pixels differ");
+  }
+}
+
+int main(void) {
+  testDirty();
+  testDiff();
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
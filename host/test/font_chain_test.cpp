@@ -0,0 +1,81 @@
+/*!
+ * @file font_chain_test.cpp
+ *
+ * Host-side checks of setFontChain() lookups through the glyph cache.
+ * Codepoints beyond Unicode, including 0xFFFFFFFF (the marker of an unused
+ * cache entry), must find no glyph and draw nothing; valid ones must draw
+ * as they do with setFont(), whether the cache misses or hits.
+ *
+ * The canvas under test is built in storage filled with a junk pattern, so
+ * a cache entry that setFontChain() leaves uninitialized is not quietly
+ * zero.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <Adafruit_GFX.h>
+#include <Fonts/FreeMono9pt7b.h>
+#include <Fonts/FreeSans9pt7b.h>
+
+#include <new>
+
+#define TEST_W 64 ///< Canvas width in pixels
+#define TEST_H 32 ///< Canvas height in pixels
+
+static const GFXfont *const chain[] = {&FreeSans9pt7b, &FreeMono9pt7b};
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static bool blank(const GFXcanvas1 &canvas) {
+  const uint8_t *buffer = canvas.getBuffer();
+  for (uint32_t i = 0; i < (TEST_W + 7) / 8 * TEST_H; i++)
+    if (buffer[i])
+      return false;
+  return true;
+}
+
+static bool same(const GFXcanvas1 &a, const GFXcanvas1 &b) {
+  return !memcmp(a.getBuffer(), b.getBuffer(), (TEST_W + 7) / 8 * TEST_H);
+}
+
+int main(void) {
+  alignas(GFXcanvas1) static uint8_t storage[sizeof(GFXcanvas1)];
+  memset(storage, 0xA5, sizeof(storage));
+  GFXcanvas1 *canvas = new (storage) GFXcanvas1(TEST_W, TEST_H);
+  GFXcanvas1 expect(TEST_W, TEST_H);
+  if (!canvas->getBuffer() || !expect.getBuffer()) {
+    printf("FAIL: canvas allocation\n");
+    return 1;
+  }
+  canvas->setFontChain(chain, 2);
+  expect.setFont(&FreeSans9pt7b);
+
+  // Not Unicode: nothing found, nothing drawn, nothing cached
+  static const uint32_t invalid[] = {0xFFFFFFFF, 0x110000, 0x7FFFFFFF};
+  for (uint8_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    canvas->drawCodepoint(4, 20, invalid[i], 1, 1, 1, 1);
+  check(blank(*canvas), "codepoints beyond U+10FFFF drew pixels");
+
+  // The first 'A' misses the cache, the second hits it
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    canvas->fillScreen(0);
+    expect.fillScreen(0);
+    canvas->drawCodepoint(4, 20, 'A', 1, 1, 1, 1);
+    expect.drawCodepoint(4, 20, 'A', 1, 1, 1, 1);
+    check(!blank(*canvas) && same(*canvas, expect),
+          pass ? "cached 'A' differs from setFont()"
+               : "uncached 'A' differs from setFont()");
+  }
+
+  canvas->~GFXcanvas1();
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
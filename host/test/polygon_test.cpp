@@ -0,0 +1,205 @@
+/*!
+ * @file polygon_test.cpp
+ *
+ * Host-side checks of fillPolygon() and drawPolygon(). Fills are compared
+ * with a pixel-by-pixel reference that tests each pixel center against
+ * every edge, under both GFX_FILL_EVEN_ODD and GFX_FILL_NONZERO, at every
+ * rotation: convex, concave and self-intersecting polygons, one wound
+ * twice, one with more vertices than GFX_POLYGON_EDGES, degenerate ones
+ * (fewer than 3 vertices, collinear, zero area) and ones with vertices
+ * far off the canvas, at the ends of the int16 range. Outlines are
+ * compared with the Bresenham line between each pair of vertices, worked
+ * out per pixel.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <Adafruit_GFX.h>
+
+#include <math.h>
+
+#define TEST_W 61 ///< Canvas width in pixels, at rotation 0
+#define TEST_H 47 ///< Canvas height in pixels, at rotation 0
+#define LO -32768 ///< Least int16 coordinate
+#define HI 32767  ///< Greatest int16 coordinate
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+/// A test polygon
+struct Polygon {
+  const char *name;  ///< For failure messages
+  uint16_t n;        ///< Number of vertices
+  const int16_t *xy; ///< n vertices as x,y pairs
+};
+
+static const int16_t square[] = {10, 8, 30, 8, 30, 28, 10, 28};
+static const int16_t concave[] = {5, 5, 50, 5, 50, 40, 28, 14, 5, 40};
+static const int16_t star[] = {30, 2, 42, 40, 8, 15, 52, 15, 18, 40};
+static const int16_t bowtie[] = {4, 4, 40, 36, 40, 4, 4, 36};
+static const int16_t twice[] = {8, 6,  40, 6,  40, 30, 8, 30,
+                                8, 6,  40, 6,  40, 30, 8, 30};
+static const int16_t reversed[] = {12, 10, 12, 26, 36, 26, 36, 10};
+static int16_t spiky[2 * 40];
+static const int16_t collinear[] = {5, 5, 20, 20, 35, 35};
+static const int16_t flat[] = {3, 9, 50, 9, 20, 9};
+static const int16_t spike[] = {10, 10, 40, 30, 10, 10, 40, 30};
+static const int16_t two[] = {3, 3, 50, 30};
+static const int16_t one[] = {7, 7};
+static const int16_t huge[] = {LO, LO, HI, LO, HI, HI, LO, HI};
+static const int16_t wedge[] = {LO, 20, HI, LO, HI, HI};
+static const int16_t shallow[] = {LO, 5, HI, 40, 30, 45};
+static const int16_t steps[] = {LO, 10, HI, 11, 0, 30};
+static const int16_t sliver[] = {LO, LO, HI, HI, HI, HI - 1};
+static const int16_t crossing[] = {LO, 0, HI, 40, HI, 0, LO, 40};
+
+static const Polygon polygons[] = {
+    {"square", 4, square},       {"concave", 5, concave},
+    {"star", 5, star},           {"bowtie", 4, bowtie},
+    {"twice", 8, twice},         {"reversed", 4, reversed},
+    {"spiky", 40, spiky},        {"collinear", 3, collinear},
+    {"flat", 3, flat},           {"spike", 4, spike},
+    {"two", 2, two},             {"one", 1, one},
+    {"none", 0, one},            {"huge", 4, huge},
+    {"wedge", 3, wedge},         {"shallow", 3, shallow},
+    {"steps", 3, steps},         {"sliver", 3, sliver},
+    {"crossing", 4, crossing}};
+
+// Whether the reference fills pixel x,y: -1 if an edge passes so close to
+// its center that fixed-point rounding may go either way
+static int8_t inside(const Polygon &p, int16_t x, int16_t y, uint8_t rule) {
+  double px = x + 0.5, py = y + 0.5;
+  int16_t wind = 0;
+  for (uint16_t i = 0; i < p.n; i++) {
+    const int16_t *a = &p.xy[i * 2], *b = &p.xy[((i + 1) % p.n) * 2];
+    if ((py < a[1]) == (py < b[1]))
+      continue; // Horizontal, or not across this scanline
+    double cx = a[0] + (py - a[1]) * (b[0] - a[0]) / (b[1] - a[1]);
+    if (fabs(cx - px) < 0.002)
+      return -1;
+    if (cx <= px)
+      wind += (b[1] > a[1]) ? 1 : -1;
+  }
+  return (rule == GFX_FILL_NONZERO) ? (wind != 0) : (wind & 1);
+}
+
+static void testFill(void) {
+  GFXcanvas1 canvas(TEST_W, TEST_H);
+  char what[80];
+
+  for (uint8_t r = 0; r < 4; r++) {
+    canvas.setRotation(r);
+    for (uint8_t i = 0; i < sizeof(polygons) / sizeof(polygons[0]); i++) {
+      const Polygon &p = polygons[i];
+      for (uint8_t rule = GFX_FILL_EVEN_ODD; rule <= GFX_FILL_NONZERO;
+           rule++) {
+        canvas.fillScreen(0);
+        canvas.fillPolygon(p.xy, p.n, 1, rule);
+        bool ok = true, any = false;
+        for (int16_t y = 0; y < canvas.height(); y++)
+          for (int16_t x = 0; x < canvas.width(); x++) {
+            int8_t in = (p.n < 3) ? 0 : inside(p, x, y, rule);
+            if (in >= 0)
+              ok &= canvas.getPixel(x, y) == in;
+            any |= canvas.getPixel(x, y);
+          }
+        snprintf(what, sizeof(what), "fill rotation %d %s rule %d", r, p.name,
+                 rule);
+        check(ok, what);
+        if ((p.xy == collinear) || (p.xy == flat) || (p.xy == spike) ||
+            (p.n < 3)) {
+          snprintf(what, sizeof(what), "fill rotation %d %s rule %d drew", r,
+                   p.name, rule);
+          check(!any, what);
+        }
+      }
+    }
+  }
+
+  // The rules differ where the winding is 2: the star's middle and the
+  // square wound twice
+  canvas.setRotation(0);
+  canvas.fillScreen(0);
+  canvas.fillPolygon(star, 5, 1, GFX_FILL_EVEN_ODD);
+  check(!canvas.getPixel(30, 20), "even-odd filled the star's middle");
+  canvas.fillPolygon(star, 5, 1, GFX_FILL_NONZERO);
+  check(canvas.getPixel(30, 20), "nonzero left the star's middle empty");
+  canvas.fillScreen(0);
+  canvas.fillPolygon(twice, 8, 1);
+  check(!canvas.getPixel(20, 20), "even-odd filled a square wound twice");
+  canvas.fillPolygon(twice, 8, 1, GFX_FILL_NONZERO);
+  check(canvas.getPixel(20, 20), "nonzero left a square wound twice empty");
+}
+
+// Whether gfxLine's Bresenham line from x0,y0 to x1,y1 sets pixel x,y:
+// at step k along the major axis the minor axis has moved
+// ceil((k * dy - dx / 2) / dx) times, if that is positive
+static bool onLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x,
+                   int32_t y) {
+  bool steep = llabs(y1 - y0) > llabs(x1 - x0);
+  int32_t t;
+  if (steep) {
+    t = x0, x0 = y0, y0 = t;
+    t = x1, x1 = y1, y1 = t;
+    t = x, x = y, y = t;
+  }
+  if (x0 > x1) {
+    t = x0, x0 = x1, x1 = t;
+    t = y0, y0 = y1, y1 = t;
+  }
+  if ((x < x0) || (x > x1))
+    return false;
+  int64_t dx = x1 - x0, dy = llabs(y1 - y0), k = x - x0;
+  int64_t num = k * dy - dx / 2, moves = 0;
+  if (num > 0)
+    moves = (num + dx - 1) / dx;
+  return y == y0 + ((y0 < y1) ? moves : -moves);
+}
+
+static void testOutline(void) {
+  GFXcanvas1 canvas(TEST_W, TEST_H);
+  char what[80];
+
+  for (uint8_t r = 0; r < 4; r++) {
+    canvas.setRotation(r);
+    for (uint8_t i = 0; i < sizeof(polygons) / sizeof(polygons[0]); i++) {
+      const Polygon &p = polygons[i];
+      canvas.fillScreen(0);
+      canvas.drawPolygon(p.xy, p.n, 1);
+      bool ok = true;
+      for (int16_t y = 0; y < canvas.height(); y++)
+        for (int16_t x = 0; x < canvas.width(); x++) {
+          bool on = false;
+          for (uint16_t e = 0; e < p.n; e++) {
+            const int16_t *a = &p.xy[e * 2], *b = &p.xy[((e + 1) % p.n) * 2];
+            on |= onLine(a[0], a[1], b[0], b[1], x, y);
+          }
+          ok &= canvas.getPixel(x, y) == on;
+        }
+      snprintf(what, sizeof(what), "outline rotation %d %s", r, p.name);
+      check(ok, what);
+    }
+  }
+}
+
+int main(void) {
+  // 20 spikes around a point off the middle: concave, and more vertices
+  // than the edge table on the stack holds
+  for (uint8_t i = 0; i < 40; i++) {
+    double a = i * M_PI / 20, d = (i & 1) ? 8 : 28;
+    spiky[i * 2] = lround(27 + d * cos(a));
+    spiky[i * 2 + 1] = lround(22 + d * sin(a));
+  }
+
+  testFill();
+  testOutline();
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+/*!
+ * @file scroll_test.cpp
+ *
+ * Host-side checks of scrolling. GFXcanvas1, GFXcanvas8 and GFXcanvas16
+ * scroll() must move a pattern by every sign of dx and dy, at every
+ * rotation, over the whole canvas, a rect, a rect hanging off the canvas
+ * and a clip rect, and fill exactly the part it leaves. Adafruit_SPITFT
+ * scroll() must show the area moved by the same rule on a CaptureTFT at
+ * every rotation, leave the rows outside the area alone and say where
+ * the filled rows start in frame memory.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "CaptureTFT.h"
+
+#define CANVAS_W 45 ///< Canvas width: rows end mid-byte on a GFXcanvas1
+#define CANVAS_H 33 ///< Canvas height
+#define TFT_W 40    ///< Display width in pixels
+#define TFT_H 56    ///< Display height in pixels
+#define AREA_Y 9    ///< First row of the hardware scroll area
+#define AREA_H 37   ///< Rows in the hardware scroll area
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Distances: each sign alone and mixed, one pixel, and more than a rect
+static const int16_t moves[][2] = {{3, 0},  {-3, 0},  {0, 2},  {0, -2},
+                                   {5, -4}, {-7, 3},  {1, 1},  {-1, -1},
+                                   {9, 0},  {0, -40}, {60, 5}, {-20, 0}};
+
+// Rects: x, y, w, h. Case 0 is the whole canvas, case 4 the whole canvas
+// through a clip rect; the last rect hangs off the top left corner.
+static const int16_t rects[][4] = {{0, 0, 0, 0},
+                                   {5, 3, 20, 11},
+                                   {17, 2, 9, 24},
+                                   {-4, -2, 15, 12},
+                                   {4, 6, 23, 19}};
+
+template <class G> static void pattern(G &gfx) {
+  for (int16_t y = 0; y < gfx.height(); y++)
+    for (int16_t x = 0; x < gfx.width(); x++)
+      gfx.drawPixel(x, y, (x * 37 + y * 101) ^ (((x ^ y) & 1) ? 0xFFFF : 0));
+}
+
+// Scroll case r of gfx by dx,dy and check every pixel against before.
+// fill is color as the canvas stores it.
+template <class G>
+static void testCase(G &gfx, const G &before, uint8_t r, int16_t dx,
+                     int16_t dy, uint16_t color, uint16_t fill,
+                     const char *what) {
+  int16_t x0 = 0, y0 = 0, x1 = gfx.width(), y1 = gfx.height();
+  if (r == 0) {
+    gfx.scroll(dx, dy, color);
+  } else if (r == 4) {
+    gfx.pushClipRect(rects[r][0], rects[r][1], rects[r][2], rects[r][3]);
+    gfx.scroll(dx, dy, color);
+    gfx.popClipRect();
+  } else {
+    gfx.scroll(dx, dy, rects[r][0], rects[r][1], rects[r][2], rects[r][3],
+               color);
+  }
+  if (r) {
+    x0 = (rects[r][0] > 0) ? rects[r][0] : 0;
+    y0 = (rects[r][1] > 0) ? rects[r][1] : 0;
+    if (rects[r][0] + rects[r][2] < x1)
+      x1 = rects[r][0] + rects[r][2];
+    if (rects[r][1] + rects[r][3] < y1)
+      y1 = rects[r][1] + rects[r][3];
+  }
+
+  bool kept = true, filled = true, moved = true;
+  for (int16_t y = 0; y < gfx.height(); y++)
+    for (int16_t x = 0; x < gfx.width(); x++) {
+      int16_t sx = x - dx, sy = y - dy;
+      uint16_t got = gfx.getPixel(x, y);
+      if ((x < x0) || (y < y0) || (x >= x1) || (y >= y1))
+        kept &= got == before.getPixel(x, y);
+      else if ((sx < x0) || (sy < y0) || (sx >= x1) || (sy >= y1))
+        filled &= got == fill;
+      else
+        moved &= got == before.getPixel(sx, sy);
+    }
+  char msg[100];
+  snprintf(msg, sizeof(msg), "%s: pixels outside the rect changed", what);
+  check(kept, msg);
+  snprintf(msg, sizeof(msg), "%s: uncovered pixels not filled", what);
+  check(filled, msg);
+  snprintf(msg, sizeof(msg), "%s: moved pixels differ", what);
+  check(moved, msg);
+}
+
+template <class G> static void testCanvas(const char *name) {
+  G gfx(CANVAS_W, CANVAS_H), before(CANVAS_W, CANVAS_H), one(1, 1);
+  char what[80];
+
+  for (uint8_t rot = 0; rot < 4; rot++) {
+    gfx.setRotation(rot);
+    before.setRotation(rot);
+    for (uint8_t r = 0; r < sizeof(rects) / sizeof(rects[0]); r++) {
+      for (uint8_t m = 0; m < sizeof(moves) / sizeof(moves[0]); m++) {
+        // Both fill colors, so a fill can't pass for the pattern
+        uint16_t color = (m & 1) ? 0xA5C3 : 0;
+        one.drawPixel(0, 0, color);
+        pattern(gfx);
+        pattern(before);
+        snprintf(what, sizeof(what), "%s rotation %d rect %d by %d,%d", name,
+                 rot, r, moves[m][0], moves[m][1]);
+        testCase(gfx, before, r, moves[m][0], moves[m][1], color,
+                 one.getPixel(0, 0), what);
+      }
+    }
+  }
+
+  // Nothing to move, or nothing visible to move: nothing changes
+  pattern(gfx);
+  pattern(before);
+  gfx.scroll(0, 0, 1);
+  gfx.scroll(3, 3, CANVAS_W, 0, 10, 10, 1);
+  gfx.scroll(3, 3, 0, 0, 0, 10, 1);
+  bool same = true;
+  for (int16_t y = 0; y < gfx.height(); y++)
+    for (int16_t x = 0; x < gfx.width(); x++)
+      same &= gfx.getPixel(x, y) == before.getPixel(x, y);
+  snprintf(what, sizeof(what), "%s: empty scroll changed pixels", name);
+  check(same, what);
+}
+
+static void testTFT(void) {
+  CaptureTFT tft(TFT_W, TFT_H);
+  static uint16_t shown[TFT_H][TFT_W], next[TFT_H][TFT_W];
+  static const int16_t steps[] = {4, -9, 1, -1, 0, 20, AREA_H + 5, -3,
+                                  -AREA_H, 13, -30, 2};
+  char what[80];
+  tft.begin();
+
+  check(tft.scroll(3, 0) == -1, "scroll() with no area did not return -1");
+  check(!tft.setScrollArea(TFT_H - 5, 6), "area past the panel accepted");
+
+  for (uint8_t rot = 0; rot < 4; rot++) {
+    // A pattern drawn unrotated, the area set up, then drawn at rot
+    tft.setRotation(0);
+    check(tft.setScrollArea(0, 0), "turning scrolling off failed");
+    for (int16_t y = 0; y < TFT_H; y++)
+      for (int16_t x = 0; x < TFT_W; x++) {
+        shown[y][x] = (x * 37 + y * 1009) ^ (rot << 12);
+        tft.drawPixel(x, y, shown[y][x]);
+      }
+    check(tft.setScrollArea(AREA_Y, AREA_H), "setScrollArea() failed");
+    tft.setRotation(rot);
+
+    for (uint8_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+      int16_t dy = steps[s];
+      uint16_t color = 0xF000 | s;
+      int16_t row = tft.scroll(dy, color);
+
+      // The panel's rows in the area move by dy and uncover the rest
+      int16_t n = abs(dy) < AREA_H ? abs(dy) : AREA_H;
+      for (int16_t y = 0; y < TFT_H; y++)
+        for (int16_t x = 0; x < TFT_W; x++) {
+          int16_t from = y - dy;
+          if ((y < AREA_Y) || (y >= AREA_Y + AREA_H))
+            next[y][x] = shown[y][x];
+          else if ((from < AREA_Y) || (from >= AREA_Y + AREA_H))
+            next[y][x] = color;
+          else
+            next[y][x] = shown[from][x];
+        }
+      memcpy(shown, next, sizeof(shown));
+
+      bool same = true;
+      for (int16_t y = 0; y < TFT_H; y++)
+        for (int16_t x = 0; x < TFT_W; x++)
+          same &= tft.getShownPixel(x, y) == shown[y][x];
+      snprintf(what, sizeof(what), "rotation %d step %d: panel differs", rot,
+               s);
+      check(same, what);
+
+      // The first uncovered panel row, top or bottom of the area, is in
+      // the frame memory row scroll() returned
+      if (n) {
+        int16_t first = (dy > 0) ? AREA_Y : AREA_Y + AREA_H - n;
+        int16_t expect =
+            AREA_Y + (first - AREA_Y + tft.startRow - AREA_Y) % AREA_H;
+        snprintf(what, sizeof(what), "rotation %d step %d: returned row %d",
+                 rot, s, row);
+        check(row == expect, what);
+      }
+    }
+  }
+
+  tft.setRotation(0);
+  check(tft.setScrollArea(0, 0), "turning scrolling off again failed");
+  check(tft.scroll(3, 0) == -1, "scroll() after turning off not -1");
+}
+
+int main(void) {
+  testCanvas<GFXcanvas1>("canvas1");
+  testCanvas<GFXcanvas8>("canvas8");
+  testCanvas<GFXcanvas16>("canvas16");
+  testTFT();
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
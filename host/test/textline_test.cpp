@@ -0,0 +1,173 @@
+/*!
+ * @file textline_test.cpp
+ *
+ * Host-side checks of Adafruit_SPITFT::drawTextLine(). What a CaptureTFT
+ * shows after it must match print() on a GFXcanvas16: the text alone when
+ * textbgcolor is textcolor, and otherwise the text over its box filled
+ * with textbgcolor, sent as one address window. Lines wider than
+ * SPITFT_TEXT_CHUNK, with more glyphs than SPITFT_TEXT_GLYPHS, in the
+ * classic and a custom font at two text sizes, and with text wrap on
+ * (which drawTextLine() must neither follow nor turn off) are covered.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "CaptureTFT.h"
+#include <Fonts/FreeSans9pt7b.h>
+
+#define TFT_W 320 ///< Display width: two SPITFT_TEXT_CHUNKs on the host
+#define TFT_H 48  ///< Display height in pixels
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Short, past the first chunk, past the glyph list and off the display,
+// and cut at a newline
+static const char *const texts[] = {
+    "Hello",
+    "Wide text runs past the first chunk",
+    "The quick brown fox jumps over the lazy dog, 0123456789 times!",
+    "Two\nlines"};
+
+// The same noise on the display and the canvas
+static void noise(CaptureTFT &tft, GFXcanvas16 &canvas) {
+  for (int16_t y = 0; y < TFT_H; y++)
+    for (int16_t x = 0; x < TFT_W; x++) {
+      uint16_t c = (x * 31 + y * 1009) ^ 0x5A5A;
+      tft.drawPixel(x, y, c);
+      canvas.drawPixel(x, y, c);
+    }
+  tft.clearWindows();
+}
+
+static bool same(const CaptureTFT &tft, const GFXcanvas16 &canvas) {
+  for (int16_t y = 0; y < TFT_H; y++)
+    for (int16_t x = 0; x < TFT_W; x++)
+      if (tft.getPixel(x, y) != canvas.getPixel(x, y))
+        return false;
+  return true;
+}
+
+// Text size s in font f (NULL: classic) on both
+static void setup(CaptureTFT &tft, GFXcanvas16 &canvas, const GFXfont *f,
+                  uint8_t s) {
+  tft.setFont(f);
+  canvas.setFont(f);
+  tft.setTextSize(s);
+  canvas.setTextSize(s);
+  canvas.setTextWrap(false);
+}
+
+// print() of one line of str at x,y on the canvas, in color
+static void printLine(GFXcanvas16 &canvas, int16_t x, int16_t y,
+                      const char *str, uint16_t color) {
+  canvas.setTextColor(color);
+  canvas.setCursor(x, y);
+  while (*str && (*str != '\n'))
+    canvas.print(*str++);
+}
+
+static void testText(void) {
+  CaptureTFT tft(TFT_W, TFT_H);
+  GFXcanvas16 canvas(TFT_W, TFT_H);
+  static const GFXfont *const fonts[] = {NULL, &FreeSans9pt7b};
+  char what[100];
+  tft.begin();
+
+  for (uint8_t f = 0; f < 2; f++) {
+    for (uint8_t s = 1; s <= 2; s++) {
+      setup(tft, canvas, fonts[f], s);
+      int16_t x = 7, y = f ? 14 * s : 3;
+      for (uint8_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        for (uint8_t wrap = 0; wrap < 2; wrap++) {
+          const char *str = texts[t];
+          tft.setTextWrap(wrap);
+          tft.setCursor(11, 12);
+
+          // bg == fg: just the text
+          noise(tft, canvas);
+          tft.setTextColor(0xFFE0);
+          tft.drawTextLine(x, y, str);
+          printLine(canvas, x, y, str, 0xFFE0);
+          snprintf(what, sizeof(what),
+                   "font %d size %d text %d wrap %d: transparent differs", f,
+                   s, t, wrap);
+          check(same(tft, canvas), what);
+
+          // bg != fg: the text's bounds filled, then the text, in one
+          // window
+          noise(tft, canvas);
+          tft.setTextColor(0x07FF, 0x8010);
+          tft.drawTextLine(x, y, str);
+          int16_t bx, by;
+          uint16_t bw, bh;
+          canvas.getTextBounds(str, x, y, &bx, &by, &bw, &bh);
+          if (strchr(str, '\n')) { // First line only
+            char first[8];
+            snprintf(first, sizeof(first), "%.*s",
+                     (int)(strchr(str, '\n') - str), str);
+            canvas.getTextBounds(first, x, y, &bx, &by, &bw, &bh);
+          }
+          canvas.fillRect(bx, by, bw, bh, 0x8010);
+          printLine(canvas, x, y, str, 0x07FF);
+          snprintf(what, sizeof(what),
+                   "font %d size %d text %d wrap %d: opaque differs", f, s, t,
+                   wrap);
+          check(same(tft, canvas), what);
+          int16_t w = (bx + bw > TFT_W) ? TFT_W - bx : bw;
+          snprintf(what, sizeof(what),
+                   "font %d size %d text %d wrap %d: not one window", f, s,
+                   t, wrap);
+          check((tft.windows.size() == 1) && (tft.windows[0].x == bx) &&
+                    (tft.windows[0].y == by) && (tft.windows[0].w == w) &&
+                    (tft.windows[0].h == bh),
+                what);
+
+          // In a given box, partly off the display: text outside it is
+          // cut off
+          noise(tft, canvas);
+          tft.drawTextLine(x, y, str, 40, -5, TFT_W, y + 2);
+          canvas.fillRect(40, -5, TFT_W, y + 2, 0x8010);
+          canvas.pushClipRect(40, -5, TFT_W, y + 2);
+          printLine(canvas, x, y, str, 0x07FF);
+          canvas.popClipRect();
+          snprintf(what, sizeof(what),
+                   "font %d size %d text %d wrap %d: boxed differs", f, s, t,
+                   wrap);
+          check(same(tft, canvas), what);
+
+          snprintf(what, sizeof(what),
+                   "font %d size %d text %d wrap %d: cursor moved", f, s, t,
+                   wrap);
+          check((tft.getCursorX() == 11) && (tft.getCursorY() == 12), what);
+        }
+
+        // Wrap is still on: print() past the right edge wraps
+        noise(tft, canvas);
+        tft.setCursor(TFT_W - 20, y);
+        tft.print("wrap");
+        canvas.setTextColor(0x07FF, 0x8010);
+        canvas.setTextWrap(true);
+        canvas.setCursor(TFT_W - 20, y);
+        canvas.print("wrap");
+        canvas.setTextWrap(false);
+        snprintf(what, sizeof(what), "font %d size %d text %d: wrap lost", f,
+                 s, t);
+        check(same(tft, canvas), what);
+      }
+    }
+  }
+}
+
+int main(void) {
+  testText();
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,199 @@
+/*!
+ * @file utf8_test.cpp
+ *
+ * Host-side checks of the UTF-8 decoding behind print(). Valid sequences
+ * of every length, up to U+10FFFF, must come out as their codepoints,
+ * also when split across print() calls. Overlong forms, surrogates,
+ * values past U+10FFFF, bytes no codepoint starts with, stray
+ * continuation bytes and truncated sequences must be dropped without
+ * eating the text around them. With the classic font, utf8() and cp437()
+ * must pick the same glyphs as writeCodepoint() and drawChar() do.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <Adafruit_GFX.h>
+
+#define TEST_W 64 ///< Canvas width in pixels
+#define TEST_H 16 ///< Canvas height in pixels
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// A font with no bitmaps, only glyphs whose advances tell them apart,
+// at every codepoint a bad decoder could produce from the cases below
+static uint8_t probeBitmaps[] = {0};
+static GFXglyph probeGlyphs[18];
+static GFXrange probeRanges[] = {
+    {0x00, 1, 0},     {0x2F, 1, 1},     {0x41, 2, 2},      {0xE9, 1, 4},
+    {0x7FF, 2, 5},    {0x20AC, 1, 7},   {0xD7FF, 2, 8},    {0xDFFF, 2, 10},
+    {0xFFFF, 2, 12},  {0x40000, 1, 14}, {0x10FFFF, 2, 15}, {0x1FFFFF, 1, 17}};
+static const GFXfontSparse probe = {
+    {probeBitmaps, probeGlyphs, GFX_FONT_SPARSE, 0x1FFFFF, 10},
+    probeRanges,
+    sizeof(probeRanges) / sizeof(probeRanges[0])};
+
+// Bytes between an 'A' and a 'B', and the codepoints they must make
+struct Case {
+  const char *bytes;
+  uint32_t codes[2];
+};
+
+static const Case cases[] = {
+    // Shortest form of each length, and the ends of each range
+    {"\xC3\xA9", {0xE9}},
+    {"\xDF\xBF", {0x7FF}},
+    {"\xE0\xA0\x80", {0x800}},
+    {"\xE2\x82\xAC", {0x20AC}},
+    {"\xED\x9F\xBF", {0xD7FF}},
+    {"\xEE\x80\x80", {0xE000}},
+    {"\xEF\xBF\xBF", {0xFFFF}},
+    {"\xF0\x90\x80\x80", {0x10000}},
+    {"\xF4\x8F\xBF\xBF", {0x10FFFF}},
+    // Overlong forms
+    {"\xC0\x80", {}},
+    {"\xC0\xAF", {}},
+    {"\xC1\xBF", {}},
+    {"\xE0\x80\xAF", {}},
+    {"\xE0\x9F\xBF", {}},
+    {"\xF0\x80\x80\xAF", {}},
+    {"\xF0\x8F\xBF\xBF", {}},
+    // Surrogates
+    {"\xED\xA0\x80", {}},
+    {"\xED\xBF\xBF", {}},
+    // Past U+10FFFF, and bytes no codepoint starts with
+    {"\xF4\x90\x80\x80", {}},
+    {"\xF7\xBF\xBF\xBF", {}},
+    {"\xF8\x88\x80\x80\x80", {}},
+    {"\xF9\x80\x80\x80", {}},
+    {"\xFF", {}},
+    // Truncated, by an ASCII byte or a new lead byte, and stray bytes
+    {"\xC3", {}},
+    {"\xE2\x82", {}},
+    {"\xF0\x90\x80", {}},
+    {"\xE2\x82\xC3\xA9", {0xE9}},
+    {"\xF0\x90\xE0\xA0\x80", {0x800}},
+    {"\x80", {}},
+    {"\xC3\xA9\xA9\xBF", {0xE9}},
+    {"\xE9\xC3\xA9", {0xE9}}};
+
+// Where writeCodepoint() leaves the cursor after 'A', the codes and 'B'
+static int16_t expectX(const Case &c) {
+  GFXcanvas1 canvas(TEST_W, TEST_H);
+  canvas.setFont(&probe.font);
+  canvas.writeCodepoint('A');
+  for (uint8_t i = 0; (i < 2) && c.codes[i]; i++)
+    canvas.writeCodepoint(c.codes[i]);
+  canvas.writeCodepoint('B');
+  return canvas.getCursorX();
+}
+
+static void testDecode(void) {
+  GFXcanvas1 canvas(TEST_W, TEST_H);
+  char what[80];
+  for (uint8_t i = 0; i < 18; i++)
+    probeGlyphs[i].xAdvance = i + 1;
+  canvas.setFont(&probe.font);
+  canvas.setTextWrap(false);
+
+  for (uint8_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    canvas.setCursor(0, 8);
+    canvas.print('A');
+    canvas.print(cases[i].bytes);
+    canvas.print('B');
+    snprintf(what, sizeof(what), "case %d: cursor at %d, not %d", i,
+             canvas.getCursorX(), expectX(cases[i]));
+    check(canvas.getCursorX() == expectX(cases[i]), what);
+  }
+
+  // A sequence split across print() calls, and one that utf8() cuts off
+  Case euro = {"", {0x20AC}}, none = {"", {}};
+  canvas.setCursor(0, 8);
+  canvas.print("A\xE2\x82");
+  canvas.print("\xAC"
+               "B");
+  check(canvas.getCursorX() == expectX(euro), "split sequence not joined");
+  canvas.setCursor(0, 8);
+  canvas.print("A\xE2\x82");
+  canvas.utf8(true);
+  canvas.print("\xAC"
+               "B");
+  check(canvas.getCursorX() == expectX(none), "utf8() kept a half sequence");
+
+  // A font past 0xFF is read as UTF-8 even with utf8() off
+  canvas.utf8(false);
+  canvas.setCursor(0, 8);
+  canvas.print("A\xC3\xA9"
+               "B");
+  Case e = {"", {0xE9}};
+  check(canvas.getCursorX() == expectX(e), "font past 0xFF read as bytes");
+}
+
+static bool same(const GFXcanvas1 &a, const GFXcanvas1 &b) {
+  return !memcmp(a.getBuffer(), b.getBuffer(), (TEST_W + 7) / 8 * TEST_H);
+}
+
+static bool blank(const GFXcanvas1 &canvas) {
+  for (uint16_t i = 0; i < (TEST_W + 7) / 8 * TEST_H; i++)
+    if (canvas.getBuffer()[i])
+      return false;
+  return true;
+}
+
+static void testClassic(void) {
+  GFXcanvas1 a(TEST_W, TEST_H), b(TEST_W, TEST_H);
+
+  // Bytes: one glyph each
+  a.print("\xC3\xA9");
+  b.drawChar(0, 0, 0xC3, 1, 1, 1);
+  b.drawChar(6, 0, 0xA9, 1, 1, 1);
+  check(same(a, b) && (a.getCursorX() == 12), "bytes are not one glyph each");
+
+  // UTF-8: one glyph per codepoint, none past 0xFF
+  a.fillScreen(0);
+  b.fillScreen(0);
+  a.utf8(true);
+  a.setCursor(0, 0);
+  a.print("\xC3\xA9");
+  b.drawChar(0, 0, 0xE9, 1, 1, 1);
+  check(same(a, b) && (a.getCursorX() == 6), "U+00E9 is not one glyph");
+  a.fillScreen(0);
+  a.setCursor(0, 0);
+  a.print("\xE2\x82\xAC\xC0\xAF");
+  check(blank(a) && (a.getCursorX() == 0), "U+20AC or overlong '/' drawn");
+
+  // cp437(false) skips glyph 176 from byte 176 up, in bytes and in UTF-8
+  for (uint8_t utf8 = 0; utf8 < 2; utf8++) {
+    a.fillScreen(0);
+    b.fillScreen(0);
+    a.utf8(utf8);
+    b.utf8(utf8);
+    a.cp437(false);
+    b.cp437(true);
+    a.setCursor(0, 0);
+    b.setCursor(0, 0);
+    a.print(utf8 ? "\xC2\xB0" : "\xB0");
+    b.print(utf8 ? "\xC2\xB1" : "\xB1");
+    check(same(a, b), utf8 ? "UTF-8 cp437(false) is not glyph + 1"
+                           : "byte cp437(false) is not glyph + 1");
+    b.fillScreen(0);
+    b.setCursor(0, 0);
+    b.print(utf8 ? "\xC2\xB0" : "\xB0");
+    check(!same(a, b), utf8 ? "UTF-8 cp437() changed nothing"
+                            : "byte cp437() changed nothing");
+  }
+}
+
+int main(void) {
+  testDecode();
+  testClassic();
+  if (!failures)
+    printf("OK\n");
+  return failures ? 1 : 0;
+}